@@ -5,27 +5,51 @@
  */
 
 #include <float.h>
+#include <stdio.h>
+#include <chrono>
+#include <fstream>
+#include <iterator>
 #include <map>
 #include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include "common.h"
 #include "bac.h"
 #include "bacoptions.h"
+#include "concurrentseparation.h"
+#include "cutpool.h"
 #include "cutproducer.h"
+#include "distributedsearch.h"
 #include "formulation.h"
 #include "lpsolver.h"
+#include "lptrace.h"
 #include "nibacexception.h"
 #include "node.h"
+#include "nodepath.h"
+#include "nodeselector.h"
 #include "nodestack.h"
+#include "parallelsearch.h"
 #include "solutionmanager.h"
 #include "statistics.h"
+#include "variableset.h"
 
 namespace vorpal::nibac {
     BAC::BAC(Formulation &pformulation, BACOptions &poptions)
             : formulation(pformulation),
-              options(poptions) {
+              options(poptions),
+              nodeStack(0),
+              solveLPFlag(false),
+              parallelSearch(0),
+              workerIndex(0),
+              distributedSearch(0),
+              lpRecord(0),
+              cutPool(0),
+              concurrentSeparation(0) {
         // Finish setting up.
         bestSolutionValue = (formulation.getProblemType() == Formulation::MAXIMIZATION ? INT_MIN : INT_MAX);
+        objectiveCutoffValue = bestSolutionValue;
     }
 
 
@@ -35,13 +59,7 @@ namespace vorpal::nibac {
 
         // Create the default node. Note that this node is handled by the nodeStack and
         // we do not need to deallocate it.
-        Node *node = new Node(*this,
-                              formulation,
-                              0,
-                              formulation.getNumberVariables(),
-                              formulation.getNumberBranchingVariables(),
-                              &(options.getInitial0Fixings()),
-                              &(options.getInitial1Fixings()));
+        Node *node = createRootNode();
 
         // We must have a branching scheme defined in order to create a NodeStack.
         if (options.getBranchingScheme() == 0)
@@ -52,8 +70,22 @@ namespace vorpal::nibac {
     }
 
 
+    Node *BAC::createRootNode(void) {
+        return new Node(*this,
+                        formulation,
+                        0,
+                        formulation.getNumberVariables(),
+                        formulation.getNumberBranchingVariables(),
+                        &(options.getInitial0Fixings()),
+                        &(options.getInitial1Fixings()));
+    }
+
+
     BAC::~BAC() {
         delete nodeStack;
+        delete lpRecord;
+        delete cutPool;
+        delete concurrentSeparation;
     }
 
 
@@ -82,44 +114,111 @@ namespace vorpal::nibac {
         std::cerr << "* Beginning branch-and-cut *" << std::endl;
 #endif
 
-        // Preliminary declarations.
-        Node *node;
-        bool validSubtreeFlag;
-        bool finishedEarlyFlag;
-
-        int baseSolutionValue;
-        int numberNonInteger;
-        double minimumViolation;
-        double violationTolerance;
-        bool terminateCuttingPlaneFlag;
-        bool solveLPFlag;
-        bool isInteger;
-        int globalNumberCuts;
-        int localNumberCuts;
-        double globalMaximumViolation;
-        double localMaximumViolation;
-
-        // References into statistics to improve processing time.
         Statistics &statistics = options.getStatistics();
-        const int &lowerBound = options.getLowerBound();
-        const int &upperBound = options.getUpperBound();
-        const std::vector<CutProducer *> &cutProducers = options.getCutProducers();
         if (options.getSolutionManager() == 0)
             throw NoSolutionManagerException();
-        SolutionManager &solutionManager = *(options.getSolutionManager());
+
+        // Checkpoints and work units record a single stack, and maximal generation relies on
+        // flags in the stack that cannot be recreated from a checkpoint (see below).
+        const std::vector<const char *> &resumeFileNames = options.getResumeFileNames();
+        if ((options.getCheckpointFileName() || options.getWorkUnitFileName() || !resumeFileNames.empty())
+            && (options.getNumberThreads() > 1 || formulation.getSolutionType() == Formulation::MAXIMALGENERATION))
+            throw IllegalParameterException("BACOptions::CheckpointFileName",
+                                            options.getCheckpointFileName() ? options.getCheckpointFileName()
+                                            : options.getWorkUnitFileName() ? options.getWorkUnitFileName()
+                                                                            : resumeFileNames.front(),
+                                            "checkpoints require a single thread and a solution type other than "
+                                            "maximal generation");
+
+        // A distributed search shares subtrees between processes, and has no checkpoints of
+        // its own.
+        const char *coordinatorAddress = options.getListenAddress() ? options.getListenAddress()
+                                                                    : options.getCoordinatorAddress();
+        if (coordinatorAddress
+            && (options.getNumberThreads() > 1 || formulation.getSolutionType() == Formulation::MAXIMALGENERATION
+                || options.getCheckpointFileName() || options.getWorkUnitFileName() || !resumeFileNames.empty()))
+            throw IllegalParameterException("BACOptions::CoordinatorAddress", coordinatorAddress,
+                                            "distributed searches require a single thread, a solution type other "
+                                            "than maximal generation, and no checkpoints");
+
+        // LP traces follow the order in which a single search solves its LPs.
+        const char *lpTraceFileName = options.getLPRecordFileName() ? options.getLPRecordFileName()
+                                                                    : options.getLPReplayFileName();
+        if (lpTraceFileName && (options.getNumberThreads() > 1 || coordinatorAddress))
+            throw IllegalParameterException(options.getLPRecordFileName() ? "BACOptions::LPRecordFileName"
+                                                                          : "BACOptions::LPReplayFileName",
+                                            lpTraceFileName,
+                                            "LP traces require a single thread and no distributed search");
+
+        // Progress is estimated from the statistics of a single search, which the workers
+        // of parallel and distributed searches only have parts of.
+        if (options.getProgressInterval() > 0 && (options.getNumberThreads() > 1 || coordinatorAddress))
+            throw IllegalParameterException("BACOptions::ProgressInterval", options.getProgressInterval(),
+                                            "progress reports require a single thread and no distributed search");
 
         // Start the timer.
         statistics.getTotalTimer().start();
 
-        // Begin with necessary initialization.
+        // The formulation is complete, so the cut producers may prepare for the search.
+        const std::vector<CutProducer *> &cutProducers = options.getCutProducers();
+        for (std::vector<CutProducer *>::const_iterator iter = cutProducers.begin();
+             iter != cutProducers.end();
+             ++iter)
+            (*iter)->initialize(formulation);
+
+        // If we are part of a distributed search, it takes over. Otherwise, if we have been
+        // asked to use more than one thread, we let a parallel search distribute the tree
+        // amongst workers. Maximal generation relies on flags passed between nodes anywhere
+        // in the stack (see NodeStack), which cannot be shared between workers, so it is
+        // always done by a single thread.
+        if (options.getListenAddress()) {
+            DistributedSearch search(*this, options.getListenAddress());
+            search.coordinate();
+        } else if (options.getCoordinatorAddress()) {
+            DistributedSearch search(*this, options.getCoordinatorAddress());
+            search.work();
+        } else if (options.getNumberThreads() > 1 && formulation.getSolutionType() != Formulation::MAXIMALGENERATION) {
+            ParallelSearch search(*this, options.getNumberThreads());
+            search.run();
+        } else {
+            // Begin with necessary initialization.
 #ifdef DEBUG
-        std::cerr << "+ Beginning initialization (variable fixings, etc...)" << std::endl;
+            std::cerr << "+ Beginning initialization (variable fixings, etc...)" << std::endl;
 #endif
-        initialize();
+            initialize();
 #ifdef DEBUG
-        std::cerr << "- Initialization complete." << std::endl;
+            std::cerr << "- Initialization complete." << std::endl;
 #endif
 
+            // If we are resuming a search, we continue with the subtrees it had left instead
+            // of the root.
+            if (!resumeFileNames.empty()) {
+                for (std::vector<const char *>::const_iterator iter = resumeFileNames.begin();
+                     iter != resumeFileNames.end();
+                     ++iter)
+                    readCheckpoint(*iter);
+                nodeStack->pruneTop();
+            }
+
+            nextCheckpoint = std::chrono::steady_clock::now() + std::chrono::seconds(options.getCheckpointInterval());
+            if (options.getLPRecordFileName())
+                lpRecord = new LPTrace(options.getLPRecordFileName(), formulation, true);
+            explore();
+            if (options.getCheckpointFileName())
+                writeCheckpoint(0, true);
+            delete lpRecord;
+            lpRecord = 0;
+        }
+
+        statistics.getTotalTimer().stop();
+    }
+
+
+    bool BAC::explore() {
+        Statistics &statistics = options.getStatistics();
+        const int &lowerBound = options.getLowerBound();
+        const int &upperBound = options.getUpperBound();
+
         // Determine if we are solving LPs or just testing feasibility.
         // We always want to solve an LP if we are performing a full search or a generation.
         // If we are performing a maximal generation or generation of every solution and a bound
@@ -129,467 +228,928 @@ namespace vorpal::nibac {
                       || (formulation.getProblemType() == Formulation::MAXIMIZATION && lowerBound > INT_MIN)
                       || (formulation.getProblemType() == Formulation::MINIMIZATION && upperBound < INT_MAX);
 
+        // Create the cut pool if we have been asked to, and if there are cut producers to fill
+        // it. It is kept for as long as we are, as the cuts in it remain valid for the formulation.
+        if (solveLPFlag && !cutPool && options.getCutPoolSize() > 0 && !options.getCutProducers().empty())
+            cutPool = new CutPool((size_t) options.getCutPoolSize() << 20);
+
+        // There is only a point in running the cut producers concurrently if there are several.
+        if (solveLPFlag && !concurrentSeparation && options.concurrentSeparation() && options.getCutProducers().size() > 1)
+            concurrentSeparation = new ConcurrentSeparation(*this, options.getCutProducers());
+
+        // If asked to, and if there are LP bounds to go by, we let a node selector decide
+        // when to set aside the subtrees on the stack and explore a more promising one.
+        // Workers of a parallel or distributed search always explore depth-first.
+        NodeSelector *nodeSelector = 0;
+        if (solveLPFlag && !parallelSearch && !distributedSearch && options.getNodeSelection() != NodeSelector::DEPTHFIRST)
+            nodeSelector = new NodeSelector(formulation, options.getNodeSelection(), options.getDiveLength());
+        NodePath path;
+
+        // The subtrees left from a checkpoint are ordered by the node selector, if there is one.
+        if (nodeSelector)
+            while (!pendingPaths.empty()) {
+                nodeSelector->add(pendingPaths.back());
+                pendingPaths.pop_back();
+            }
+        bool checkpointFlag = (options.getCheckpointFileName() != 0 && !parallelSearch);
+        bool splitFlag = (options.getWorkUnitFileName() != 0 && !parallelSearch);
+        bool progressFlag = (options.getProgressInterval() > 0);
+        std::chrono::steady_clock::time_point nextProgress = std::chrono::steady_clock::now()
+                                                             + std::chrono::seconds(options.getProgressInterval());
+
+        Node *node;
+        bool validSubtreeFlag;
+        for (;;) {
+            if (!(node = nodeStack->getNextNode())) {
+                // Resume the most promising subtree set aside, or the next subtree left from
+                // a checkpoint, if there is one that might still contain a solution of interest.
+                // Only paths below the root have a bound.
+                if (nodeSelector && nodeSelector->select(path)) {
+                    if (path.getDepth() > 0 && !canImprove(path.getBound()))
+                        continue;
+                    statistics.reportSubtreeResumed();
+                } else if (!pendingPaths.empty()) {
+                    path = std::move(pendingPaths.back());
+                    pendingPaths.pop_back();
+                    if (solveLPFlag && path.getDepth() > 0 && !canImprove(path.getBound()))
+                        continue;
+                } else
+                    break;
+
+                // If the path cannot be replayed, the stack is left empty and we move on.
+                replay(path);
+                continue;
+            }
+
+            // If we are splitting the search, a node at the split depth is written out as a
+            // work unit instead of being explored. Its ancestors have been processed, so the
+            // unit holds their fixings and cuts.
+            if (splitFlag && node->getDepth() >= options.getSplitDepth()) {
+                std::ostringstream fileName;
+                fileName << options.getWorkUnitFileName() << '.' << statistics.getNumberWorkUnits();
+                std::vector<NodePath> paths(1);
+                nodeStack->getTopPath(paths.front());
+                writeCheckpointFile(fileName.str().c_str(), paths, false);
+                statistics.reportWorkUnit();
+                nodeStack->pruneTop();
+                continue;
+            }
+
+            if (!processNode(node, validSubtreeFlag)) {
+                delete nodeSelector;
+                return false;
+            }
+
+            // If the node selector finds a subtree more promising than the one that the stack
+            // would explore next, we set aside the subtrees on the stack and continue with it.
+            if (nodeSelector) {
+                if (validSubtreeFlag)
+                    nodeSelector->evaluate(*node);
+                if (nodeSelector->shouldLeave(*nodeStack)) {
+                    path.clear();
+                    while (nodeStack->donate(path)) {
+                        nodeSelector->add(path);
+                        statistics.reportSubtreeSetAside();
+                        path.clear();
+                    }
+                }
+            }
+
+            // Write a checkpoint if one is due. Between nodes, the stack and the node selector
+            // hold all of the subtrees left to explore.
+            if (checkpointFlag && std::chrono::steady_clock::now() >= nextCheckpoint)
+                writeCheckpoint(nodeSelector);
+
+            // Likewise, report our progress if it is due.
+            if (progressFlag && std::chrono::steady_clock::now() >= nextProgress) {
+                statistics.printProgress(std::cerr);
+                nextProgress = std::chrono::steady_clock::now() + std::chrono::seconds(options.getProgressInterval());
+            }
+
+            // If we are a worker in a parallel search, give away part of our tree if
+            // another worker has asked for it, and stop if the search is over.
+            if (parallelSearch && !parallelSearch->poll(*this))
+                return false;
+
+            // Likewise if we are a worker in a distributed search.
+            if (distributedSearch && !distributedSearch->poll())
+                return false;
+        }
+
+        delete nodeSelector;
+        return true;
+    }
+
+
+    bool BAC::canImprove(double bound) {
+        // This follows the bound checks made when processing a node.
+        int baseSolutionValue = (formulation.getProblemType() == Formulation::MAXIMIZATION
+                                 ? floor(bound)
+                                 : ceil(bound));
+        if (formulation.getProblemType() == Formulation::MAXIMIZATION) {
+            if (baseSolutionValue < options.getLowerBound())
+                return false;
+        } else if (baseSolutionValue > options.getUpperBound())
+            return false;
+
+        if (formulation.getSolutionType() == Formulation::MAXIMALGENERATION
+            || formulation.getSolutionType() == Formulation::ALLGENERATION)
+            return true;
+        if (formulation.getProblemType() == Formulation::MAXIMIZATION && baseSolutionValue < getBestSolutionValue())
+            return false;
+        if (formulation.getProblemType() == Formulation::MINIMIZATION && baseSolutionValue > getBestSolutionValue())
+            return false;
+        if (formulation.getSolutionType() == Formulation::SEARCH && baseSolutionValue == getBestSolutionValue())
+            return false;
+        return true;
+    }
+
+
+    void BAC::updateObjectiveCutoff(void) {
+        // The best solution value only bounds the solutions of interest if we are not
+        // generating maximal or all solutions.
+        if (formulation.getSolutionType() == Formulation::MAXIMALGENERATION
+            || formulation.getSolutionType() == Formulation::ALLGENERATION)
+            return;
+
+        int bestValue = getBestSolutionValue();
+        if (bestValue == objectiveCutoffValue)
+            return;
+        objectiveCutoffValue = bestValue;
+
+        // In a search, we need a strictly better solution; otherwise, one that is as good will do.
+        // Either way, the cutoff is only of use if it is tighter than the bounds from the options.
+        if (formulation.getProblemType() == Formulation::MAXIMIZATION) {
+            int cutoff = (formulation.getSolutionType() == Formulation::SEARCH ? bestValue + 1 : bestValue);
+            if (cutoff > options.getLowerBound())
+                formulation.setObjectiveCutoff(cutoff);
+        } else {
+            int cutoff = (formulation.getSolutionType() == Formulation::SEARCH ? bestValue - 1 : bestValue);
+            if (cutoff < options.getUpperBound())
+                formulation.setObjectiveCutoff(cutoff);
+        }
+    }
+
+
+    bool BAC::processNode(Node *node, bool &validSubtreeFlag) {
+        // Preliminary declarations.
+        bool finishedEarlyFlag;
+
+        int baseSolutionValue;
+        int numberNonInteger;
+        double minimumViolation;
+        double violationTolerance;
+        bool terminateCuttingPlaneFlag;
+        bool producersFlag;
+        std::vector<int> producerNumberCuts;
+        std::vector<double> producerMaximumViolation;
+        bool isInteger;
+        int globalNumberCuts;
+        int localNumberCuts;
+        double globalMaximumViolation;
+        double localMaximumViolation;
+
+        // References into statistics to improve processing time.
+        Statistics &statistics = options.getStatistics();
+        const int &lowerBound = options.getLowerBound();
+        const int &upperBound = options.getUpperBound();
+        const std::vector<CutProducer *> &cutProducers = options.getCutProducers();
+
         // The finishedEarlyFlag flag is used to terminate the processing early (i.e. before
         // the nodeStack is empty). This is done, for example, when generating and
         // reaching an integer solution that demonstrates itself to be optimal
         // (vis-a-vis bounds).
         finishedEarlyFlag = false;
 
-        while ((node = nodeStack->getNextNode())) {
 #ifdef DEBUG
-            std::cerr << "& Got a new node from the stack "
-             << "(branched on variable " << node->getBranchVariableIndex()
-             << " with value " << node->getBranchVariableValue()
-             << "), depth=" << node->getDepth() << std::endl;
+        std::cerr << "& Got a new node from the stack "
+         << "(branched on variable " << node->getBranchVariableIndex()
+         << " with value " << node->getBranchVariableValue()
+         << "), depth=" << node->getDepth() << std::endl;
 #endif
 
-            // *** INDICATE ANOTHER NODE HAS BEEN VISITED ***
-            // This also records depth information.
-            statistics.reportNode(*node);
+        // *** INDICATE ANOTHER NODE HAS BEEN VISITED ***
+        // This also records depth information.
+        statistics.reportNode(*node);
 
-            // We initially believe that the subtree rooted at this node is valid until we have
-            // reason not to.
-            validSubtreeFlag = true;
+        // We initially believe that the subtree rooted at this node is valid until we have
+        // reason not to.
+        validSubtreeFlag = true;
 
-            // *** PREPROCESS ***
+        // *** PREPROCESS ***
 #ifdef DEBUG
-            std::cerr << "+ Beginning preprocessing..." << std::endl;
+        std::cerr << "+ Beginning preprocessing..." << std::endl;
 #endif
-            if (!(validSubtreeFlag = preprocess(*node))) {
+        if (!(validSubtreeFlag = preprocess(*node))) {
 #ifdef DEBUG
-                std::cerr << "* Preprocessing failed." << std::endl;
+            std::cerr << "* Preprocessing failed." << std::endl;
 #endif
-                goto CLEANUP;
-            }
+            goto CLEANUP;
+        }
 #ifdef DEBUG
-            std::cerr << "- Preprocessing done." << std::endl;
+        std::cerr << "- Preprocessing done." << std::endl;
 #endif
 
-            // *** CONTINUOUSLY SOLVE THE LP RELAXATION OR EQUIVALENT ***
-            terminateCuttingPlaneFlag = false;
-            for (;;) {
-                // *** SOLVE LP / TEST FEASIBILITY ***
-                // If the problem requires, solve an LP.
-                if (solveLPFlag) {
-                    // Solve the node using the technique of the implemented LP solver
+        // *** CONTINUOUSLY SOLVE THE LP RELAXATION OR EQUIVALENT ***
+        terminateCuttingPlaneFlag = false;
+        for (;;) {
+            // *** SOLVE LP / TEST FEASIBILITY ***
+            // If the problem requires, solve an LP.
+            if (solveLPFlag) {
+                // Solve the node using the technique of the implemented LP solver
 #ifdef DEBUG
-                    std::cerr << "+ Executing solver..." << std::endl;
+                std::cerr << "+ Executing solver..." << std::endl;
 #endif
 
-                    // We use the specific solver instance built into the LP solver class.
-                    // If the node depth is greater than the depth to which NIBAC is supposed
-                    // to solve, we ask the LPSolver to solve the node to completion.
-                    statistics.getLPSolverTimer().start();
-                    int numberNodesSolved = LPSolver::getInstance()->solveNode(*this, *node,
-                                                                               node->getDepth() >= options.getDepth());
-                    statistics.getLPSolverTimer().stop();
-
-                    // Report to the node and statistics that we solved an LP.
-                    node->reportLPSolved();
-                    statistics.reportLPSolved();
-
-                    if (numberNodesSolved < 0) {
-                        validSubtreeFlag = false;
+                // We use the specific solver instance built into the LP solver class.
+                // If the node depth is greater than the depth to which NIBAC is supposed
+                // to solve, we ask the LPSolver to solve the node to completion.
+                updateObjectiveCutoff();
+                node->setReducedCostsFlag(false);
+                double lpSeconds = statistics.getLPSolverTimer().getSeconds();
+                statistics.getLPSolverTimer().start();
+                int numberNodesSolved = formulation.getLPSolver()->solveNode(*this, *node,
+                                                                             node->getDepth() >= options.getDepth());
+                statistics.getLPSolverTimer().stop();
+                statistics.getLPTimeByDepth()[node->getDepth()]
+                        += statistics.getLPSolverTimer().getSeconds() - lpSeconds;
+                if (lpRecord)
+                    lpRecord->write(*node, numberNodesSolved);
+
+                // Report to the node and statistics that we solved an LP.
+                node->reportLPSolved();
+                statistics.reportLPSolved();
+
+                if (numberNodesSolved < 0) {
+                    validSubtreeFlag = false;
 #ifdef DEBUG
-                        std::cerr << "- Solver failed. Cleaning up." << std::endl;
+                    std::cerr << "- Solver failed. Cleaning up." << std::endl;
 #endif
-                        goto CLEANUP;
-                    }
+                    goto CLEANUP;
+                }
 
-                    // Report any other subnodes that were processed by the solver.
-                    statistics.reportNodesWithoutDepth(numberNodesSolved);
+                // Report any other subnodes that were processed by the solver.
+                statistics.reportNodesWithoutDepth(numberNodesSolved);
 
 #ifdef DEBUG
-                    std::cerr << "- Solver completed." << std::endl;
-                    std::cerr << "\t= Solution value: " << node->getSolutionValue() << std::endl;
-                    std::cerr << "\t= Solution vector:";
-                    int numberVariables = formulation.getNumberVariables();
-                    double *fractionalSolution = node->getSolutionVariableArray();
-                    for (int i=0; i < numberVariables; ++i)
-                      std::cerr << " " << i << ":" << fractionalSolution[i];
-                    std::cerr << std::endl;
-                    std::cerr << "\t= Ones:";
-                    for (int i=0; i < numberVariables; ++i)
-                      if (isone(fractionalSolution[i]))
-                        std::cerr << " " << i;
-                    std::cerr << std::endl;
+                std::cerr << "- Solver completed." << std::endl;
+                std::cerr << "\t= Solution value: " << node->getSolutionValue() << std::endl;
+                std::cerr << "\t= Solution vector:";
+                int numberVariables = formulation.getNumberVariables();
+                double *fractionalSolution = node->getSolutionVariableArray();
+                for (int i=0; i < numberVariables; ++i)
+                  std::cerr << " " << i << ":" << fractionalSolution[i];
+                std::cerr << std::endl;
+                std::cerr << "\t= Ones:";
+                for (int i=0; i < numberVariables; ++i)
+                  if (isone(fractionalSolution[i]))
+                    std::cerr << " " << i;
+                std::cerr << std::endl;
 #endif
-                }
+            }
 
-                    // Otherwise, we test feasibility.
-                else {
+                // Otherwise, we test feasibility.
+            else {
 #ifdef DEBUG
-                    std::cerr << "+ Testing feasibility..." << std::endl;
+                std::cerr << "+ Testing feasibility..." << std::endl;
 #endif
 
-                    if (!formulation.checkPartialFeasibility(node->getPartialSolutionArray())) {
+                if (!formulation.checkPartialFeasibility(node->getPartialSolutionArray())) {
 #ifdef DEBUG
-                        std::cerr << "- Partial solution cannot be extended to a feasible complete solution. Cleaning up." << std::endl;
+                    std::cerr << "- Partial solution cannot be extended to a feasible complete solution. Cleaning up." << std::endl;
 #endif
 
-                        goto CLEANUP;
-                    }
+                    goto CLEANUP;
+                }
 
 #ifdef DEBUG
-                    std::cerr << "- Solution is feasible." << std::endl;
+                std::cerr << "- Solution is feasible." << std::endl;
 #endif
-                }
+            }
 
-                // *** CHECK BOUNDS ***
-                // We can only do this if an LP was solved.
-                if (solveLPFlag) {
+            // *** CHECK BOUNDS ***
+            // We can only do this if an LP was solved.
+            if (solveLPFlag) {
 #ifdef DEBUG
-                    std::cerr << "+ Checking bound requirements..." << std::endl;
+                std::cerr << "+ Checking bound requirements..." << std::endl;
 #endif
 
-                    // Find the base solution: if we are dealing with a maximization problem, the solution in the
-                    // subtree can be no greater than the floor, and the ceil if this is a minimization problem.
-                    baseSolutionValue = (formulation.getProblemType() == Formulation::MAXIMIZATION
-                                         ? floor(node->getSolutionValue())
-                                         : ceil(node->getSolutionValue()));
+                // Find the base solution: if we are dealing with a maximization problem, the solution in the
+                // subtree can be no greater than the floor, and the ceil if this is a minimization problem.
+                baseSolutionValue = (formulation.getProblemType() == Formulation::MAXIMIZATION
+                                     ? floor(node->getSolutionValue())
+                                     : ceil(node->getSolutionValue()));
 
-                    // *** DOES THE SOLUTION SATISFY THE BOUND REQUIREMENTS? ***
-                    if (formulation.getProblemType() == Formulation::MAXIMIZATION) {
-                        if (baseSolutionValue < lowerBound) {
-                            validSubtreeFlag = false;
-#ifdef DEBUG
-                            std::cerr << "* Maximization problem did not satisfy lower bound: "
-                                  << baseSolutionValue << " < bound=" << lowerBound << std::endl;
-#endif
-                            goto CLEANUP;
-                        }
-                    } else if (baseSolutionValue > upperBound) {
+                // *** DOES THE SOLUTION SATISFY THE BOUND REQUIREMENTS? ***
+                if (formulation.getProblemType() == Formulation::MAXIMIZATION) {
+                    if (baseSolutionValue < lowerBound) {
                         validSubtreeFlag = false;
 #ifdef DEBUG
-                        std::cerr << "* Minimization problem did not satisfy upper bound: "
-                              << baseSolutionValue << " > bound=" << upperBound << std::endl;
+                        std::cerr << "* Maximization problem did not satisfy lower bound: "
+                              << baseSolutionValue << " < bound=" << lowerBound << std::endl;
 #endif
                         goto CLEANUP;
                     }
+                } else if (baseSolutionValue > upperBound) {
+                    validSubtreeFlag = false;
+#ifdef DEBUG
+                    std::cerr << "* Minimization problem did not satisfy upper bound: "
+                          << baseSolutionValue << " > bound=" << upperBound << std::endl;
+#endif
+                    goto CLEANUP;
+                }
 
-                    // *** CHECK ACCEPTABILITY OF SOLUTION ***
-                    // We only do this if we are not working with maximal solutions or all solutions.
-                    if (formulation.getSolutionType() != Formulation::MAXIMALGENERATION &&
-                        formulation.getSolutionType() != Formulation::ALLGENERATION) {
-                        if (formulation.getProblemType() == Formulation::MAXIMIZATION &&
-                            baseSolutionValue < bestSolutionValue) {
-                            validSubtreeFlag = false;
+                // *** CHECK ACCEPTABILITY OF SOLUTION ***
+                // We only do this if we are not working with maximal solutions or all solutions.
+                if (formulation.getSolutionType() != Formulation::MAXIMALGENERATION &&
+                    formulation.getSolutionType() != Formulation::ALLGENERATION) {
+                    if (formulation.getProblemType() == Formulation::MAXIMIZATION &&
+                        baseSolutionValue < getBestSolutionValue()) {
+                        validSubtreeFlag = false;
 #ifdef DEBUG
-                            std::cerr << "* Maximization problem solution does not meet currently optimal solution: "
-                                  << baseSolutionValue << " < optimal=" << bestSolutionValue << std::endl;
+                        std::cerr << "* Maximization problem solution does not meet currently optimal solution: "
+                              << baseSolutionValue << " < optimal=" << getBestSolutionValue() << std::endl;
 #endif
-                            goto CLEANUP;
-                        }
-                        if (formulation.getProblemType() == Formulation::MINIMIZATION &&
-                            baseSolutionValue > bestSolutionValue) {
-                            validSubtreeFlag = false;
+                        goto CLEANUP;
+                    }
+                    if (formulation.getProblemType() == Formulation::MINIMIZATION &&
+                        baseSolutionValue > getBestSolutionValue()) {
+                        validSubtreeFlag = false;
 #ifdef DEBUG
-                            std::cerr << "* Minimization problem solution does not meet currently optimal solution: "
-                                  << baseSolutionValue << " > optimal=" << bestSolutionValue << std::endl;
+                        std::cerr << "* Minimization problem solution does not meet currently optimal solution: "
+                              << baseSolutionValue << " > optimal=" << getBestSolutionValue() << std::endl;
 #endif
-                            goto CLEANUP;
-                        }
-                        if (formulation.getSolutionType() == Formulation::SEARCH &&
-                            baseSolutionValue == bestSolutionValue) {
-                            validSubtreeFlag = false;
+                        goto CLEANUP;
+                    }
+                    if (formulation.getSolutionType() == Formulation::SEARCH &&
+                        baseSolutionValue == getBestSolutionValue()) {
+                        validSubtreeFlag = false;
 #ifdef DEBUG
-                            std::cerr << "* Search problem solution is no better than currently optimal solution: "
-                                  << baseSolutionValue << " == optimal=" << bestSolutionValue << std::endl;
+                        std::cerr << "* Search problem solution is no better than currently optimal solution: "
+                              << baseSolutionValue << " == optimal=" << getBestSolutionValue() << std::endl;
 #endif
-                            goto CLEANUP;
-                        }
+                        goto CLEANUP;
                     }
+                }
 #ifdef DEBUG
-                    std::cerr << "- Bounds requirements satisfied." << std::endl;
+                std::cerr << "- Bounds requirements satisfied." << std::endl;
+#endif
+
+                // *** REDUCED COST FIXING ***
+                // The LP solution is still optimal after these fixings, so there is no need to solve again.
+                if (options.reducedCostFixing() && node->hasReducedCosts()) {
+#ifdef DEBUG
+                    int numberFixed = fixByReducedCost(*node);
+                    std::cerr << "- Fixed " << numberFixed << " variables by reduced cost." << std::endl;
+#else
+                    fixByReducedCost(*node);
 #endif
                 }
+            }
 
 
-                // *** PROCESS SOLUTIONS ***
-                isInteger = false;
+            // *** PROCESS SOLUTIONS ***
+            isInteger = false;
 
-                // If we solved an LP, we need to determine if this is the best solution we've found so far.
-                if (solveLPFlag) {
+            // If we solved an LP, we need to determine if this is the best solution we've found so far.
+            if (solveLPFlag) {
 #ifdef DEBUG
-                    std::cerr << "+ Checking whether solution is integer..." << std::endl;
+                std::cerr << "+ Checking whether solution is integer..." << std::endl;
 #endif
-                    if (isInteger = isIntegerSolution(*node, numberNonInteger)) {
+                if (isInteger = isIntegerSolution(*node, numberNonInteger)) {
 #ifdef DEBUG
-                        std::cerr << "- Solution is integer.\n";
+                    std::cerr << "- Solution is integer.\n";
 #endif
-                        // We have already pruned solutions that are not as good as this one,
-                        // so this one is clearly the best (or tied for the best) so far. We
-                        // indicate this by setting the bestSolutionValue variable.
+                    // We have already pruned solutions that are not as good as this one,
+                    // so this one is clearly the best (or tied for the best) so far. We
+                    // indicate this by reporting its value as the best solution value.
 #ifdef DEBUG
-                        std::cerr << "\t= Setting the new optimal solution: old=" << bestSolutionValue
-                              << ", new=" << node->getSolutionValue() << std::endl;
+                    std::cerr << "\t= Setting the new optimal solution: old=" << getBestSolutionValue()
+                          << ", new=" << node->getSolutionValue() << std::endl;
 #endif
-                        bestSolutionValue = round(node->getSolutionValue());
-                    }
+                    reportSolutionValue(round(node->getSolutionValue()));
                 }
+            }
 
-                // If we are performing a search, we must do this differently, since we don't need to be at a leaf node
-                // in order to terminate.
-                if (formulation.getSolutionType() == Formulation::SEARCH) {
-                    // If this solution is integer (as tested above), then we report to the solution manager.
-                    if (isInteger) {
-#ifdef DEBUG
-                        std::cerr << "\t= Reporting the solution to the solution manager." << std::endl;
-#endif
-                        // Send the solution to the solution manager.
-                        solutionManager.newSolution(*node);
-
-                        // We definitely don't want to process any further into the subtree; we
-                        // are generating, and this is integer, so we cannot find a better
-                        // solution in the subtree rooted here.
-                        validSubtreeFlag = false;
-
-                        // In the best case, if we have specified a bound for the optimal
-                        // solution, if we have met this bound, then there is no reason to
-                        // continue looking at the tree at all. We can terminate the
-                        // branch-and-cut algorithm immediately.
-                        if (formulation.getProblemType() == Formulation::MAXIMIZATION) {
-                            if (equals(node->getSolutionValue(), upperBound)) {
+            // If we are performing a search, we must do this differently, since we don't need to be at a leaf node
+            // in order to terminate.
+            if (formulation.getSolutionType() == Formulation::SEARCH) {
+                // If this solution is integer (as tested above), then we report to the solution manager.
+                if (isInteger) {
 #ifdef DEBUG
-                                std::cerr << "* Maximization search problem has reached upper bound: "
-                                  << node->getSolutionValue() << " == bound=" << upperBound << std::endl;
+                    std::cerr << "\t= Reporting the solution to the solution manager." << std::endl;
 #endif
-                                finishedEarlyFlag = true;
-                                goto CLEANUP;
-                            }
-                        } else if (equals(node->getSolutionValue(), lowerBound)) {
+                    // Send the solution to the solution manager.
+                    reportSolution(*node);
+
+                    // We definitely don't want to process any further into the subtree; we
+                    // are generating, and this is integer, so we cannot find a better
+                    // solution in the subtree rooted here.
+                    validSubtreeFlag = false;
+
+                    // In the best case, if we have specified a bound for the optimal
+                    // solution, if we have met this bound, then there is no reason to
+                    // continue looking at the tree at all. We can terminate the
+                    // branch-and-cut algorithm immediately.
+                    if (formulation.getProblemType() == Formulation::MAXIMIZATION) {
+                        if (equals(node->getSolutionValue(), upperBound)) {
 #ifdef DEBUG
-                            std::cerr << "* Minimization search problem has reached lower bound: "
-                              << node->getSolutionValue() << " == bound=" << lowerBound << std::endl;
+                            std::cerr << "* Maximization search problem has reached upper bound: "
+                              << node->getSolutionValue() << " == bound=" << upperBound << std::endl;
 #endif
                             finishedEarlyFlag = true;
                             goto CLEANUP;
                         }
-
-                        // We have not met the bound, or no bound was specified, so we simply
-                        // prune this node.
+                    } else if (equals(node->getSolutionValue(), lowerBound)) {
 #ifdef DEBUG
-                        std::cerr << "* Search problem reached integer solution, so stop processing this branch." << std::endl;
+                        std::cerr << "* Minimization search problem has reached lower bound: "
+                          << node->getSolutionValue() << " == bound=" << lowerBound << std::endl;
 #endif
+                        finishedEarlyFlag = true;
                         goto CLEANUP;
                     }
+
+                    // We have not met the bound, or no bound was specified, so we simply
+                    // prune this node.
+#ifdef DEBUG
+                    std::cerr << "* Search problem reached integer solution, so stop processing this branch." << std::endl;
+#endif
+                    goto CLEANUP;
                 }
+            }
 
-                    // In this case, we are not searching, so we require leaf nodes. All three techniques share a considerable
-                    // amount in common, so we lump them together here and specialize.
-                else {
-                    // If no LP was solved, set the current solution to the partial solution.
-                    if (!solveLPFlag)
-                        node->setSolutionToPartial();
+                // In this case, we are not searching, so we require leaf nodes. All three techniques share a considerable
+                // amount in common, so we lump them together here and specialize.
+            else {
+                // If no LP was solved, set the current solution to the partial solution.
+                if (!solveLPFlag)
+                    node->setSolutionToPartial();
 
 #ifdef DEBUG
-                    std::cerr << "+ Determining if the node has been solved (i.e. no free variables)." << std::endl;
+                std::cerr << "+ Determining if the node has been solved (i.e. no free variables)." << std::endl;
 #endif
-                    if (isSolved(*node)) {
+                if (isSolved(*node)) {
 #ifdef DEBUG
-                        std::cerr << "- The node has been solved." << std::endl;
+                    std::cerr << "- The node has been solved." << std::endl;
 #endif
 
-                        // We can't go further into the tree, as this is a leaformulation.
-                        validSubtreeFlag = false;
+                    // We can't go further into the tree, as this is a leaformulation.
+                    validSubtreeFlag = false;
 
-                        // Perform any additional necessary checks here. Currently, the only required one is maximality.
-                        if (formulation.getSolutionType() == Formulation::MAXIMALGENERATION) {
+                    // Perform any additional necessary checks here. Currently, the only required one is maximality.
+                    if (formulation.getSolutionType() == Formulation::MAXIMALGENERATION) {
 #ifdef DEBUG
-                            std::cerr << "+ Checking to see if the solution is maximal." << std::endl;
+                        std::cerr << "+ Checking to see if the solution is maximal." << std::endl;
 #endif
-                            if (!isMaximal(*node)) {
+                        if (!isMaximal(*node)) {
 #ifdef DEBUG
-                                std::cerr << "- Solution is not maximal. Pruning." << std::endl;
-#endif
-                                goto CLEANUP;
-                            }
-#ifdef DEBUG
-                            std::cerr << "- Solution is maximal." << std::endl;
+                            std::cerr << "- Solution is not maximal. Pruning." << std::endl;
 #endif
+                            goto CLEANUP;
                         }
-
 #ifdef DEBUG
-                        std::cerr << "+ Checking to see if the solution meets the required criteria." << std::endl;
+                        std::cerr << "- Solution is maximal." << std::endl;
 #endif
+                    }
 
-                        if (checkSolutionForGeneration(*node)) {
 #ifdef DEBUG
-                            std::cerr << "- Solution meets our criteria." << std::endl;
-                            std::cerr << "\t= Reporting the solution to the solution manager." << std::endl;
+                    std::cerr << "+ Checking to see if the solution meets the required criteria." << std::endl;
 #endif
-                            solutionManager.newSolution(*node);
-                        } else {
-                            // If we reached this point, the solution is not suitable.
+
+                    if (checkSolutionForGeneration(*node)) {
 #ifdef DEBUG
-                            std::cerr << "- Solution does not meet our criteria." << std::endl;
+                        std::cerr << "- Solution meets our criteria." << std::endl;
+                        std::cerr << "\t= Reporting the solution to the solution manager." << std::endl;
 #endif
-                        }
+                        reportSolution(*node);
+                    } else {
+                        // If we reached this point, the solution is not suitable.
 #ifdef DEBUG
-                        std::cerr << "* Nothing left to process on this branch." << std::endl;
+                        std::cerr << "- Solution does not meet our criteria." << std::endl;
 #endif
-                        goto CLEANUP;
                     }
 #ifdef DEBUG
-                    else
-                      std::cerr << "- The node has not been solved." << std::endl;
+                    std::cerr << "* Nothing left to process on this branch." << std::endl;
 #endif
+                    goto CLEANUP;
                 }
+#ifdef DEBUG
+                else
+                  std::cerr << "- The node has not been solved." << std::endl;
+#endif
+            }
 
-                // If no LP was solved, we obviously can't perform the cutting plane algorithm.
-                if (!solveLPFlag) {
+            // If no LP was solved, we obviously can't perform the cutting plane algorithm.
+            if (!solveLPFlag) {
 #ifdef DEBUG
-                    std::cerr << "= LP not solved. Cannot perform cutting plane." << std::endl;
+                std::cerr << "= LP not solved. Cannot perform cutting plane." << std::endl;
 #endif
-                    break;
-                }
+                break;
+            }
 
-                // If, at this point, the node is still active but was deemed integer, there is no improvement
-                // that can be done via the cutting plane.
-                if (isInteger) {
+            // If, at this point, the node is still active but was deemed integer, there is no improvement
+            // that can be done via the cutting plane.
+            if (isInteger) {
 #ifdef DEBUG
-                    std::cerr << "\t= Not reported to solution manager. Cannot improve through cutting plane." << std::endl;
+                std::cerr << "\t= Not reported to solution manager. Cannot improve through cutting plane." << std::endl;
 #endif
-                    break;
-                }
+                break;
+            }
 
-                // *** DETERMINE IF WE SHOULD CONTINUE ***
-                // This is used to stop the cutting plane algorithm. If this is true,
-                // the cutting plane algorithm didn't give us sufficient cuts to motivate
-                // running it for another iteration.
-                if (terminateCuttingPlaneFlag) {
+            // *** DETERMINE IF WE SHOULD CONTINUE ***
+            // This is used to stop the cutting plane algorithm. If this is true,
+            // the cutting plane algorithm didn't give us sufficient cuts to motivate
+            // running it for another iteration.
+            if (terminateCuttingPlaneFlag) {
 #ifdef DEBUG
-                    std::cerr << "\t= Terminating the cutting plane algorithm." << std::endl;
+                std::cerr << "\t= Terminating the cutting plane algorithm." << std::endl;
 #endif
-                    break;
-                }
+                break;
+            }
 
-                // *** PROCESS ***
+            // *** PROCESS ***
 #ifdef DEBUG
-                std::cerr << "+ Beginning processing..." << std::endl;
+            std::cerr << "+ Beginning processing..." << std::endl;
 #endif
-                validSubtreeFlag = (process(*node) == TRUE);
-                if (!validSubtreeFlag) {
+            validSubtreeFlag = (process(*node) == TRUE);
+            if (!validSubtreeFlag) {
 #ifdef DEBUG
-                    std::cerr << "* Processing failed." << std::endl;
+                std::cerr << "* Processing failed." << std::endl;
 #endif
-                    goto CLEANUP;
-                }
+                goto CLEANUP;
+            }
 #ifdef DEBUG
-                std::cerr << "- Processing done." << std::endl;
+            std::cerr << "- Processing done." << std::endl;
 #endif
 
-                // *** GENERATE CUTS ***
-                // If there are no cutProducers, we are done at this point.
-                if (cutProducers.size() == 0) {
+            // *** GENERATE CUTS ***
+            // If there are no cutProducers, we are done at this point.
+            if (cutProducers.size() == 0) {
 #ifdef DEBUG
-                    std::cerr << "= Not performing cutting plane as there are no cut producers." << std::endl;
+                std::cerr << "= Not performing cutting plane as there are no cut producers." << std::endl;
 #endif
-                    break;
-                }
+                break;
+            }
 
 #ifdef DEBUG
-                std::cerr << "+ Generating cuts..." << std::endl;
+            std::cerr << "+ Generating cuts..." << std::endl;
 #endif
-                statistics.getSeparationTimer().start();
+            statistics.getSeparationTimer().start();
 
-                // Begin by determining the violation tolerance and the minimum worthwhile
-                // violation using the supplied bounds and the number of fractional variables.
-                determineViolationBounds(numberNonInteger, minimumViolation, violationTolerance);
+            // Begin by determining the violation tolerance and the minimum worthwhile
+            // violation using the supplied bounds and the number of fractional variables.
+            determineViolationBounds(numberNonInteger, minimumViolation, violationTolerance);
 #ifdef DEBUG
-                std::cerr << "\t= Minimum violation required for this iteration: " << minimumViolation << std::endl;
-                std::cerr << "\t= Violation tolerance for this iteration: " << violationTolerance << std::endl;
+            std::cerr << "\t= Minimum violation required for this iteration: " << minimumViolation << std::endl;
+            std::cerr << "\t= Violation tolerance for this iteration: " << violationTolerance << std::endl;
 #endif
 
-                globalNumberCuts = 0;
-                globalMaximumViolation = 0;
+            globalNumberCuts = 0;
+            globalMaximumViolation = 0;
 
-                std::vector<unsigned long>::iterator numCutsIter = statistics.getNumberCuts().begin();
-                for (std::vector<CutProducer *>::const_iterator cutsIter = cutProducers.begin();
-                     cutsIter != cutProducers.end();
-                     ++cutsIter, ++numCutsIter) {
+            // The cuts in the cut pool come first. If they are enough to continue with the cutting
+            // plane, the cut producers wait for the next iteration.
+            producersFlag = true;
+            if (cutPool) {
+                cutPool->addViolatedCuts(*this, *node, violationTolerance, globalNumberCuts, globalMaximumViolation);
+                statistics.reportCutPoolCuts(globalNumberCuts);
 #ifdef DEBUG
-                    std::cerr << "\t+ Beginning cut producer." << std::endl;
+                std::cerr << "\t= Cut pool gave " << globalNumberCuts << " cuts with maximum violation "
+                 << globalMaximumViolation << std::endl;
 #endif
-                    (*cutsIter)->generateCuts(*this, *node, violationTolerance, localNumberCuts, localMaximumViolation);
+                producersFlag = (globalNumberCuts < options.getMinimumNumberOfCuts()
+                                 || lessthan(globalMaximumViolation, minimumViolation));
+            }
+
+            // If the cut producers are run concurrently, we tally what they found as we would
+            // have, had they been run one after another.
+            if (producersFlag && concurrentSeparation) {
+                concurrentSeparation->generateCuts(*node, violationTolerance, producerNumberCuts,
+                                                   producerMaximumViolation);
+                std::vector<unsigned long>::iterator numCutsIter = statistics.getNumberCuts().begin();
+                for (int i = 0; i < (int) cutProducers.size(); ++i, ++numCutsIter) {
 #ifdef DEBUG
-                    std::cerr << "\t- Cut producer generated " << localNumberCuts << " cuts with maximum violation " << localMaximumViolation << std::endl;
+                    std::cerr << "\t- Cut producer generated " << producerNumberCuts[i]
+                     << " cuts with maximum violation " << producerMaximumViolation[i] << std::endl;
 #endif
-                    (*numCutsIter) += localNumberCuts;
-                    globalNumberCuts += localNumberCuts;
-                    if (greaterthan(localMaximumViolation, globalMaximumViolation))
-                        globalMaximumViolation = localMaximumViolation;
+                    (*numCutsIter) += producerNumberCuts[i];
+                    globalNumberCuts += producerNumberCuts[i];
+                    if (greaterthan(producerMaximumViolation[i], globalMaximumViolation))
+                        globalMaximumViolation = producerMaximumViolation[i];
                 }
-                if (lessthan(globalMaximumViolation, minimumViolation))
-                    terminateCuttingPlaneFlag = true;
-                if (globalNumberCuts < options.getMinimumNumberOfCuts())
-                    terminateCuttingPlaneFlag = true;
+                producersFlag = false;
+            }
 
-                statistics.getSeparationTimer().stop();
+            std::vector<unsigned long>::iterator numCutsIter = statistics.getNumberCuts().begin();
+            for (std::vector<CutProducer *>::const_iterator cutsIter = cutProducers.begin();
+                 producersFlag && cutsIter != cutProducers.end();
+                 ++cutsIter, ++numCutsIter) {
 #ifdef DEBUG
-                std::cerr << "- Finished generating cuts (" << globalNumberCuts << " generated, maximum violation was "
-                 << globalMaximumViolation << ")." << std::endl;
+                std::cerr << "\t+ Beginning cut producer." << std::endl;
 #endif
-
-                // If no cuts were generated, there is no point in solving the LP again.
-                if (globalNumberCuts == 0)
-                    break;
+                (*cutsIter)->generateCuts(*this, *node, violationTolerance, localNumberCuts, localMaximumViolation);
+#ifdef DEBUG
+                std::cerr << "\t- Cut producer generated " << localNumberCuts << " cuts with maximum violation " << localMaximumViolation << std::endl;
+#endif
+                (*numCutsIter) += localNumberCuts;
+                globalNumberCuts += localNumberCuts;
+                if (greaterthan(localMaximumViolation, globalMaximumViolation))
+                    globalMaximumViolation = localMaximumViolation;
             }
+            if (lessthan(globalMaximumViolation, minimumViolation))
+                terminateCuttingPlaneFlag = true;
+            if (globalNumberCuts < options.getMinimumNumberOfCuts())
+                terminateCuttingPlaneFlag = true;
 
-            // *** POSTPROCESS ***
+            statistics.getSeparationTimer().stop();
 #ifdef DEBUG
-            std::cerr << "+ Beginning postprocessing..." << std::endl;
+            std::cerr << "- Finished generating cuts (" << globalNumberCuts << " generated, maximum violation was "
+             << globalMaximumViolation << ")." << std::endl;
 #endif
-            validSubtreeFlag = (postprocess(*node) == TRUE);
-            if (!validSubtreeFlag) {
+
+            // If no cuts were generated, there is no point in solving the LP again.
+            if (globalNumberCuts == 0)
+                break;
+        }
+
+        // *** POSTPROCESS ***
 #ifdef DEBUG
-                std::cerr << "* Postprocessing failed." << std::endl;
+        std::cerr << "+ Beginning postprocessing..." << std::endl;
 #endif
-                goto CLEANUP;
-            }
+        validSubtreeFlag = (postprocess(*node) == TRUE);
+        if (!validSubtreeFlag) {
 #ifdef DEBUG
-            std::cerr << "- Postprocessing done." << std::endl;
+            std::cerr << "* Postprocessing failed." << std::endl;
+#endif
+            goto CLEANUP;
+        }
+#ifdef DEBUG
+        std::cerr << "- Postprocessing done." << std::endl;
 #endif
 
-            CLEANUP:
-            // Perform any cleanup here; currently, this is taken care of automatically by the
-            // nodeStack and is not required.
-            // However, if validSubtreeFlag is false, we do not want to continue to explore this
-            // subtree, so we will prune it from the nodeStack.
-            if (!validSubtreeFlag) {
-                // We must report the branch depth, as a fathomed node might be deeper than
-                // a solution node.
-                statistics.reportBranchDepth(node->getDepth());
-                nodeStack->pruneTop();
-
-                // If finishedEarlyFlag is set, then we are done, so we simply return.
-                if (finishedEarlyFlag)
-                    return;
-            } else
-                // *** REMOVE UNVIOLATED CUTS ***
-                // This is done only if we are not pruning this node from the search space.
-                // There is no point to keeping unviolated cuts around; they simply waste
-                // space. We check to see if the cuts aren't violated and if not, we simply
-                // remove them from the node. They may be violated in other subtrees, and
-                // by calling Node::removeConstraint, they will be added when we backtrack
-                // to the parent node.
-            if (cutProducers.size() > 0) {
+        CLEANUP:
+        // Perform any cleanup here; currently, this is taken care of automatically by the
+        // nodeStack and is not required.
+        // However, if validSubtreeFlag is false, we do not want to continue to explore this
+        // subtree, so we will prune it from the nodeStack.
+        if (!validSubtreeFlag) {
+            // We must report the branch depth, as a fathomed node might be deeper than
+            // a solution node.
+            statistics.reportBranchDepth(node->getDepth());
+            statistics.reportLeaf(*node);
+            nodeStack->pruneTop();
+
+            // If finishedEarlyFlag is set, then we are done, so we simply return.
+            if (finishedEarlyFlag)
+                return false;
+        } else
+            // *** REMOVE UNVIOLATED CUTS ***
+            // This is done only if we are not pruning this node from the search space.
+            // There is no point to keeping unviolated cuts around; they simply waste
+            // space. We check to see if the cuts aren't violated and if not, we simply
+            // remove them from the node. They may be violated in other subtrees, and
+            // by calling Node::removeConstraint, they will be added when we backtrack
+            // to the parent node.
+        if (cutProducers.size() > 0) {
 #ifdef DEBUG
-                std::cerr << "+ Removing inactive cuts." << std::endl;
+            std::cerr << "+ Removing inactive cuts." << std::endl;
 #endif
-                removeInactiveCuts(*node);
+            removeInactiveCuts(*node);
 #ifdef DEBUG
-                std::cerr << "- Done removing inactive cuts." << std::endl;
+            std::cerr << "- Done removing inactive cuts." << std::endl;
 #endif
-            }
+        }
 
 #ifdef DEBUG
-            std::cerr << "% Finished processing node." << std::endl;
-            std::cerr << "-------------------------------------------------------------" << std::endl;
+        std::cerr << "% Finished processing node." << std::endl;
+        std::cerr << "-------------------------------------------------------------" << std::endl;
 #endif
+        return true;
+    }
+
+
+    bool BAC::replay(const NodePath &path) {
+        // The nodes left on the stack undo their fixings when they are pruned, so they must
+        // go before the new root makes its own.
+        if (nodeStack) {
+            nodeStack->clear();
+            nodeStack->reset(createRootNode());
+        } else
+            nodeStack = new NodeStack(*(options.getBranchingScheme()), createRootNode(), options.getStatistics());
+
+        // Recreate the nodes along the path. They were all preprocessed when they were
+        // first explored, so we do so again. If preprocessing now prunes one of them, the
+        // subtree at the end of the path is dropped.
+        int depth = path.getDepth();
+        bool validFlag = preprocess(*(nodeStack->getTop()));
+        for (int i = 0; validFlag && i < depth - 1; ++i)
+            validFlag = preprocess(*(nodeStack->descend(path.getBranchVariable(i), path.getBranchValue(i))));
+        if (!validFlag) {
+            nodeStack->clear();
+            return false;
         }
 
-        statistics.getTotalTimer().stop();
+        // The node at the end of the path is left unprocessed, so that it is explored as
+        // any other.
+        if (depth > 0)
+            nodeStack->open(path.getBranchVariable(depth - 1), path.getBranchValue(depth - 1));
+
+        // Restore the cuts, which belong to the deepest node we have so that they are
+        // removed when we are done with the path.
+        Node *node = nodeStack->getTop();
+        const std::vector<NodePath::Cut> &cuts = path.getCuts();
+        std::vector<Constraint *> constraints;
+        constraints.reserve(cuts.size());
+        for (std::vector<NodePath::Cut>::const_iterator iter = cuts.begin();
+             iter != cuts.end();
+             ++iter) {
+            std::vector<int> positions = (*iter).positions;
+            std::vector<int> coefficients = (*iter).coefficients;
+            constraints.push_back(Constraint::createConstraint(formulation, positions, coefficients,
+                                                               (*iter).lowerBound, (*iter).upperBound));
+        }
+        if (!constraints.empty())
+            node->addCuts(constraints);
+        return true;
+    }
+
+
+    void BAC::writeCheckpoint(NodeSelector *nodeSelector, bool finishedFlag) {
+        // The subtrees left, in the order in which they would be explored.
+        std::vector<NodePath> paths;
+        if (!finishedFlag) {
+            nodeStack->getOpenPaths(paths);
+            for (std::vector<NodePath>::reverse_iterator iter = pendingPaths.rbegin();
+                 iter != pendingPaths.rend();
+                 ++iter)
+                paths.push_back(*iter);
+            if (nodeSelector)
+                nodeSelector->getPaths(paths);
+        }
+
+        writeCheckpointFile(options.getCheckpointFileName(), paths, true);
+        nextCheckpoint = std::chrono::steady_clock::now() + std::chrono::seconds(options.getCheckpointInterval());
+    }
+
+
+    void BAC::writeCheckpointFile(const char *fileName, const std::vector<NodePath> &paths, bool stateFlag) {
+        // We write to a temporary file and then replace the checkpoint, so that there is always
+        // a complete checkpoint, even if we are interrupted while writing.
+        std::string temporaryFileName = std::string(fileName) + ".tmp";
+        std::ofstream out(temporaryFileName.c_str());
+        if (!out)
+            throw FileOutputException(temporaryFileName.c_str());
+        out.precision(17);
+
+        out << "NIBAC-CHECKPOINT 7" << std::endl;
+        out << formulation.getNumberVariables() << ' ' << formulation.getNumberBranchingVariables() << ' '
+            << formulation.getSolutionType() << std::endl;
+        out << bestSolutionValue << std::endl;
+        out << stateFlag << std::endl;
+        if (stateFlag) {
+            options.getStatistics().write(out);
+            options.getSolutionManager()->writeCheckpoint(out);
+        }
+        out << paths.size() << std::endl;
+        for (std::vector<NodePath>::const_iterator iter = paths.begin();
+             iter != paths.end();
+             ++iter)
+            (*iter).write(out);
+
+        out.close();
+        if (out.fail())
+            throw FileOutputException(temporaryFileName.c_str());
+        if (rename(temporaryFileName.c_str(), fileName) != 0)
+            throw FileOutputException(fileName);
+    }
+
+
+    void BAC::readCheckpoint(const char *fileName) {
+        std::ifstream in(fileName);
+        if (!in)
+            throw FileInputException(fileName);
+
+        std::string header;
+        int version;
+        in >> header >> version;
+        if (!in || header != "NIBAC-CHECKPOINT" || version != 7)
+            throw FileInputException(fileName);
+
+        int numberVariables, numberBranchingVariables, solutionType;
+        in >> numberVariables >> numberBranchingVariables >> solutionType;
+        if (!in)
+            throw FileInputException(fileName);
+        if (numberVariables != formulation.getNumberVariables()
+            || numberBranchingVariables != formulation.getNumberBranchingVariables()
+            || solutionType != formulation.getSolutionType())
+            throw IllegalParameterException("BACOptions::ResumeFileName", fileName,
+                                            "checkpoint was written for a different problem");
+
+        int checkpointBestSolutionValue;
+        bool stateFlag;
+        if (!(in >> checkpointBestSolutionValue >> stateFlag))
+            throw FileInputException(fileName);
+        if (formulation.getProblemType() == Formulation::MAXIMIZATION ? checkpointBestSolutionValue > bestSolutionValue
+                                                                      : checkpointBestSolutionValue < bestSolutionValue)
+            bestSolutionValue = checkpointBestSolutionValue;
+
+        if (stateFlag) {
+            Statistics &statistics = options.getStatistics();
+            Statistics checkpointStatistics;
+            checkpointStatistics.setNumberCutProducers(statistics.getNumberCuts().size());
+            if (!checkpointStatistics.read(in))
+                throw FileInputException(fileName);
+            statistics.merge(checkpointStatistics);
+            options.getSolutionManager()->readCheckpoint(in);
+        }
+
+        // The first subtree is explored first, so we keep them in reverse order, before
+        // those we already have.
+        int numberPaths;
+        if (!(in >> numberPaths) || numberPaths < 0)
+            throw FileInputException(fileName);
+        std::vector<NodePath> paths(numberPaths);
+        for (int i = numberPaths - 1; i >= 0; --i)
+            if (!paths[i].read(in))
+                throw FileInputException(fileName);
+        pendingPaths.insert(pendingPaths.begin(), std::make_move_iterator(paths.begin()),
+                            std::make_move_iterator(paths.end()));
+    }
+
+
+    int BAC::getBestSolutionValue() {
+        return parallelSearch ? parallelSearch->getBestSolutionValue() : bestSolutionValue;
+    }
+
+
+    void BAC::reportSolutionValue(int value) {
+        if (parallelSearch)
+            parallelSearch->reportSolutionValue(value);
+        else {
+            if (value != bestSolutionValue) {
+                options.getStatistics().reportBestSolution();
+                if (distributedSearch)
+                    distributedSearch->reportSolutionValue(value);
+            }
+            bestSolutionValue = value;
+        }
+    }
+
+
+    void BAC::reportSolution(Node &node) {
+        if (parallelSearch)
+            parallelSearch->reportSolution(node);
+        else
+            options.getSolutionManager()->newSolution(node);
+    }
+
+
+    BACOptions *BAC::createWorkerOptions() {
+        return new BACOptions(options);
+    }
+
+
+    BAC *BAC::createWorker(Formulation &pformulation, BACOptions &poptions) {
+        return new BAC(pformulation, poptions);
+    }
+
+
+    int BAC::addCuts(Node &node, std::vector<Constraint *> &cuts, bool globalFlag) {
+        if (ConcurrentSeparation::keepCuts(cuts, globalFlag))
+            return cuts.size();
+
+        // A cut is dropped if it is a duplicate of a cut in the formulation, or of one kept
+        // before it, which is indexed by signature in turn.
+        std::unordered_multimap<unsigned long, Constraint *> kept;
+        std::vector<Constraint *> added;
+        added.reserve(cuts.size());
+        for (std::vector<Constraint *>::iterator iter = cuts.begin();
+             iter != cuts.end();
+             ++iter) {
+            Constraint *cut = *iter;
+            bool duplicateFlag = formulation.hasDuplicateCut(*cut);
+            std::pair<std::unordered_multimap<unsigned long, Constraint *>::iterator,
+                    std::unordered_multimap<unsigned long, Constraint *>::iterator> range
+                    = kept.equal_range(cut->getSignature());
+            for (std::unordered_multimap<unsigned long, Constraint *>::iterator piter = range.first;
+                 piter != range.second && !duplicateFlag;
+                 ++piter)
+                duplicateFlag = cut->isDuplicateOf(*((*piter).second));
+            if (duplicateFlag) {
+                delete cut;
+                continue;
+            }
+
+            kept.insert(std::make_pair(cut->getSignature(), cut));
+            added.push_back(cut);
+            if (cutPool && globalFlag)
+                cutPool->insert(cut);
+        }
+        options.getStatistics().reportDuplicateCuts(cuts.size() - added.size());
+
+        if (!added.empty())
+            node.addCuts(added);
+        return added.size();
     }
 
 
@@ -622,12 +1182,9 @@ namespace vorpal::nibac {
         std::cerr << "\t= Removing " << removedCuts.size() << " cuts." << std::endl;
 #endif
 
-        // Now remove all the constraints that we need to.
-        while (!removedCuts.empty()) {
-            cut = removedCuts.back();
-            removedCuts.pop_back();
-            node.removeCut(cut);
-        }
+        // Now remove all the constraints that we need to, at once.
+        if (!removedCuts.empty())
+            node.removeCuts(removedCuts);
     }
 
 
@@ -645,8 +1202,8 @@ namespace vorpal::nibac {
         numberNonInteger = 0;
 
         // We only need to check the free variables.
-        std::set<int> &freeVariables = node.getFreeVariables();
-        for (std::set<int>::iterator iter = freeVariables.begin();
+        VariableSet &freeVariables = node.getFreeVariables();
+        for (VariableSet::iterator iter = freeVariables.begin();
              iter != freeVariables.end();
              ++iter)
             if (!isint(solutionVariableArray[*iter]))
@@ -785,6 +1342,58 @@ namespace vorpal::nibac {
     }
 
 
+    void BAC::findReducedCostFixings(Node &node, std::vector<int> &zeros, std::vector<int> &ones) {
+        int numberBranchingVariables = node.getNumberBranchingVariables();
+        short int *partialSolution = node.getPartialSolutionArray();
+        double *solution = node.getSolutionVariableArray();
+        double *reducedCosts = node.getReducedCostArray();
+        double value = node.getSolutionValue();
+        bool maximizationFlag = (formulation.getProblemType() == Formulation::MAXIMIZATION);
+
+        for (int i = 0; i < numberBranchingVariables; ++i) {
+            if (partialSolution[i] != -1)
+                continue;
+
+            // Moving the variable to its other bound moves the LP bound by at least its reduced cost.
+            bool zeroFlag = iszero(solution[i]);
+            if (!zeroFlag && !isone(solution[i]))
+                continue;
+            double bound = (maximizationFlag ? value - fabs(reducedCosts[i]) : value + fabs(reducedCosts[i]));
+            if (canImprove(bound))
+                continue;
+
+            if (zeroFlag)
+                zeros.push_back(i);
+            else
+                ones.push_back(i);
+        }
+    }
+
+
+    int BAC::fixByReducedCost(Node &node) {
+        std::vector<int> zeros;
+        std::vector<int> ones;
+        findReducedCostFixings(node, zeros, ones);
+
+        int numberFixed = 0;
+        for (std::vector<int>::iterator iter = zeros.begin(); iter != zeros.end(); ++iter)
+            if (fixVariableTo0(node, *iter, true))
+                ++numberFixed;
+        for (std::vector<int>::iterator iter = ones.begin(); iter != ones.end(); ++iter)
+            if (fixVariableTo1(node, *iter, true))
+                ++numberFixed;
+
+        reportReducedCostFixings(node, numberFixed);
+        return numberFixed;
+    }
+
+
+    void BAC::reportReducedCostFixings(Node &node, int numberFixed) {
+        if (numberFixed > 0)
+            (options.getStatistics().getVariableFixingCountByDepth())[node.getDepth()] += numberFixed;
+    }
+
+
     bool BAC::fixVariableTo1(Node &node, int variable, bool _) {
         node.fixVariable(variable, 1);
         return true;
@@ -14,22 +14,37 @@
 #ifndef BAC_H
 #define BAC_H
 
+#include <chrono>
+#include <vector>
 #include "common.h"
 #include "formulation.h"
 #include "group.h"
 #include "node.h"
+#include "nodepath.h"
 #include "nodestack.h"
 #include "statistics.h"
 
 namespace vorpal::nibac {
     // Class forward declaration.
     class BACOptions;
+    class ConcurrentSeparation;
+    class CutPool;
+    class DistributedSearch;
+    class LPTrace;
+    class NodeSelector;
+    class ParallelSearch;
 
     class BAC {
         // Friend classes
         // Node is a friend so it can call protected members like fixVariableTo0/1.
         friend class Node;
 
+        // ParallelSearch is a friend so it can drive the exploration of its workers.
+        friend class ParallelSearch;
+
+        // DistributedSearch is a friend for the same reason.
+        friend class DistributedSearch;
+
     protected:
         // The problem itself.
         Formulation &formulation;
@@ -43,6 +58,37 @@ namespace vorpal::nibac {
         // The value of the best solution found so far.
         int bestSolutionValue;
 
+        // The best solution value on which the objective cutoff of the LP solver was last
+        // based (see updateObjectiveCutoff).
+        int objectiveCutoffValue;
+
+        // Whether we solve LPs at the nodes or simply test feasibility.
+        bool solveLPFlag;
+
+        // If this BAC is a worker in a parallel search, the search and our index in it.
+        // The best solution value is then kept by the search and shared by all workers.
+        ParallelSearch *parallelSearch;
+        int workerIndex;
+
+        // If this BAC is a worker in a distributed search, the search, through which the
+        // best solution value is shared with the other workers.
+        DistributedSearch *distributedSearch;
+
+        // The subtrees left to explore when the search was resumed from a checkpoint, the
+        // next one last, and the time at which the next checkpoint is due.
+        std::vector<NodePath> pendingPaths;
+        std::chrono::steady_clock::time_point nextCheckpoint;
+
+        // The trace to which we record the LPs solved, if we have been asked to.
+        LPTrace *lpRecord;
+
+        // The cuts valid for every node, if we have been asked to keep them.
+        CutPool *cutPool;
+
+        // The threads on which the cut producers are run, if we have been asked to run them
+        // concurrently.
+        ConcurrentSeparation *concurrentSeparation;
+
     public:
         BAC(Formulation &, BACOptions &);
 
@@ -52,6 +98,66 @@ namespace vorpal::nibac {
         // Initialization routine.
         virtual void initialize(void);
 
+        // Create the root node of the tree.
+        virtual Node *createRootNode(void);
+
+        // Process the nodes on the stack until it is empty. Returns false if we finished
+        // early, i.e. the search is over even though there are nodes left.
+        bool explore(void);
+
+        // Process a single node from the stack, returning false if we finished early.
+        // The flag is set to whether the subtree rooted at the node is still to be explored.
+        bool processNode(Node *, bool &);
+
+        // Determine whether a subtree whose LP bound is given might still contain a
+        // solution of interest.
+        bool canImprove(double);
+
+        // Pass the best solution value to the LP solver as an objective cutoff if it has
+        // changed, be it by us or by another worker, so that the LPs of nodes that cannot
+        // improve upon it are abandoned early.
+        void updateObjectiveCutoff(void);
+
+        // Set up the node stack to continue the search at the end of a path, as given
+        // away by the node stack of another search. The nodes along the path are recreated
+        // from the root and preprocessed again, since preprocessing may fix variables.
+        // Fixings made by other means (e.g. in process) are not recreated. If preprocessing
+        // prunes a node on the path, the stack is left empty and false is returned.
+        bool replay(const NodePath &);
+
+        // Write a checkpoint of the search to the checkpoint file: the subtrees left to
+        // explore on the stack, those left from a checkpoint we resumed from and those set
+        // aside by the node selector (if any), along with the best solution value, the
+        // statistics and the state of the solution manager. If the flag is set, the search is
+        // over and there are no subtrees left.
+        void writeCheckpoint(NodeSelector *, bool= false);
+
+        // Write a checkpoint file holding the given subtrees, in the order in which they are
+        // to be explored, and the best solution value. If the flag is set, the statistics and
+        // the state of the solution manager are included; work units omit them, as they
+        // belong to the search that split them off.
+        void writeCheckpointFile(const char *, const std::vector<NodePath> &, bool);
+
+        // Add the contents of a checkpoint file to the search: its subtrees are explored
+        // after those we already have, and its best solution value, statistics and solutions
+        // are combined with ours.
+        void readCheckpoint(const char *);
+
+        // Access to the best solution value, and reporting of new solutions, which
+        // go through the parallel search if there is one.
+        int getBestSolutionValue(void);
+
+        void reportSolutionValue(int);
+
+        void reportSolution(Node &);
+
+        // Create copies of the options, and a BAC over a copy of the formulation, to serve
+        // as a worker in a parallel search. Subclasses with state of their own should
+        // override these. The caller owns the results.
+        virtual BACOptions *createWorkerOptions(void);
+
+        virtual BAC *createWorker(Formulation &, BACOptions &);
+
         // These functions are called by the branch-and-cut routines, and while
         // they can be overridden in order to add functionality, they should
         // never be called externally to this object.
@@ -79,6 +185,19 @@ namespace vorpal::nibac {
         // This method sets a variable at a node to 0.
         virtual bool fixVariableTo0(Node &, int, bool= true);
 
+        // Find the free variables at a node that can be fixed by the reduced costs of the LP
+        // just solved there: those at a bound that could not be moved to their other bound
+        // without the LP bound showing that no solution of interest is left. The variables
+        // at 0 and at 1 are returned separately.
+        void findReducedCostFixings(Node &, std::vector<int> &, std::vector<int> &);
+
+        // Record the number of variables fixed by reduced cost at a node in the statistics.
+        void reportReducedCostFixings(Node &, int);
+
+        // Fix the variables found by findReducedCostFixings, returning the number fixed.
+        // This is only called if the LP solver provided reduced costs.
+        virtual int fixByReducedCost(Node &);
+
     public:
         // Begins solving the ILP
         // TODO: Should this be virtual? This seems like a bad idea.
@@ -89,6 +208,13 @@ namespace vorpal::nibac {
 
         // Get the options.
         inline BACOptions &getOptions() { return options; }
+
+        // Add the cuts found by a cut producer to a node, dropping and deleting those already in
+        // the formulation or given more than once. Cuts that are valid for every node, rather than
+        // only in the subtree rooted at the node, are also kept in the cut pool if there is one.
+        // Returns the number of cuts added. While the cut producers are run concurrently, the cuts
+        // are instead kept by the ConcurrentSeparation, which adds them once all are done.
+        int addCuts(Node &, std::vector<Constraint *> &, bool= false);
     };
 };
 
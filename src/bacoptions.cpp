@@ -12,37 +12,68 @@
 #include "bac.h"
 #include "branchingscheme.h"
 #include "cutproducer.h"
+#include "nodeselector.h"
 #include "solutionmanager.h"
 
 namespace vorpal::nibac {
     // Static declarations
     const int    BACOptions::BB_DEPTH_DEFAULT = INT_MAX;
+    const int    BACOptions::LP_ITERATION_LIMIT_DEFAULT = 0;
+    const int    BACOptions::LP_TIME_LIMIT_DEFAULT = 0;
     const int    BACOptions::CP_MIN_NUMBER_OF_CUTS_DEFAULT = 5;
     const double BACOptions::CP_MIN_VIOLATIONL_DEFAULT = 0.3;
     const double BACOptions::CP_MIN_VIOLATIONU_DEFAULT = 0.6;
     const double BACOptions::CP_VIOLATION_TOLERANCEL_DEFAULT = 0.3;
     const double BACOptions::CP_VIOLATION_TOLERANCEU_DEFAULT = 0.6;
     const double BACOptions::CP_ACTIVITY_TOLERANCE_DEFAULT = 0.1;
+    const int    BACOptions::CP_CUT_POOL_SIZE_DEFAULT = 0;
     const int    BACOptions::BB_LBOUND_DEFAULT = INT_MIN;
     const int    BACOptions::BB_UBOUND_DEFAULT = INT_MAX;
     const bool   BACOptions::keepcutsDefault = true;
+    const bool   BACOptions::concurrentseparationDefault = false;
+    const bool   BACOptions::reducedcostfixingDefault = false;
+    const bool   BACOptions::reducelpDefault = false;
+    const int    BACOptions::PAR_NUMBER_THREADS_DEFAULT = 1;
+    const NodeSelector::Strategy BACOptions::NS_STRATEGY_DEFAULT = NodeSelector::DEPTHFIRST;
+    const int    BACOptions::NS_DIVE_LENGTH_DEFAULT = 10;
+    const int    BACOptions::CK_INTERVAL_DEFAULT = 300;
+    const int    BACOptions::SPLIT_DEPTH_DEFAULT = 10;
+    const int    BACOptions::PROGRESS_INTERVAL_DEFAULT = 0;
 
 
     BACOptions::BACOptions()
             : BB_DEPTH(BB_DEPTH_DEFAULT),
+              LP_ITERATION_LIMIT(LP_ITERATION_LIMIT_DEFAULT),
+              LP_TIME_LIMIT(LP_TIME_LIMIT_DEFAULT),
               CP_MIN_NUMBER_OF_CUTS(CP_MIN_NUMBER_OF_CUTS_DEFAULT),
               CP_MIN_VIOLATIONL(CP_MIN_VIOLATIONL_DEFAULT),
               CP_MIN_VIOLATIONU(CP_MIN_VIOLATIONU_DEFAULT),
               CP_VIOLATION_TOLERANCEL(CP_VIOLATION_TOLERANCEL_DEFAULT),
               CP_VIOLATION_TOLERANCEU(CP_VIOLATION_TOLERANCEU_DEFAULT),
               CP_ACTIVITY_TOLERANCE(CP_ACTIVITY_TOLERANCE_DEFAULT),
+              CP_CUT_POOL_SIZE(CP_CUT_POOL_SIZE_DEFAULT),
               BB_LBOUND(BB_LBOUND_DEFAULT),
               BB_UBOUND(BB_UBOUND_DEFAULT),
               branchingScheme(nullptr),
               solutionManager(nullptr),
-              keepcuts(keepcutsDefault),
               manualFixingsFlag(false),
-              exportFileName(nullptr) {
+              keepcuts(keepcutsDefault),
+              concurrentseparation(concurrentseparationDefault),
+              reducedcostfixing(reducedcostfixingDefault),
+              reducelp(reducelpDefault),
+              PAR_NUMBER_THREADS(PAR_NUMBER_THREADS_DEFAULT),
+              NS_STRATEGY(NS_STRATEGY_DEFAULT),
+              NS_DIVE_LENGTH(NS_DIVE_LENGTH_DEFAULT),
+              exportFileName(nullptr),
+              checkpointFileName(nullptr),
+              CK_INTERVAL(CK_INTERVAL_DEFAULT),
+              workUnitFileName(nullptr),
+              SPLIT_DEPTH(SPLIT_DEPTH_DEFAULT),
+              PROGRESS_INTERVAL(PROGRESS_INTERVAL_DEFAULT),
+              listenAddress(nullptr),
+              coordinatorAddress(nullptr),
+              lpRecordFileName(nullptr),
+              lpReplayFileName(nullptr) {
     }
 
 
@@ -18,6 +18,7 @@
 #include "branchingscheme.h"
 #include "cutproducer.h"
 #include "nibacexception.h"
+#include "nodeselector.h"
 #include "solutionmanager.h"
 #include "statistics.h"
 #include "variableorder.h"
@@ -30,6 +31,15 @@ namespace vorpal::nibac {
         int BB_DEPTH;
         static const int BB_DEPTH_DEFAULT;
 
+        // Limits on the number of simplex iterations and the number of milliseconds spent
+        // on a single LP, or 0 for no limit, as in the default. An LP that reaches a limit
+        // gives no bound, and its node is branched upon. Only some LP solvers, e.g. GLPK,
+        // support these limits.
+        int LP_ITERATION_LIMIT;
+        static const int LP_ITERATION_LIMIT_DEFAULT;
+        int LP_TIME_LIMIT;
+        static const int LP_TIME_LIMIT_DEFAULT;
+
         // The minimum number of cuts we need to generate in a single iteration of
         // the cutting plane algorithm in order to continue.
         int CP_MIN_NUMBER_OF_CUTS;
@@ -54,6 +64,11 @@ namespace vorpal::nibac {
         double CP_ACTIVITY_TOLERANCE;
         static const double CP_ACTIVITY_TOLERANCE_DEFAULT;
 
+        // The number of megabytes of memory that the cuts valid for every node may take up in
+        // the cut pool (see CutPool), or 0 for no cut pool. The default is to have none.
+        int CP_CUT_POOL_SIZE;
+        static const int CP_CUT_POOL_SIZE_DEFAULT;
+
         // Upper and lower bounds on the optimal solution.
         int BB_LBOUND;
         static const int BB_LBOUND_DEFAULT;
@@ -95,10 +110,91 @@ namespace vorpal::nibac {
         bool keepcuts;
         static const bool keepcutsDefault;
 
+        // The cut producers each look at the same solution of the LP, and so can be run at the
+        // same time. This flag indicates whether they are run on threads of their own (see
+        // ConcurrentSeparation), in which case they must not share any state. The default is to
+        // run them one after another.
+        bool concurrentseparation;
+        static const bool concurrentseparationDefault;
+
+        // After an LP is solved at a node, a free variable at one of its bounds whose reduced
+        // cost shows that moving it to its other bound would leave no solution of interest can
+        // be fixed. This flag indicates whether we do so, if the LP solver provides reduced
+        // costs. As the fixings change the number of nodes explored, the default is not to.
+        bool reducedcostfixing;
+        static const bool reducedcostfixingDefault;
+
+        // The LP at a node deep in the tree has mostly fixed variables and rows that can no
+        // longer be violated. This flag indicates whether the LP solver should leave these
+        // out of the LPs that it solves, and bring them back when we backtrack, if it can.
+        // Only SimplexSolver can; the other LP solvers ignore this flag. The default is not to.
+        bool reducelp;
+        static const bool reducelpDefault;
+
+        // The number of threads used to explore the tree. If this is more than one, the
+        // tree is split up dynamically between the threads: a thread that runs out of
+        // nodes steals an open subtree from another (see ParallelSearch). Where the best
+        // solution value is used to prune, or the branching scheme is ranked, the number
+        // of nodes explored can then vary from run to run, although the solutions found
+        // do not.
+        int PAR_NUMBER_THREADS;
+        static const int PAR_NUMBER_THREADS_DEFAULT;
+
+        // The strategy used to select the next subtree to explore (see NodeSelector),
+        // and for the hybrid strategy, the number of nodes explored in each dive.
+        NodeSelector::Strategy NS_STRATEGY;
+        static const NodeSelector::Strategy NS_STRATEGY_DEFAULT;
+        int NS_DIVE_LENGTH;
+        static const int NS_DIVE_LENGTH_DEFAULT;
+
         // A filename to which we want to export the ILP. If null, as in the default,
         // we never export.
         const char *exportFileName;
 
+        // A filename to which we write checkpoints of the search, i.e. the subtrees left to
+        // explore, the best solution value, the solutions and the statistics, every
+        // CK_INTERVAL seconds and when the search ends. If null, as in the default, we never
+        // write checkpoints. A search can be resumed from a checkpoint by giving its filename
+        // as the resume filename. If several resume filenames are given, the search resumes
+        // from all of them at once: their subtrees, solutions and statistics are combined.
+        // Checkpoints are only supported by searches using a single thread that are not
+        // maximal generations.
+        const char *checkpointFileName;
+        int CK_INTERVAL;
+        static const int CK_INTERVAL_DEFAULT;
+        std::vector<const char *> resumeFileNames;
+
+        // A filename prefix for work units. If not null, the search does not explore the
+        // nodes at depth SPLIT_DEPTH, but writes each one to a file named prefix.i, numbered
+        // from 0, as a checkpoint with a single subtree. Each unit can then be solved
+        // independently by resuming from it, and the results (along with the checkpoint of
+        // the search that split them) combined by resuming from all of them at once.
+        const char *workUnitFileName;
+        int SPLIT_DEPTH;
+        static const int SPLIT_DEPTH_DEFAULT;
+
+        // The number of seconds between reports of the progress of the search, i.e. the
+        // number of nodes explored, the estimated size of the tree and the time left (see
+        // Statistics::printProgress). If 0, as in the default, we do not report progress.
+        // Progress can only be reported by a search using a single thread, and not by a
+        // distributed search.
+        int PROGRESS_INTERVAL;
+        static const int PROGRESS_INTERVAL_DEFAULT;
+
+        // The addresses for a distributed search (see DistributedSearch). If the listen
+        // address is not null, we coordinate the search, waiting for workers at it. If the
+        // coordinator address is not null, we are a worker, and connect to the coordinator
+        // at it. Addresses are of the form host:port, or the path of a Unix socket.
+        const char *listenAddress;
+        const char *coordinatorAddress;
+
+        // Filenames of LP traces (see LPTrace). If the record filename is not null, the result
+        // of every LP solved is recorded to it. ReplaySolver plays back the trace in the replay
+        // file instead of solving LPs. The LPs of a search are only solved in a well-defined
+        // order if it uses a single thread and is not distributed, so traces require this.
+        const char *lpRecordFileName;
+        const char *lpReplayFileName;
+
     public:
         BACOptions();
 
@@ -115,6 +211,29 @@ namespace vorpal::nibac {
 
         inline static int getDepthDefault(void) { return BB_DEPTH_DEFAULT; }
 
+        // The limits on a single LP, as outlined above.
+        inline int getLPIterationLimit(void) const { return LP_ITERATION_LIMIT; }
+
+        inline void setLPIterationLimit(int pLP_ITERATION_LIMIT) {
+            if (pLP_ITERATION_LIMIT < 0)
+                throw IllegalParameterException("BACOptions::LPIterationLimit", pLP_ITERATION_LIMIT,
+                                                "LPIterationLimit must be nonnegative");
+            LP_ITERATION_LIMIT = pLP_ITERATION_LIMIT;
+        }
+
+        inline static int getLPIterationLimitDefault(void) { return LP_ITERATION_LIMIT_DEFAULT; }
+
+        inline int getLPTimeLimit(void) const { return LP_TIME_LIMIT; }
+
+        inline void setLPTimeLimit(int pLP_TIME_LIMIT) {
+            if (pLP_TIME_LIMIT < 0)
+                throw IllegalParameterException("BACOptions::LPTimeLimit", pLP_TIME_LIMIT,
+                                                "LPTimeLimit must be nonnegative");
+            LP_TIME_LIMIT = pLP_TIME_LIMIT;
+        }
+
+        inline static int getLPTimeLimitDefault(void) { return LP_TIME_LIMIT_DEFAULT; }
+
         // The minimum number of cuts for the cutting plane, as outlined above.
         inline int getMinimumNumberOfCuts(void) const { return CP_MIN_NUMBER_OF_CUTS; }
 
@@ -187,6 +306,18 @@ namespace vorpal::nibac {
 
         inline static double getActivityToleranceDefault(void) { return CP_ACTIVITY_TOLERANCE_DEFAULT; }
 
+        // The size of the cut pool, as outlined above.
+        inline int getCutPoolSize(void) const { return CP_CUT_POOL_SIZE; }
+
+        inline void setCutPoolSize(int pCP_CUT_POOL_SIZE) {
+            if (pCP_CUT_POOL_SIZE < 0)
+                throw IllegalParameterException("BACOptions::CutPoolSize", pCP_CUT_POOL_SIZE,
+                                                "CutPoolSize must be nonnegative");
+            CP_CUT_POOL_SIZE = pCP_CUT_POOL_SIZE;
+        }
+
+        inline static int getCutPoolSizeDefault(void) { return CP_CUT_POOL_SIZE_DEFAULT; }
+
         // The lower bound on the solution.
         inline int getLowerBound(void) const { return BB_LBOUND; }
 
@@ -257,10 +388,138 @@ namespace vorpal::nibac {
 
         inline static bool keepCutsDefault(void) { return keepcutsDefault; }
 
+        // Do we want to run the cut producers concurrently?
+        inline bool concurrentSeparation(void) const { return concurrentseparation; }
+
+        inline void concurrentSeparation(bool pconcurrentseparation) { concurrentseparation = pconcurrentseparation; }
+
+        inline static bool concurrentSeparationDefault(void) { return concurrentseparationDefault; }
+
+        // Do we want to fix variables by reduced cost?
+        inline bool reducedCostFixing(void) const { return reducedcostfixing; }
+
+        inline void reducedCostFixing(bool preducedcostfixing) { reducedcostfixing = preducedcostfixing; }
+
+        inline static bool reducedCostFixingDefault(void) { return reducedcostfixingDefault; }
+
+        // Do we want the LP solver to reduce the LP at each node?
+        inline bool reduceLP(void) const { return reducelp; }
+
+        inline void reduceLP(bool preducelp) { reducelp = preducelp; }
+
+        inline static bool reduceLPDefault(void) { return reducelpDefault; }
+
+        // The number of threads, as outlined above.
+        inline int getNumberThreads(void) const { return PAR_NUMBER_THREADS; }
+
+        inline void setNumberThreads(int pPAR_NUMBER_THREADS) {
+            if (pPAR_NUMBER_THREADS < 1)
+                throw IllegalParameterException("BACOptions::NumberThreads", pPAR_NUMBER_THREADS,
+                                                "NumberThreads must be positive");
+            PAR_NUMBER_THREADS = pPAR_NUMBER_THREADS;
+        }
+
+        inline static int getNumberThreadsDefault(void) { return PAR_NUMBER_THREADS_DEFAULT; }
+
+        // The node selection strategy, as outlined above.
+        inline NodeSelector::Strategy getNodeSelection(void) const { return NS_STRATEGY; }
+
+        inline void setNodeSelection(NodeSelector::Strategy pNS_STRATEGY) {
+            if (pNS_STRATEGY < NodeSelector::DEPTHFIRST || pNS_STRATEGY > NodeSelector::HYBRID)
+                throw IllegalParameterException("BACOptions::NodeSelection", pNS_STRATEGY,
+                                                "NodeSelection must be a valid strategy");
+            NS_STRATEGY = pNS_STRATEGY;
+        }
+
+        inline static NodeSelector::Strategy getNodeSelectionDefault(void) { return NS_STRATEGY_DEFAULT; }
+
+        // The length of a dive for the hybrid node selection strategy, as outlined above.
+        inline int getDiveLength(void) const { return NS_DIVE_LENGTH; }
+
+        inline void setDiveLength(int pNS_DIVE_LENGTH) {
+            if (pNS_DIVE_LENGTH < 1)
+                throw IllegalParameterException("BACOptions::DiveLength", pNS_DIVE_LENGTH,
+                                                "DiveLength must be positive");
+            NS_DIVE_LENGTH = pNS_DIVE_LENGTH;
+        }
+
+        inline static int getDiveLengthDefault(void) { return NS_DIVE_LENGTH_DEFAULT; }
+
         // The export file. Set to null to not export.
         inline const char *getExportFileName(void) { return exportFileName; }
 
         inline void setExportFileName(const char *pexportFileName) { exportFileName = pexportFileName; }
+
+        // The checkpoint file. Set to null to not write checkpoints.
+        inline const char *getCheckpointFileName(void) { return checkpointFileName; }
+
+        inline void setCheckpointFileName(const char *pcheckpointFileName) { checkpointFileName = pcheckpointFileName; }
+
+        // The number of seconds between checkpoints, as outlined above.
+        inline int getCheckpointInterval(void) const { return CK_INTERVAL; }
+
+        inline void setCheckpointInterval(int pCK_INTERVAL) {
+            if (pCK_INTERVAL < 1)
+                throw IllegalParameterException("BACOptions::CheckpointInterval", pCK_INTERVAL,
+                                                "CheckpointInterval must be positive");
+            CK_INTERVAL = pCK_INTERVAL;
+        }
+
+        inline static int getCheckpointIntervalDefault(void) { return CK_INTERVAL_DEFAULT; }
+
+        // The checkpoint files from which to resume the search. If there are none, we start at the root.
+        inline const std::vector<const char *> &getResumeFileNames(void) const { return resumeFileNames; }
+
+        inline void addResumeFileName(const char *presumeFileName) { resumeFileNames.push_back(presumeFileName); }
+
+        // The prefix of the work unit files. Set to null to not split the search.
+        inline const char *getWorkUnitFileName(void) { return workUnitFileName; }
+
+        inline void setWorkUnitFileName(const char *pworkUnitFileName) { workUnitFileName = pworkUnitFileName; }
+
+        // The depth of the nodes written as work units, as outlined above.
+        inline int getSplitDepth(void) const { return SPLIT_DEPTH; }
+
+        inline void setSplitDepth(int pSPLIT_DEPTH) {
+            if (pSPLIT_DEPTH < 1)
+                throw IllegalParameterException("BACOptions::SplitDepth", pSPLIT_DEPTH,
+                                                "SplitDepth must be positive");
+            SPLIT_DEPTH = pSPLIT_DEPTH;
+        }
+
+        inline static int getSplitDepthDefault(void) { return SPLIT_DEPTH_DEFAULT; }
+
+        // The number of seconds between progress reports, as outlined above.
+        inline int getProgressInterval(void) const { return PROGRESS_INTERVAL; }
+
+        inline void setProgressInterval(int pPROGRESS_INTERVAL) {
+            if (pPROGRESS_INTERVAL < 0)
+                throw IllegalParameterException("BACOptions::ProgressInterval", pPROGRESS_INTERVAL,
+                                                "ProgressInterval must be nonnegative");
+            PROGRESS_INTERVAL = pPROGRESS_INTERVAL;
+        }
+
+        inline static int getProgressIntervalDefault(void) { return PROGRESS_INTERVAL_DEFAULT; }
+
+        // The address at which to coordinate a distributed search. Set to null to not coordinate.
+        inline const char *getListenAddress(void) { return listenAddress; }
+
+        inline void setListenAddress(const char *plistenAddress) { listenAddress = plistenAddress; }
+
+        // The address of the coordinator to work for. Set to null to not work for one.
+        inline const char *getCoordinatorAddress(void) { return coordinatorAddress; }
+
+        inline void setCoordinatorAddress(const char *pcoordinatorAddress) { coordinatorAddress = pcoordinatorAddress; }
+
+        // The file to which to record the LPs solved. Set to null to not record them.
+        inline const char *getLPRecordFileName(void) { return lpRecordFileName; }
+
+        inline void setLPRecordFileName(const char *plpRecordFileName) { lpRecordFileName = plpRecordFileName; }
+
+        // The file from which ReplaySolver replays the LPs.
+        inline const char *getLPReplayFileName(void) { return lpReplayFileName; }
+
+        inline void setLPReplayFileName(const char *plpReplayFileName) { lpReplayFileName = plpReplayFileName; }
     };
 };
 
@@ -4,6 +4,9 @@
  * By Sebastian Raaphorst, 2003 - 2018.
  */
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
 #include <map>
 #include <string>
 #include <sstream>
@@ -11,8 +14,8 @@
 #include "common.h"
 #include "cliquecutproducer.h"
 #include "bac.h"
-#include "column.h"
-#include "graph.h"
+#include "constraint.h"
+#include "formulation.h"
 #include "group.h"
 #include "nibacexception.h"
 #include "node.h"
@@ -21,15 +24,19 @@
 namespace vorpal::nibac {
     const double CliqueCutProducer::CC_DEFAULT_FRACTIONAL_THRESHOLD = 0.15;
     const double CliqueCutProducer::CC_DEFAULT_FRACTIONAL_PREFERENCE = 0.5;
-    const int    CliqueCutProducer::CC_DEFAULT_ENUMERATION_VALUE = 20;
+    const int    CliqueCutProducer::CC_DEFAULT_ENUMERATION_VALUE = 200;
+    const int    CliqueCutProducer::CC_DEFAULT_MAXIMUM_CLIQUES = 100;
 
 
     CliqueCutProducer::CliqueCutProducer(double pCC_FRACTIONAL_THRESHOLD,
                                          double pCC_FRACTIONAL_PREFERENCE,
-                                         int pCC_ENUMERATION_VALUE)
+                                         int pCC_ENUMERATION_VALUE,
+                                         int pCC_MAXIMUM_CLIQUES)
             : CC_FRACTIONAL_THRESHOLD(pCC_FRACTIONAL_THRESHOLD),
               CC_FRACTIONAL_PREFERENCE(pCC_FRACTIONAL_PREFERENCE),
-              CC_ENUMERATION_VALUE(pCC_ENUMERATION_VALUE) {
+              CC_ENUMERATION_VALUE(pCC_ENUMERATION_VALUE),
+              CC_MAXIMUM_CLIQUES(pCC_MAXIMUM_CLIQUES),
+              numberConflictWords(0) {
         if (pCC_FRACTIONAL_THRESHOLD < 0 || pCC_FRACTIONAL_THRESHOLD > 1)
             throw IllegalParameterException("CliqueCutProducer::FractionalThreshold",
                                             pCC_FRACTIONAL_THRESHOLD,
@@ -42,6 +49,10 @@ namespace vorpal::nibac {
             throw IllegalParameterException("CliqueCutProducer::EnumerationValue",
                                             pCC_ENUMERATION_VALUE,
                                             "must be nonnegative");
+        if (pCC_MAXIMUM_CLIQUES < 1)
+            throw IllegalParameterException("CliqueCutProducer::MaximumCliques",
+                                            pCC_MAXIMUM_CLIQUES,
+                                            "must be positive");
     }
 
 
@@ -49,11 +60,42 @@ namespace vorpal::nibac {
     }
 
 
+    void CliqueCutProducer::initialize(Formulation &formulation) {
+        int numberVariables = formulation.getNumberVariables();
+        numberConflictWords = (numberVariables + WORDBITS - 1) / WORDBITS;
+        conflicts.assign((size_t) numberVariables * numberConflictWords, 0);
+
+        // Two variables conflict if they share a constraint with the same coefficient, which is
+        // what Column::intersects determines for their columns.
+        const std::map<unsigned long, Constraint *> &constraints = formulation.getConstraints();
+        for (std::map<unsigned long, Constraint *>::const_iterator iter = constraints.begin();
+             iter != constraints.end();
+             ++iter) {
+            std::vector<int> &positions = (*iter).second->getPositions();
+            std::vector<int> &coefficients = (*iter).second->getCoefficients();
+            for (int i = 0; i < (int) positions.size(); ++i)
+                for (int j = i + 1; j < (int) positions.size(); ++j) {
+                    if (coefficients[i] != coefficients[j] || positions[i] == positions[j])
+                        continue;
+                    conflicts[(size_t) positions[i] * numberConflictWords + positions[j] / WORDBITS]
+                            |= 1UL << (positions[j] % WORDBITS);
+                    conflicts[(size_t) positions[j] * numberConflictWords + positions[i] / WORDBITS]
+                            |= 1UL << (positions[i] % WORDBITS);
+                }
+        }
+    }
+
+
     void CliqueCutProducer::generateCuts(BAC &bac, Node &node, double violationTolerance,
                                          int &numberOfCuts, double &maximumViolation) {
         numberOfCuts = 0;
         maximumViolation = 0;
 
+        // BAC::solve builds the conflict graph before the search begins, but a producer used
+        // outside of it may not have been initialized.
+        if (conflicts.empty())
+            initialize(bac.getFormulation());
+
         Group *group = node.getSymmetryGroup();
 
         // The first thing we need to do is create the graph. To do so, we need to
@@ -91,21 +133,33 @@ namespace vorpal::nibac {
             indexToVariable[k] = *iter;
         }
 
-        // We now create the graph. This involves investigating columns of
-        // the incidence matrix and seeing if they intersect. Intersecting
-        // columns correspond to edges in our graph.
-        Graph graph(numberFractionals);
-        const std::vector<Column> &columns = bac.getFormulation().getColumns();
+        // We now create the graph, as the subgraph of the conflict graph induced by the
+        // fractional variables: the neighbours of each are found by masking its row of the
+        // conflict graph with the set of fractional variables. The graph is stored as a
+        // word-packed bitset of neighbours for each of its vertices.
 
-        for (int i = 0; i < numberFractionals; ++i)
-            for (int j = i + 1; j < numberFractionals; ++j) {
-                assert(i >= 0 && i < numberFractionals);
-                assert(indexToVariable[i] >= 0 && indexToVariable[i] < numberVariables);
-                assert(j >= 0 && j < numberFractionals);
-                assert(indexToVariable[j] >= 0 && indexToVariable[j] < numberVariables);
-                if (columns[indexToVariable[i]].intersects(columns[indexToVariable[j]]))
-                    graph.addEdge(i, j);
+        std::vector<unsigned long> fractionalMask(numberConflictWords, 0);
+        std::vector<int> variableToIndex(numberVariables, -1);
+        for (int i = 0; i < numberFractionals; ++i) {
+            fractionalMask[indexToVariable[i] / WORDBITS] |= 1UL << (indexToVariable[i] % WORDBITS);
+            variableToIndex[indexToVariable[i]] = i;
+        }
+
+        int numberWords = (numberFractionals + WORDBITS - 1) / WORDBITS;
+        std::vector<unsigned long> adjacency((size_t) numberFractionals * numberWords, 0);
+        for (int i = 0; i < numberFractionals; ++i) {
+            assert(indexToVariable[i] >= 0 && indexToVariable[i] < numberVariables);
+            const unsigned long *row = &conflicts[(size_t) indexToVariable[i] * numberConflictWords];
+            for (int word = 0; word < numberConflictWords; ++word) {
+                unsigned long bits = row[word] & fractionalMask[word];
+                while (bits) {
+                    int j = variableToIndex[word * WORDBITS + __builtin_ctzl(bits)];
+                    bits &= bits - 1;
+                    assert(j >= 0 && j < numberFractionals);
+                    adjacency[(size_t) i * numberWords + j / WORDBITS] |= 1UL << (j % WORDBITS);
+                }
             }
+        }
 
 #ifdef DEBUG
         std::cerr << "*** GRAPH FORMULATION ***" << std::endl;
@@ -117,36 +171,83 @@ namespace vorpal::nibac {
         for (int i=0; i < numberFractionals; ++i)
           std::cerr << " " << indexToVariable[i] << "(" << i << ")";
         std::cerr << std::endl;
-        graph.printGraph();
 #endif
 
-        // We now attempt to find the maximal cliques, using different techniques
-        // depending on the value of numberFractionals.
-        // Determine the components of the graph.
-        graph.determineComponents();
-        std::vector<std::vector<int> > &components = graph.getComponents();
+        // Determine the components of the graph by a breadth-first search over the vertices
+        // not yet reached.
+        std::vector<std::vector<int> > components;
+        std::vector<unsigned long> remaining(numberWords, 0);
+        for (int i = 0; i < numberFractionals; ++i)
+            remaining[i / WORDBITS] |= 1UL << (i % WORDBITS);
+        for (int word = 0; word < numberWords; ++word)
+            while (remaining[word]) {
+                int vertex = word * WORDBITS + __builtin_ctzl(remaining[word]);
+                remaining[word] &= remaining[word] - 1;
+                components.resize(components.size() + 1);
+                std::vector<int> &component = components.back();
+                component.push_back(vertex);
+                for (int head = 0; head < (int) component.size(); ++head) {
+                    const unsigned long *row = &adjacency[(size_t) component[head] * numberWords];
+                    for (int w = word; w < numberWords; ++w) {
+                        unsigned long bits = row[w] & remaining[w];
+                        remaining[w] &= ~bits;
+                        while (bits) {
+                            component.push_back(w * WORDBITS + __builtin_ctzl(bits));
+                            bits &= bits - 1;
+                        }
+                    }
+                }
+            }
 
-        // Iterate over the components, collecting cliques
+        // A clique inequality is violated if the values of its variables sum to more than this.
+        // Vertices are weighted by their values, so only cliques of more weight are of use.
+        std::vector<double> weights(numberFractionals);
+        for (int i = 0; i < numberFractionals; ++i)
+            weights[i] = solutionVariableArray[indexToVariable[i]];
+        double threshold = 1 + violationTolerance + EPSILON;
+
+        // Iterate over the components, collecting cliques. A clique needs two vertices to be
+        // violated, and we stop once we have enough cliques.
         std::vector<std::vector<int> > cliques;
+        CliqueSearch search;
+        search.threshold = threshold;
+        search.maximumCliques = CC_MAXIMUM_CLIQUES;
         for (std::vector<std::vector<int> >::iterator iter = components.begin();
-             iter != components.end();
+             iter != components.end() && (int) cliques.size() < CC_MAXIMUM_CLIQUES;
              ++iter) {
-            if ((*iter).size() <= CC_ENUMERATION_VALUE)
-                determineMaximalCliques(graph, *iter, cliques);
+            if ((*iter).size() < 2)
+                continue;
+
+            // The enumeration tries the vertices of most weight first, and the heuristic those
+            // closest to the fractional preference.
+            bool enumerateFlag = ((int) (*iter).size() <= CC_ENUMERATION_VALUE);
+            std::vector<std::pair<double, int> > order;
+            for (std::vector<int>::iterator viter = (*iter).begin(); viter != (*iter).end(); ++viter)
+                order.push_back(std::make_pair(enumerateFlag ? -weights[*viter]
+                                                             : fabs(CC_FRACTIONAL_PREFERENCE - weights[*viter]),
+                                               *viter));
+            std::sort(order.begin(), order.end());
+            search.vertices.clear();
+            for (std::vector<std::pair<double, int> >::iterator oiter = order.begin(); oiter != order.end(); ++oiter)
+                search.vertices.push_back((*oiter).second);
+            induceComponent(search, adjacency, numberWords, weights);
+
+            if (enumerateFlag)
+                determineMaximalCliques(search, cliques);
             else
-                cliqueHeuristic(graph, *iter, solutionVariableArray, numberVariables,
-                                numberFractionals, indexToVariable, CC_FRACTIONAL_PREFERENCE, cliques);
+                cliqueHeuristic(search, cliques);
 #ifdef DEBUG
-            std::cerr << "Called " << ((*iter).size() <= CC_ENUMERATION_VALUE ? "enumerator" : "heuristic")
+            std::cerr << "Called " << (enumerateFlag ? "enumerator" : "heuristic")
              << " and produced " << cliques.size() << " cliques." << std::endl;
 #endif
         }
 
         // Now we test the cliques to see if they generate violated inequalities, and if they do,
-        // we add them to the ILP.
+        // we add them to the ILP, all at once.
         double value;
         double violation;
         Formulation &formulation = bac.getFormulation();
+        std::vector<Constraint *> constraints;
         for (std::vector<std::vector<int> >::iterator iter = cliques.begin();
              iter != cliques.end();
              ++iter) {
@@ -161,17 +262,19 @@ namespace vorpal::nibac {
                 value += solutionVariableArray[indexToVariable[*iter2]];
                 positions.push_back(indexToVariable[*iter2]);
             }
-            violation = value - 1;
-            if (isunviolated(violation, 0, 1 + violationTolerance))
+            if (isunviolated(value, 0, 1 + violationTolerance))
                 continue;
+            violation = value - 1;
 
-            // Add a constaint to the node, as it is valid in the subtree rooted here.
-            Constraint *constraint = Constraint::createConstraint(formulation, positions, LT, 1);
-            node.addCut(constraint);
+            // The graph comes from the constraints of the formulation, not from the node, so the
+            // inequality is valid at every node.
+            constraints.push_back(Constraint::createConstraint(formulation, positions, LT, 1));
             ++numberOfCuts;
             if (violation > maximumViolation)
                 maximumViolation = violation;
         }
+        if (!constraints.empty())
+            numberOfCuts = bac.addCuts(node, constraints, true);
 #ifdef DEBUG
         std::cerr << "Total number of inequalities in this pass: " << numberOfCuts << std::endl;
 #endif
@@ -180,292 +283,169 @@ namespace vorpal::nibac {
     }
 
 
-    void CliqueCutProducer::cliqueHeuristic(Graph &graph,
-                                            std::vector<int> &vertices,
-                                            double *solutionVariableArray,
-                                            int numberVariables,
-                                            int numberFractionals,
-                                            int *indexToVariable,
-                                            float priority,
-                                            std::vector<std::vector<int> > &cliques) {
-        // We sort the vertices in vertices according to how close they are to priority.
-        std::vector<int> sortedVertices;
-        std::vector<double> values;
-
-        // Create an array of priorities, indexed by vertex. We must first find the largest
-        // vertex.
-        int largest = -1;
-        for (std::vector<int>::iterator iter = vertices.begin();
-             iter != vertices.end();
-             ++iter)
-            if (*iter > largest)
-                largest = *iter;
-        assert(largest >= 0);
-
-        // Calculate the priorities array
-        int prioritiesSize = largest + 1;
-        double *priorities = new double[prioritiesSize];
-        for (std::vector<int>::iterator iter = vertices.begin();
-             iter != vertices.end();
-             ++iter) {
-            assert(*iter >= 0 && *iter < prioritiesSize);
-            assert(*iter >= 0 && *iter < numberFractionals);
-            assert(indexToVariable[*iter] >= 0 && indexToVariable[*iter] < numberVariables);
-            priorities[*iter] = fabs(priority - solutionVariableArray[indexToVariable[*iter]]);
+    void CliqueCutProducer::induceComponent(CliqueSearch &search,
+                                            const std::vector<unsigned long> &adjacency,
+                                            int numberWords,
+                                            const std::vector<double> &weights) {
+        // Number the vertices of the component in their order, and restrict the graph to them.
+        search.numberVertices = search.vertices.size();
+        search.numberWords = (search.numberVertices + WORDBITS - 1) / WORDBITS;
+        search.adjacency.assign((size_t) search.numberVertices * search.numberWords, 0);
+        search.weights.resize(search.numberVertices);
+        std::vector<int> position(numberWords * WORDBITS, -1);
+        for (int i = 0; i < search.numberVertices; ++i) {
+            position[search.vertices[i]] = i;
+            search.weights[i] = weights[search.vertices[i]];
         }
 
-        // Now we sort the vertices according to priority using a quicksort
-        quicksort(vertices, priorities, 0, vertices.size() - 1);
-
-        // We want to mark the nodes, so create a boolean array to do so
-        bool *markedNodes = new bool[prioritiesSize];
-        for (int i = 0; i < prioritiesSize; ++i)
-            markedNodes[i] = false;
-
-        // Now we iterate over the vertices, creating cliques and marking nodes as
-        // we go. We continue until all relevant nodes are marked.
-        for (std::vector<int>::iterator iter = vertices.begin();
-             iter != vertices.end();
-             ++iter) {
-            // Check if this node is marked; if it is, we have found a clique containing
-            // it and will gain nothing new from processing it.
-            assert(*iter >= 0 && *iter < prioritiesSize);
-            if (markedNodes[*iter])
-                continue;
-
-            // We begin searching for a new clique at this node.
-            std::vector<int> clique;
-            cliqueHeuristicAux(graph, *iter, priorities, clique);
-
-            // Mark all the nodes in the clique
-            for (std::vector<int>::iterator citer = clique.begin();
-                 citer != clique.end();
-                 ++citer) {
-                assert(*citer >= 0 && *citer < prioritiesSize);
-                markedNodes[*citer] = true;
+        for (int i = 0; i < search.numberVertices; ++i) {
+            const unsigned long *row = &adjacency[(size_t) search.vertices[i] * numberWords];
+            unsigned long *localRow = &search.adjacency[(size_t) i * search.numberWords];
+            for (int word = 0; word < numberWords; ++word) {
+                unsigned long bits = row[word];
+                while (bits) {
+                    int j = position[word * WORDBITS + __builtin_ctzl(bits)];
+                    bits &= bits - 1;
+                    if (j >= 0)
+                        localRow[j / WORDBITS] |= 1UL << (j % WORDBITS);
+                }
             }
-
-            // Add the clique to our list
-            cliques.push_back(clique);
         }
 
-        delete[] markedNodes;
-        delete[] priorities;
+        // The candidates, excluded vertices and vertices to branch on at each depth of the search.
+        search.sets.assign((size_t) (search.numberVertices + 1) * 3 * search.numberWords, 0);
+        search.clique.clear();
     }
 
 
-    void CliqueCutProducer::cliqueHeuristicAux(Graph &graph,
-                                               int startVertex,
-                                               double *priorities,
-                                               std::vector<int> &clique) {
-        // Create a list of candidates and sort by priority
-        clique.push_back(startVertex);
-        assert(startVertex >= 0 && startVertex < graph.getNumberVertices());
-        std::set<int> &adjacencyList = (graph.getAdjacencyLists())[startVertex];
-
-        // Instead of using a vector or anything of that sort, due to problems with erase,
-        // we will instead use an array of candidates. In previous implementations, removing
-        // things from the end of a vector would return an iterator to the thing that was
-        // removed instead of to the end of the vector as expected and as indicated in the STL
-        // documentation (an invalid iterator). This is not acceptable.
-        int *candidates = new int[adjacencyList.size()];
-
-        int k = 0;
-        for (std::set<int>::iterator iter = adjacencyList.begin();
-             iter != adjacencyList.end();
-             ++iter, ++k) {
-            assert(k >= 0 && k < adjacencyList.size());
-            candidates[k] = *iter;
-        }
+    void CliqueCutProducer::cliqueHeuristic(CliqueSearch &search,
+                                            std::vector<std::vector<int> > &cliques) {
+        // Starting from each vertex in turn that is not yet in a clique, we greedily extend a
+        // clique by the candidate of best priority, i.e. the first, until there are none left.
+        int numberWords = search.numberWords;
+        std::vector<unsigned long> marked(numberWords, 0);
+        std::vector<unsigned long> candidates(numberWords);
+        for (int vertex = 0; vertex < search.numberVertices && (int) cliques.size() < search.maximumCliques; ++vertex) {
+            if ((marked[vertex / WORDBITS] >> (vertex % WORDBITS)) & 1UL)
+                continue;
 
-        // highPosition is used to indicate the highest position of a valid
-        // entry in the candidates array. Originally, it is the last element in
-        // the candidates array, as everything in candidates represents a valid
-        // clique candidate.
-        int highPosition = adjacencyList.size() - 1;
-        quicksort(candidates, priorities, 0, highPosition);
-
-        // If there are no more candidates, then we are done.
-        while (highPosition >= 0) {
-            // Pick the next candidate and find the adjacency intersection
-            int candidate = candidates[0];
-            assert(candidate >= 0 && candidate < graph.getNumberVertices());
-            std::set<int> &neighbours = (graph.getAdjacencyLists())[candidate];
-
-            // Remove all the candidates that are not neighbours, modifying
-            // the array.
-            int subtractFactor = 1;
-            for (int i = 1; i <= highPosition; ++i) {
-                // Check to see if the current candidate is a neighbour
-                if (neighbours.find(candidates[i]) != neighbours.end()) {
-                    // It is, so copy this guy back and proceed.
-                    candidates[i - subtractFactor] = candidates[i];
+            std::vector<int> clique(1, vertex);
+            double weight = search.weights[vertex];
+            const unsigned long *row = &search.adjacency[(size_t) vertex * numberWords];
+            std::copy(row, row + numberWords, candidates.begin());
+            for (int word = 0; word < numberWords;) {
+                if (!candidates[word]) {
+                    ++word;
                     continue;
                 }
-
-                // It is not, so remove it.
-                ++subtractFactor;
+                int candidate = word * WORDBITS + __builtin_ctzl(candidates[word]);
+                clique.push_back(candidate);
+                weight += search.weights[candidate];
+                row = &search.adjacency[(size_t) candidate * numberWords];
+                for (int w = word; w < numberWords; ++w)
+                    candidates[w] &= row[w];
             }
 
-            // We now have sub less elements in candidates.
-            highPosition -= subtractFactor;
-
-            // Add this candidate to the clique and call recursively
-            clique.push_back(candidate);
+            // Mark the vertices in the clique, and keep it if it is of use.
+            for (std::vector<int>::iterator iter = clique.begin(); iter != clique.end(); ++iter) {
+                marked[*iter / WORDBITS] |= 1UL << (*iter % WORDBITS);
+                *iter = search.vertices[*iter];
+            }
+            if (weight > search.threshold)
+                cliques.push_back(clique);
         }
-
-        delete[] candidates;
     }
 
 
-    void CliqueCutProducer::determineMaximalCliques(Graph &graph,
-                                                    std::vector<int> &vertices,
+    void CliqueCutProducer::determineMaximalCliques(CliqueSearch &search,
                                                     std::vector<std::vector<int> > &cliques) {
-        // Use a backtracking approach to do this, only ever adding vertices in strictly
-        // increasing numbered order. At every point in the backtrack, we keep track of
-        // the set of all neighbours of our vertices. When we can add no strictly larger
-        // numbered vertex, we are done, and if the list of neighbours is empty, then
-        // we have a maximal clique.
-
-        // The first thing that we will do is create an adjacency matrix for the subgraph
-        // over vertices; although this will take awhile to set up depending on edge density,
-        // it will allow constant time lookup of edges.
-        int numberVertices = vertices.size();
-        int totalNumberVertices = graph.getNumberVertices();
-        int **adjacencyMatrix = new int *[numberVertices];
-        for (int i = 0; i < numberVertices; ++i) {
-            adjacencyMatrix[i] = new int[numberVertices];
-            memset(adjacencyMatrix[i], 0, sizeof(int) * numberVertices);
-        }
-
-        // We also need arrays to convert between the vertices in vertices and the
-        // indices in the adjacency matrix.
-        int *vertexToMatrix = new int[totalNumberVertices];
-        int *matrixToVertex = new int[numberVertices];
-        for (int i = 0; i < totalNumberVertices; ++i)
-            vertexToMatrix[i] = -1;
+        // Every vertex is a candidate to begin with, and none is excluded.
+        unsigned long *candidates = &search.sets[0];
+        for (int i = 0; i < search.numberVertices; ++i)
+            candidates[i / WORDBITS] |= 1UL << (i % WORDBITS);
+        extendClique(search, 0, 0, cliques);
+    }
 
-        // Initialize the adjacency matrix.
-        std::set<int> *adjacencyLists = graph.getAdjacencyLists();
 
-        // We start by initializing the vertexToMatrix array.
-        int k = 0;
-        for (std::vector<int>::iterator iter = vertices.begin();
-             iter != vertices.end();
-             ++iter, ++k) {
-            int vertex = *iter;
-            assert(vertex >= 0 && vertex < totalNumberVertices);
-            vertexToMatrix[vertex] = k;
-            assert(k >= 0 && k < numberVertices);
-            matrixToVertex[k] = vertex;
+    bool CliqueCutProducer::extendClique(CliqueSearch &search, int depth, double weight,
+                                         std::vector<std::vector<int> > &cliques) {
+        // This is the algorithm of Bron and Kerbosch, with the pivoting rule of Tomita et al.
+        // The candidates are the vertices adjacent to all of the clique, and the excluded
+        // vertices are those that are too, but of which every maximal clique containing the
+        // clique and them has already been found.
+        int numberWords = search.numberWords;
+        unsigned long *candidates = &search.sets[(size_t) depth * 3 * numberWords];
+        unsigned long *excluded = candidates + numberWords;
+        unsigned long *branches = excluded + numberWords;
+
+        // Only cliques whose weight is more than the threshold are of use, so we give up if the
+        // clique and all the candidates together are not.
+        double candidateWeight = 0;
+        bool candidatesFlag = false, excludedFlag = false;
+        for (int word = 0; word < numberWords; ++word) {
+            candidatesFlag = candidatesFlag || candidates[word];
+            excludedFlag = excludedFlag || excluded[word];
+            for (unsigned long bits = candidates[word]; bits; bits &= bits - 1)
+                candidateWeight += search.weights[word * WORDBITS + __builtin_ctzl(bits)];
         }
-
-        // Now we are ready to create the adjacency matrix.
-        std::set<int>::iterator beginIter2, endIter2;
-        for (std::vector<int>::iterator iter = vertices.begin();
-             iter != vertices.end();
-             ++iter) {
-            assert(*iter >= 0 && *iter < totalNumberVertices);
-            int vertex = vertexToMatrix[*iter];
-            std::set<int> &adjacencyList = adjacencyLists[*iter];
-
-            for (std::set<int>::iterator aiter = adjacencyList.begin();
-                 aiter != adjacencyList.end();
-                 ++aiter)
-                if (vertexToMatrix[*aiter] >= 0) {
-                    assert(vertex >= 0 && vertex < numberVertices);
-                    assert(vertexToMatrix[*aiter] >= 0 && vertexToMatrix[*aiter] < numberVertices);
-                    adjacencyMatrix[vertex][vertexToMatrix[*aiter]] = 1;
-                }
+        if (!candidatesFlag) {
+            // The clique is maximal if no excluded vertex extends it.
+            if (!excludedFlag && weight > search.threshold) {
+                cliques.push_back(std::vector<int>());
+                for (std::vector<int>::iterator iter = search.clique.begin(); iter != search.clique.end(); ++iter)
+                    cliques.back().push_back(search.vertices[*iter]);
+            }
+            return (int) cliques.size() < search.maximumCliques;
         }
+        if (weight + candidateWeight <= search.threshold)
+            return true;
 
-        // We now have the adjacency matrix, and we are ready to backtrack.
-        // We need an array to represent the clique so far, and a two dimensional
-        // array to hold the neighbours of all the elements in the clique so far.
-        int bound = numberVertices + 1;
-        int **neighbours = new int *[bound];
-        for (int i = 0; i < bound; ++i)
-            neighbours[i] = new int[numberVertices];
-        int *neighbourCount = new int[bound];
-        int *nextValidElement = new int[bound];
-        int *clique = new int[numberVertices];
-        int cliqueSize = 0;
-
-        // We initialize the first entry in the neighbours array to hold all vertices,
-        // since we may start with any vertex to generate a maximal clique.
-        for (int i = 0; i < numberVertices; ++i)
-            neighbours[0][i] = i;
-        neighbourCount[0] = numberVertices;
-        nextValidElement[0] = 0;
-
-        while (cliqueSize >= 0) {
-            // If we have a clique that cannot be extended, we process it.
-            assert(cliqueSize >= 0 && cliqueSize < bound);
-            if (nextValidElement[cliqueSize] >= neighbourCount[cliqueSize]
-                || nextValidElement[cliqueSize] == -1) {
-                // Check to see if this clique is maximal.
-                if (!neighbourCount[cliqueSize]) {
-                    // It is, so we output it.
-                    std::vector<int> vclique;
-                    for (int i = 0; i < cliqueSize; ++i) {
-                        assert(clique[i] >= 0 && clique[i] <= numberVertices);
-                        vclique.push_back(matrixToVertex[clique[i]]);
-                    }
-                    cliques.push_back(vclique);
+        // Pick as pivot the vertex among the candidates and excluded vertices with the most
+        // candidates as neighbours: only the candidates not adjacent to it need be branched on.
+        int pivot = -1, pivotCount = -1;
+        for (int word = 0; word < numberWords; ++word)
+            for (unsigned long bits = candidates[word] | excluded[word]; bits; bits &= bits - 1) {
+                int vertex = word * WORDBITS + __builtin_ctzl(bits);
+                const unsigned long *row = &search.adjacency[(size_t) vertex * numberWords];
+                int count = 0;
+                for (int w = 0; w < numberWords; ++w)
+                    count += __builtin_popcountl(candidates[w] & row[w]);
+                if (count > pivotCount) {
+                    pivot = vertex;
+                    pivotCount = count;
                 }
-
-                // We have nothing more to do with this clique, so we backtrack.
-                --cliqueSize;
-                continue;
             }
-
-            // We now have a clique that can be extended, so we extend it.
-            assert(nextValidElement[cliqueSize] >= 0 && nextValidElement[cliqueSize] < numberVertices);
-            assert(cliqueSize >= 0 && cliqueSize < numberVertices);
-            clique[cliqueSize] = neighbours[cliqueSize][nextValidElement[cliqueSize]];
-
-            // We now advance nextValidElement[cliqueSize] so that when we backtrack, we
-            // will try the next possibility.
-            ++nextValidElement[cliqueSize];
-
-            // We now initialize the neighbours, neighbourCount, and nextValidElement for
-            // the extension.
-            int nextindex = cliqueSize + 1;
-            neighbourCount[nextindex] = 0;
-            nextValidElement[nextindex] = -1;
-            assert(neighbourCount[cliqueSize] <= numberVertices);
-            for (int i = 0; i < neighbourCount[cliqueSize]; ++i) {
-                assert (clique[cliqueSize] >= 0 && clique[cliqueSize] < numberVertices);
-                assert(neighbours[cliqueSize][i] >= 0 && neighbours[cliqueSize][i] < numberVertices);
-                if (adjacencyMatrix[clique[cliqueSize]][neighbours[cliqueSize][i]]) {
-                    assert(nextindex >= 0 && nextindex < bound);
-                    assert(neighbourCount[nextindex] >= 0 && neighbourCount[nextindex] < numberVertices);
-                    neighbours[nextindex][neighbourCount[nextindex]] = neighbours[cliqueSize][i];
-
-                    // Check to see if this is a valid element.
-                    if (nextValidElement[nextindex] == -1 && neighbours[cliqueSize][i] > clique[cliqueSize])
-                        nextValidElement[nextindex] = neighbourCount[nextindex];
-
-                    ++neighbourCount[nextindex];
+        const unsigned long *pivotRow = &search.adjacency[(size_t) pivot * numberWords];
+        for (int word = 0; word < numberWords; ++word)
+            branches[word] = candidates[word] & ~pivotRow[word];
+
+        // Branch on the vertices in order, i.e. those of most weight first.
+        unsigned long *nextCandidates = branches + numberWords;
+        unsigned long *nextExcluded = nextCandidates + numberWords;
+        for (int word = 0; word < numberWords; ++word)
+            while (branches[word]) {
+                int vertex = word * WORDBITS + __builtin_ctzl(branches[word]);
+                branches[word] &= branches[word] - 1;
+
+                const unsigned long *row = &search.adjacency[(size_t) vertex * numberWords];
+                for (int w = 0; w < numberWords; ++w) {
+                    nextCandidates[w] = candidates[w] & row[w];
+                    nextExcluded[w] = excluded[w] & row[w];
                 }
+                search.clique.push_back(vertex);
+                bool continueFlag = extendClique(search, depth + 1, weight + search.weights[vertex], cliques);
+                search.clique.pop_back();
+                if (!continueFlag)
+                    return false;
+
+                // Every maximal clique with the vertex has now been found.
+                candidates[vertex / WORDBITS] &= ~(1UL << (vertex % WORDBITS));
+                excluded[vertex / WORDBITS] |= 1UL << (vertex % WORDBITS);
+                candidateWeight -= search.weights[vertex];
+                if (weight + candidateWeight <= search.threshold)
+                    return true;
             }
-
-            // We have now extended the clique and updated the neighbours, so we can loop.
-            ++cliqueSize;
-        }
-
-        // Free up the memory structures.
-        delete[] clique;
-        delete[] nextValidElement;
-        delete[] neighbourCount;
-        for (int i = 0; i < bound; ++i)
-            delete[] neighbours[i];
-        delete[] neighbours;
-        delete[] vertexToMatrix;
-        delete[] matrixToVertex;
-        for (int i = 0; i < numberVertices; ++i)
-            delete[] adjacencyMatrix[i];
-        delete[] adjacencyMatrix;
+        return true;
     }
 
 
@@ -473,7 +453,8 @@ namespace vorpal::nibac {
     CliqueCutProducerCreator::CliqueCutProducerCreator()
             : CC_FRACTIONAL_THRESHOLD(CliqueCutProducer::CC_DEFAULT_FRACTIONAL_THRESHOLD),
               CC_FRACTIONAL_PREFERENCE(CliqueCutProducer::CC_DEFAULT_FRACTIONAL_PREFERENCE),
-              CC_ENUMERATION_VALUE(CliqueCutProducer::CC_DEFAULT_ENUMERATION_VALUE) {
+              CC_ENUMERATION_VALUE(CliqueCutProducer::CC_DEFAULT_ENUMERATION_VALUE),
+              CC_MAXIMUM_CLIQUES(CliqueCutProducer::CC_DEFAULT_MAXIMUM_CLIQUES) {
     }
 
 
@@ -509,6 +490,14 @@ namespace vorpal::nibac {
                                     "instead of using a heuristic."),
                         enumerationValueStream.str());
 
+        std::ostringstream maximumCliquesStream;
+        maximumCliquesStream << CliqueCutProducer::CC_DEFAULT_MAXIMUM_CLIQUES;
+        optionsMap[std::string("M")] =
+                std::pair<std::string, std::string>(
+                        std::string("Maximum cliques: the search for cliques stops once this many "
+                                    "cliques giving violated inequalities have been found."),
+                        maximumCliquesStream.str());
+
         return optionsMap;
     }
 
@@ -564,6 +553,15 @@ namespace vorpal::nibac {
                     setEnumerationValue(ivalue);
                     break;
 
+                case 'M':
+                    stream >> ivalue;
+                    if (!stream)
+                        throw IllegalParameterException("CliqueCutProducer::MaximumCliques",
+                                                        "undefined",
+                                                        "could not interpret value in configuration string");
+                    setMaximumCliques(ivalue);
+                    break;
+
                 default:
                     std::ostringstream outputstream;
                     outputstream << ch;
@@ -588,6 +586,7 @@ namespace vorpal::nibac {
     CutProducer *CliqueCutProducerCreator::create(void) const {
         return new CliqueCutProducer(CC_FRACTIONAL_THRESHOLD,
                                      CC_FRACTIONAL_PREFERENCE,
-                                     CC_ENUMERATION_VALUE);
+                                     CC_ENUMERATION_VALUE,
+                                     CC_MAXIMUM_CLIQUES);
     }
 }
\ No newline at end of file
@@ -7,19 +7,32 @@
  * all the inequalities of the form ax <= b, where b=1. This could be
  * generalized for other b using hypergraphs, but due to time
  * constraints, we shall not implement this for the present moment.
+ *
+ * Two variables are adjacent in the graph if they appear with the same
+ * coefficient in a constraint of the formulation. The constraints do not
+ * change during the search, so this conflict graph is determined once, as
+ * a word-packed bitset of neighbours for each variable, and the graph on
+ * the fractional variables at a node is induced from it.
+ *
+ * The cliques in small components of the graph are enumerated by the
+ * algorithm of Bron and Kerbosch with the pivoting of Tomita et al, with
+ * the vertices weighted by their values in the solution of the LP, so that
+ * only cliques heavy enough to give violated inequalities are looked for.
+ * Larger components are covered by cliques found greedily. The search stops
+ * once enough violated cliques have been found.
  */
 
 
 #ifndef CLIQUECUTPRODUCER_H
 #define CLIQUECUTPRODUCER_H
 
+#include <climits>
 #include <map>
 #include <string>
 #include <vector>
 #include "common.h"
 #include "bac.h"
 #include "cutproducer.h"
-#include "graph.h"
 #include "node.h"
 
 namespace vorpal::nibac {
@@ -28,11 +41,38 @@ namespace vorpal::nibac {
         static const double CC_DEFAULT_FRACTIONAL_THRESHOLD;
         static const double CC_DEFAULT_FRACTIONAL_PREFERENCE;
         static const int CC_DEFAULT_ENUMERATION_VALUE;
+        static const int CC_DEFAULT_MAXIMUM_CLIQUES;
 
     private:
         double CC_FRACTIONAL_THRESHOLD;
         double CC_FRACTIONAL_PREFERENCE;
         int CC_ENUMERATION_VALUE;
+        int CC_MAXIMUM_CLIQUES;
+
+        enum { WORDBITS = sizeof(unsigned long) * CHAR_BIT };
+
+        // The conflict graph: the neighbours of each variable, in numberConflictWords words
+        // each. It is built by initialize, or by generateCuts if initialize was not called,
+        // and the workers of a parallel search share it.
+        int numberConflictWords;
+        std::vector<unsigned long> conflicts;
+
+        // A component of the graph on the fractional variables, with its vertices numbered in
+        // the order in which they are to be tried, along with the state of the search for its
+        // cliques. Cliques are of use if their weight is more than the threshold.
+        struct CliqueSearch {
+            int numberVertices;
+            int numberWords;
+            std::vector<int> vertices;
+            std::vector<unsigned long> adjacency;
+            std::vector<double> weights;
+            double threshold;
+            int maximumCliques;
+
+            // The sets of vertices at each depth of the enumeration, and the clique so far.
+            std::vector<unsigned long> sets;
+            std::vector<int> clique;
+        };
 
     public:
         // There are two constructors for this class. One of them involves
@@ -40,23 +80,38 @@ namespace vorpal::nibac {
         // order to properly create cliques with the right variables efficiently.
         CliqueCutProducer(double = CC_DEFAULT_FRACTIONAL_THRESHOLD,
                           double = CC_DEFAULT_FRACTIONAL_PREFERENCE,
-                          int = CC_DEFAULT_ENUMERATION_VALUE);
+                          int = CC_DEFAULT_ENUMERATION_VALUE,
+                          int = CC_DEFAULT_MAXIMUM_CLIQUES);
 
         virtual ~CliqueCutProducer();
 
         virtual void generateCuts(BAC &, Node &, double, int &, double &);
 
+        // Build the conflict graph from the constraints of the formulation.
+        virtual void initialize(Formulation &);
+
+        // The conflict graph is only read by generateCuts, so the workers of a parallel
+        // search share this producer.
+        virtual CutProducer *makeWorkerCopy(void) { return this; }
+
     private:
-        // Given a graph and a subset of the vertices in the graph (i.e.
-        // a component), determine all maximal cliques over the vertices
-        // and return this list as the third parameter to the function.
-        void determineMaximalCliques(Graph &, std::vector<int> &,
-                                     std::vector <std::vector<int>> &);
 
-        void cliqueHeuristic(Graph &, std::vector<int> &, double *, int, int, int *, float,
-                             std::vector <std::vector<int>> &);
+        // Set up the search over a component, whose vertices have been stored in order, given
+        // the graph over all the fractional variables, its number of words per vertex, and the
+        // weights of its vertices.
+        void induceComponent(CliqueSearch &, const std::vector<unsigned long> &, int, const std::vector<double> &);
+
+        // Determine the maximal cliques of a component that are of use, adding them to the list
+        // as lists of vertices of the graph, until the list holds enough of them.
+        void determineMaximalCliques(CliqueSearch &, std::vector<std::vector<int> > &);
 
-        void cliqueHeuristicAux(Graph &, int, double *, std::vector<int> &);
+        // Extend the clique at the given depth of the enumeration, whose weight is given.
+        // Returns false if enough cliques have been found.
+        bool extendClique(CliqueSearch &, int, double, std::vector<std::vector<int> > &);
+
+        // Cover a component greedily by cliques, each begun at the first vertex not yet in one,
+        // adding those that are of use to the list until it holds enough of them.
+        void cliqueHeuristic(CliqueSearch &, std::vector<std::vector<int> > &);
     };
 
 
@@ -66,6 +121,7 @@ namespace vorpal::nibac {
         double CC_FRACTIONAL_THRESHOLD;
         double CC_FRACTIONAL_PREFERENCE;
         int CC_ENUMERATION_VALUE;
+        int CC_MAXIMUM_CLIQUES;
 
         inline std::string getCutProducerName(void) override {
             return std::string("Generalized Clique Cuts");
@@ -99,6 +155,12 @@ namespace vorpal::nibac {
         inline void setEnumerationValue(int pCC_ENUMERATION_VALUE) {
             CC_ENUMERATION_VALUE = pCC_ENUMERATION_VALUE;
         }
+
+        inline int getMaximumCliques(void) const { return CC_MAXIMUM_CLIQUES; }
+
+        inline void setMaximumCliques(int pCC_MAXIMUM_CLIQUES) {
+            CC_MAXIMUM_CLIQUES = pCC_MAXIMUM_CLIQUES;
+        }
     };
 };
 #endif
@@ -13,6 +13,7 @@
 #include "closestvaluebranchingscheme.h"
 #include "nibacexception.h"
 #include "node.h"
+#include "variableset.h"
 
 namespace vorpal::nibac {
 // Static declarations
@@ -35,9 +36,9 @@ namespace vorpal::nibac {
         int closestvariable = -1;
         double closestvalue = DBL_MAX;
 
-        std::set<int> &freelist = n.getFreeVariables();
-        std::set<int>::iterator beginIter = freelist.begin();
-        std::set<int>::iterator endIter = freelist.end();
+        VariableSet &freelist = n.getFreeVariables();
+        VariableSet::iterator beginIter = freelist.begin();
+        VariableSet::iterator endIter = freelist.end();
         double *values = n.getSolutionVariableArray();
         double newvalue;
         for (; beginIter != endIter; ++beginIter) {
@@ -27,7 +27,7 @@ namespace vorpal::nibac {
     }
 
 
-    bool Column::intersects(const Column &other, int coeff) const {
+    bool Column::intersects(const Column &other) const {
         // We iterate over the sorted keys to determine if they share anything in common.
         std::map<unsigned long, int>::const_iterator beginIter1 = colinfo.begin();
         std::map<unsigned long, int>::const_iterator endIter1 = colinfo.end();
@@ -24,7 +24,7 @@ namespace vorpal::nibac {
 
         void remove(unsigned long);
 
-        bool intersects(const Column &, int= 1) const;
+        bool intersects(const Column &) const;
     };
 };
 #endif
@@ -15,6 +15,7 @@
 #include "cutproducer.h"
 #include "margotbacoptions.h"
 #include "nibacexception.h"
+#include "nodeselector.h"
 #include "solutionmanager.h"
 #include "util.h"
 #include "variableorder.h"
@@ -202,6 +203,32 @@ namespace vorpal::nibac {
                 continue;
             }
 
+            // * LPITERATIONLIMIT: -x # *
+            if (strcmp(argv[i], "-x") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-x", "none", "-x requires a number of iterations to be specified");
+                int paramvalue = atoi(argv[i + 1]);
+                if (paramvalue < 0)
+                    throw IllegalParameterException("-x", paramvalue, "LP iteration limit must be nonnegative");
+                options.setLPIterationLimit(paramvalue);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
+            // * LPTIMELIMIT: -X # *
+            if (strcmp(argv[i], "-X") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-X", "none", "-X requires a number of milliseconds to be specified");
+                int paramvalue = atoi(argv[i + 1]);
+                if (paramvalue < 0)
+                    throw IllegalParameterException("-X", paramvalue, "LP time limit must be nonnegative");
+                options.setLPTimeLimit(paramvalue);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
             // * MINNUMBEROFCUTS: -n # *
             if (strcmp(argv[i], "-n") == 0) {
                 if (i == argc - 1)
@@ -287,6 +314,19 @@ namespace vorpal::nibac {
                 continue;
             }
 
+            // * CUTPOOLSIZE: -Q # *
+            if (strcmp(argv[i], "-Q") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-Q", "none", "-Q requires a number of megabytes to be specified");
+                int paramvalue = atoi(argv[i + 1]);
+                if (paramvalue < 0)
+                    throw IllegalParameterException("-Q", paramvalue, "cut pool size must be nonnegative");
+                options.setCutPoolSize(paramvalue);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
             // * LBOUND: -b # *
             if (strcmp(argv[i], "-b") == 0) {
                 if (i == argc - 1)
@@ -322,6 +362,45 @@ namespace vorpal::nibac {
                 continue;
             }
 
+            // * CONCURRENTSEPARATION: -q # *
+            if (strcmp(argv[i], "-q") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-q", "none", "-q requires a 0/1 flag to be specified");
+                int paramvalue = atoi(argv[i + 1]);
+                if (paramvalue < 0 || paramvalue > 1)
+                    throw IllegalParameterException("-q", paramvalue, "-q can only accept a 0/1 value");
+                options.concurrentSeparation(paramvalue == 1);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
+            // * REDUCEDCOSTFIXING: -g # *
+            if (strcmp(argv[i], "-g") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-g", "none", "-g requires a 0/1 flag to be specified");
+                int paramvalue = atoi(argv[i + 1]);
+                if (paramvalue < 0 || paramvalue > 1)
+                    throw IllegalParameterException("-g", paramvalue, "-g can only accept a 0/1 value");
+                options.reducedCostFixing(paramvalue == 1);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
+            // * REDUCELP: -G # *
+            if (strcmp(argv[i], "-G") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-G", "none", "-G requires a 0/1 flag to be specified");
+                int paramvalue = atoi(argv[i + 1]);
+                if (paramvalue < 0 || paramvalue > 1)
+                    throw IllegalParameterException("-G", paramvalue, "-G can only accept a 0/1 value");
+                options.reduceLP(paramvalue == 1);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
             // * EXPORTFILE: -e filename *
             if (strcmp(argv[i], "-e") == 0) {
                 if (i == argc - 1)
@@ -332,6 +411,154 @@ namespace vorpal::nibac {
                 continue;
             }
 
+            // * CHECKPOINTFILE: -w filename *
+            if (strcmp(argv[i], "-w") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-w", "none", "-w requires a filename to be specified");
+                options.setCheckpointFileName(argv[i + 1]);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
+            // * CHECKPOINTINTERVAL: -W # *
+            if (strcmp(argv[i], "-W") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-W", "none", "-W requires a number of seconds to be specified");
+                int paramvalue = atoi(argv[i + 1]);
+                if (paramvalue < 1)
+                    throw IllegalParameterException("-W", paramvalue, "checkpoint interval must be positive");
+                options.setCheckpointInterval(paramvalue);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
+            // * RESUMEFILE: -r filename *
+            if (strcmp(argv[i], "-r") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-r", "none", "-r requires a filename to be specified");
+                options.addResumeFileName(argv[i + 1]);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
+            // * LPRECORDFILE: -y filename *
+            if (strcmp(argv[i], "-y") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-y", "none", "-y requires a filename to be specified");
+                options.setLPRecordFileName(argv[i + 1]);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
+            // * LPREPLAYFILE: -Y filename *
+            if (strcmp(argv[i], "-Y") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-Y", "none", "-Y requires a filename to be specified");
+                options.setLPReplayFileName(argv[i + 1]);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
+            // * WORKUNITFILE: -u prefix *
+            if (strcmp(argv[i], "-u") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-u", "none", "-u requires a filename prefix to be specified");
+                options.setWorkUnitFileName(argv[i + 1]);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
+            // * SPLITDEPTH: -U # *
+            if (strcmp(argv[i], "-U") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-U", "none", "-U requires a depth to be specified");
+                int paramvalue = atoi(argv[i + 1]);
+                if (paramvalue < 1)
+                    throw IllegalParameterException("-U", paramvalue, "split depth must be positive");
+                options.setSplitDepth(paramvalue);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
+            // * PROGRESSINTERVAL: -p # *
+            if (strcmp(argv[i], "-p") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-p", "none", "-p requires a number of seconds to be specified");
+                int paramvalue = atoi(argv[i + 1]);
+                if (paramvalue < 0)
+                    throw IllegalParameterException("-p", paramvalue, "progress interval must be nonnegative");
+                options.setProgressInterval(paramvalue);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
+            // * LISTENADDRESS: -l address *
+            if (strcmp(argv[i], "-l") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-l", "none", "-l requires an address to be specified");
+                options.setListenAddress(argv[i + 1]);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
+            // * COORDINATORADDRESS: -L address *
+            if (strcmp(argv[i], "-L") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-L", "none", "-L requires an address to be specified");
+                options.setCoordinatorAddress(argv[i + 1]);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
+            // * NUMBERTHREADS: -j # *
+            if (strcmp(argv[i], "-j") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-j", "none", "-j requires a number of threads to be specified");
+                int paramvalue = atoi(argv[i + 1]);
+                if (paramvalue < 1)
+                    throw IllegalParameterException("-j", paramvalue, "number of threads must be positive");
+                options.setNumberThreads(paramvalue);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
+            // * NODESELECTION: -N # *
+            if (strcmp(argv[i], "-N") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-N", "none", "-N requires a node selection strategy to be specified");
+                int paramvalue = atoi(argv[i + 1]);
+                if (paramvalue < NodeSelector::DEPTHFIRST || paramvalue > NodeSelector::HYBRID)
+                    throw IllegalParameterException("-N", paramvalue, "node selection strategy must be between 0 and 3");
+                options.setNodeSelection((NodeSelector::Strategy) paramvalue);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
+            // * DIVELENGTH: -D # *
+            if (strcmp(argv[i], "-D") == 0) {
+                if (i == argc - 1)
+                    throw IllegalParameterException("-D", "none", "-D requires a dive length to be specified");
+                int paramvalue = atoi(argv[i + 1]);
+                if (paramvalue < 1)
+                    throw IllegalParameterException("-D", paramvalue, "dive length must be positive");
+                options.setDiveLength(paramvalue);
+                movebackindex += 2;
+                i += 2;
+                continue;
+            }
+
             // * CUT PRODUCER STRING: -/+c#option=value:... *
             // This is only supported if there are cut producers.
             // Otherwise, allow this option to fall through.
@@ -646,6 +873,23 @@ namespace vorpal::nibac {
                "(default: " << BACOptions::getUpperBoundDefault() << ")" << std::endl;
         out << "-d # \t\t depth to switch from B&C library to pure ILP "
                "(default: " << BACOptions::getDepthDefault() << ")" << std::endl;
+        out << "-x # \t\t maximum number of simplex iterations for a single LP, if supported by LP solver "
+               "(default: " << BACOptions::getLPIterationLimitDefault() << ", i.e. no limit)" << std::endl;
+        out << "-X # \t\t maximum number of milliseconds for a single LP, if supported by LP solver "
+               "(default: " << BACOptions::getLPTimeLimitDefault() << ", i.e. no limit)" << std::endl;
+        out << "-G 0/1 \t\t flag indicating whether or not fixed variables and redundant rows should be left out "
+               "of the LP at each node; only SimplexSolver, the LP solver built into nibac, does so, and the "
+               "others ignore this flag "
+               "(default: " << (BACOptions::reduceLPDefault() ? '1' : '0') << ")" << std::endl;
+        out << "-N # \t\t node selection strategy: " << NodeSelector::DEPTHFIRST << " = depth-first, "
+            << NodeSelector::BESTBOUND << " = best-bound, " << NodeSelector::BESTESTIMATE << " = best-estimate, "
+            << NodeSelector::HYBRID << " = best-bound with depth-first dives "
+               "(default: " << BACOptions::getNodeSelectionDefault() << ")" << std::endl;
+        out << "-D # \t\t number of nodes in each dive of the hybrid node selection strategy "
+               "(default: " << BACOptions::getDiveLengthDefault() << ")" << std::endl;
+        out << "-g 0/1 \t\t flag indicating whether or not free variables should be fixed by reduced cost, "
+               "if supported by LP solver "
+               "(default: " << (BACOptions::reducedCostFixingDefault() ? '1' : '0') << ")" << std::endl;
         out << "-f list \t\t override default 0-fixings with comma separated list of indices of "
                "variables to initially fix to 0" << std::endl;
         out << "-F list \t\t override default 1-fixings with comma separated list of indices of "
@@ -684,9 +928,15 @@ namespace vorpal::nibac {
                "(default: " << BACOptions::getViolationToleranceUDefault() << ")" << std::endl;
         out << "-a #: \t activity tolerance for a cut to be considered active at a node "
                "(default: " << BACOptions::getActivityToleranceDefault() << ")" << std::endl;
+        out << "-Q #: \t number of megabytes of memory for the pool of cuts valid at every node, from which "
+               "cuts are readded when violated again "
+               "(default: " << BACOptions::getCutPoolSizeDefault() << ", i.e. no pool)" << std::endl;
         out << "-k 0/1: \t flag indicating whether or not inactive cuts should be readded when backtracking "
                "on nodes "
                "(default: " << (BACOptions::keepCutsDefault() ? '1' : '0') << ")" << std::endl;
+        out << "-q 0/1: \t flag indicating whether or not the cut producers should be run concurrently, each on "
+               "a thread of its own "
+               "(default: " << (BACOptions::concurrentSeparationDefault() ? '1' : '0') << ")" << std::endl;
 
         if (cutProducerCreators.size() > 0)
             out << "-c# / +c#option=value:option=value:... \t turn off (-) or on (+) a type of cut, "
@@ -719,6 +969,32 @@ namespace vorpal::nibac {
         out << "GENERAL OPTIONS" << std::endl;
         out << "-e name: \t name of file to export the ILP formulation if supported by LP solver "
                "(default: none, i.e. do not export)" << std::endl;
+        out << "-j #: \t number of threads with which to explore the branch-and-cut tree; cut producers "
+               "must be able to be shared or copied by the threads "
+               "(default: " << BACOptions::getNumberThreadsDefault() << ")" << std::endl;
+        out << "-w name: \t name of file to which to write checkpoints of the search "
+               "(default: none, i.e. do not write checkpoints)" << std::endl;
+        out << "-W #: \t number of seconds between checkpoints "
+               "(default: " << BACOptions::getCheckpointIntervalDefault() << ")" << std::endl;
+        out << "-r name: \t name of checkpoint file from which to resume the search; may be given "
+               "more than once to combine checkpoints (default: none, i.e. start a new search)" << std::endl;
+        out << "-u prefix: \t split the search, writing the nodes at the split depth to the work unit "
+               "files prefix.0, prefix.1, ..., which are solved by resuming from them "
+               "(default: none, i.e. do not split)" << std::endl;
+        out << "-U #: \t depth at which to split the search into work units "
+               "(default: " << BACOptions::getSplitDepthDefault() << ")" << std::endl;
+        out << "-p #: \t number of seconds between reports of the progress of the search, with the "
+               "estimated size of the tree and time left; requires a single thread and no distributed search "
+               "(default: " << BACOptions::getProgressIntervalDefault()
+            << ", i.e. do not report progress)" << std::endl;
+        out << "-l address: \t coordinate a distributed search, waiting for workers at address, "
+               "which is host:port or the path of a Unix socket (default: none)" << std::endl;
+        out << "-L address: \t work for the distributed search coordinated at address "
+               "(default: none)" << std::endl;
+        out << "-y name: \t name of file to which to record the results of the LPs solved "
+               "(default: none, i.e. do not record)" << std::endl;
+        out << "-Y name: \t name of file of recorded LP results to play back, if the replay LP solver "
+               "is linked in (default: none)" << std::endl;
         out << std::endl;
 
 
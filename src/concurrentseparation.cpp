@@ -0,0 +1,156 @@
+/**
+ * concurrentseparation.cpp
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "common.h"
+#include "bac.h"
+#include "concurrentseparation.h"
+#include "constraint.h"
+#include "cutproducer.h"
+#include "formulation.h"
+#include "node.h"
+
+namespace vorpal::nibac {
+    thread_local ConcurrentSeparation::Task *ConcurrentSeparation::currentTask = 0;
+
+
+    ConcurrentSeparation::ConcurrentSeparation(BAC &pbac, const std::vector<CutProducer *> &cutProducers)
+            : bac(pbac),
+              tasks(cutProducers.size()),
+              roundNumber(0),
+              numberRunning(0),
+              finished(false),
+              node(0),
+              violationTolerance(0) {
+        for (int i = 0; i < (int) tasks.size(); ++i)
+            tasks[i].cutProducer = cutProducers[i];
+        for (int i = 1; i < (int) tasks.size(); ++i)
+            threads.push_back(std::thread(&ConcurrentSeparation::work, this, i));
+    }
+
+
+    ConcurrentSeparation::~ConcurrentSeparation() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished = true;
+        }
+        startCondition.notify_all();
+        for (std::vector<std::thread>::iterator iter = threads.begin(); iter != threads.end(); ++iter)
+            (*iter).join();
+    }
+
+
+    void ConcurrentSeparation::run(Task &task) {
+        task.numberOfCuts = 0;
+        task.maximumViolation = 0;
+        currentTask = &task;
+        Constraint::setRecordOnly(true);
+        try {
+            task.cutProducer->generateCuts(bac, *node, violationTolerance, task.numberOfCuts, task.maximumViolation);
+        } catch (...) {
+            task.exception = std::current_exception();
+        }
+        Constraint::setRecordOnly(false);
+        currentTask = 0;
+    }
+
+
+    void ConcurrentSeparation::work(int index) {
+        unsigned long lastRound = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                startCondition.wait(lock, [&] { return finished || roundNumber != lastRound; });
+                if (finished)
+                    return;
+                lastRound = roundNumber;
+            }
+
+            run(tasks[index]);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                --numberRunning;
+            }
+            doneCondition.notify_one();
+        }
+    }
+
+
+    void ConcurrentSeparation::generateCuts(Node &pnode, double pviolationTolerance,
+                                            std::vector<int> &numberOfCuts, std::vector<double> &maximumViolation) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            node = &pnode;
+            violationTolerance = pviolationTolerance;
+            numberRunning = threads.size();
+            ++roundNumber;
+        }
+        startCondition.notify_all();
+
+        run(tasks[0]);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            doneCondition.wait(lock, [&] { return numberRunning == 0; });
+        }
+
+        // Create and add the cuts kept for each producer, so that their IDs follow the order
+        // in which they are added.
+        Formulation &formulation = bac.getFormulation();
+        std::exception_ptr exception;
+        numberOfCuts.assign(tasks.size(), 0);
+        maximumViolation.assign(tasks.size(), 0);
+        for (int i = 0; i < (int) tasks.size(); ++i) {
+            Task &task = tasks[i];
+            if (task.exception && !exception)
+                exception = task.exception;
+            task.exception = nullptr;
+
+            for (std::vector<std::pair<std::vector<Cut>, bool> >::iterator iter = task.cuts.begin();
+                 iter != task.cuts.end() && !exception;
+                 ++iter) {
+                std::vector<Constraint *> constraints;
+                constraints.reserve((*iter).first.size());
+                for (std::vector<Cut>::iterator citer = (*iter).first.begin();
+                     citer != (*iter).first.end();
+                     ++citer)
+                    constraints.push_back(Constraint::createConstraint(formulation, (*citer).positions,
+                                                                       (*citer).coefficients,
+                                                                       (*citer).lowerBound,
+                                                                       (*citer).upperBound));
+                if (!constraints.empty())
+                    numberOfCuts[i] += bac.addCuts(pnode, constraints, (*iter).second);
+            }
+            task.cuts.clear();
+            maximumViolation[i] = task.maximumViolation;
+        }
+
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
+
+    bool ConcurrentSeparation::keepCuts(std::vector<Constraint *> &cuts, bool globalFlag) {
+        if (!currentTask)
+            return false;
+
+        currentTask->cuts.push_back(std::make_pair(std::vector<Cut>(cuts.size()), globalFlag));
+        std::vector<Cut> &kept = currentTask->cuts.back().first;
+        for (int i = 0; i < (int) cuts.size(); ++i) {
+            kept[i].positions.swap(cuts[i]->getPositions());
+            kept[i].coefficients.swap(cuts[i]->getCoefficients());
+            kept[i].lowerBound = cuts[i]->getLowerBound();
+            kept[i].upperBound = cuts[i]->getUpperBound();
+            delete cuts[i];
+        }
+        return true;
+    }
+};
@@ -0,0 +1,106 @@
+/**
+ * concurrentseparation.h
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+// A ConcurrentSeparation runs the cut producers of a BAC at the same time, each
+// on a thread of its own, on the solution of the LP at a node. The first producer
+// runs on the thread of the BAC, and the others on threads that are kept for as
+// long as the BAC, so that no thread is started per node.
+//
+// While a producer runs, the cuts that it passes to BAC::addCuts are kept aside
+// for it rather than added to the node, as the node, the formulation and the LP
+// solver may only be used by the thread of the BAC. The constraints created by a
+// producer are only records (see Constraint::setRecordOnly), and we keep their
+// positions, coefficients and bounds. Once all the producers are done, the cuts
+// are created from these and added in the order of the producers, and in the order
+// in which each producer passed them, so that the LP is the same as when the
+// producers are run one after another.
+
+#ifndef CONCURRENTSEPARATION_H
+#define CONCURRENTSEPARATION_H
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "common.h"
+
+namespace vorpal::nibac {
+    // Class forwards
+    class BAC;
+    class Constraint;
+    class CutProducer;
+    class Node;
+
+    class ConcurrentSeparation final {
+    private:
+        struct Cut {
+            std::vector<int> positions;
+            std::vector<int> coefficients;
+            int lowerBound;
+            int upperBound;
+        };
+
+        struct Task {
+            CutProducer *cutProducer;
+
+            // What the producer reported.
+            int numberOfCuts;
+            double maximumViolation;
+
+            // The cuts passed to BAC::addCuts, in the order of the calls, each with
+            // whether they are valid at every node.
+            std::vector<std::pair<std::vector<Cut>, bool> > cuts;
+
+            // An exception thrown by the producer, which we rethrow from generateCuts.
+            std::exception_ptr exception;
+        };
+
+        // The task run by the calling thread, if it is running one.
+        static thread_local Task *currentTask;
+
+        BAC &bac;
+        std::vector<Task> tasks;
+
+        // The thread for each task but the first.
+        std::vector<std::thread> threads;
+
+        // The node and violation tolerance of the current round. The rounds are counted so
+        // that the threads can tell a new one from the one they have just finished, and the
+        // number of threads still running a task in it is kept.
+        std::mutex mutex;
+        std::condition_variable startCondition;
+        std::condition_variable doneCondition;
+        unsigned long roundNumber;
+        int numberRunning;
+        bool finished;
+        Node *node;
+        double violationTolerance;
+
+        // Run a task on the current node.
+        void run(Task &);
+
+        // The main loop of the thread for a task.
+        void work(int);
+
+    public:
+        ConcurrentSeparation(BAC &, const std::vector<CutProducer *> &);
+
+        virtual ~ConcurrentSeparation();
+
+        // Run the cut producers on the solution of the LP of a node, and add their cuts to
+        // the node. The number of cuts added by each producer, and the maximum violation
+        // that each reported, are stored in the given vectors, in the order of the producers.
+        void generateCuts(Node &, double, std::vector<int> &, std::vector<double> &);
+
+        // Called by BAC::addCuts: if the calling thread is running a cut producer for us,
+        // keep the cuts for it, given whether they are valid at every node, delete them, and
+        // return true.
+        static bool keepCuts(std::vector<Constraint *> &, bool);
+    };
+};
+
+#endif
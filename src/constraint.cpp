@@ -4,6 +4,7 @@
  * By Sebastian Raaphorst, 2003 - 2018.
  */
 
+#include <atomic>
 #include <vector>
 #include <limits.h>
 #include "common.h"
@@ -13,7 +14,8 @@
 
 namespace vorpal::nibac {
     // Static initializers.
-    unsigned long Constraint::CURRID = 0L;
+    std::atomic<unsigned long> Constraint::CURRID(0L);
+    thread_local bool Constraint::recordOnlyFlag = false;
 
 
     Constraint::Constraint(Formulation &formulation,
@@ -21,22 +23,37 @@ namespace vorpal::nibac {
                            std::vector<int> &pcoefficients,
                            int plowerBound,
                            int pupperBound)
-            : id(CURRID++),
+            : id(recordOnlyFlag ? ULONG_MAX : CURRID++),
               positions(ppositions),
               coefficients(pcoefficients),
               lowerBound(plowerBound),
-              upperBound(pupperBound) {
+              upperBound(pupperBound),
+              implementation(0),
+              lpSolver(recordOnlyFlag ? 0 : formulation.getLPSolver()) {
         // Sort the coefficients
         quicksort(positions, coefficients, 0, positions.size() - 1);
 
+        // Mix each position and coefficient, and then the bounds, into the signature.
+        signature = 0;
+        for (int i = 0; i <= (int) positions.size(); ++i) {
+            unsigned long value = (i < (int) positions.size()
+                                   ? ((unsigned long) positions[i] << 32) ^ (unsigned int) coefficients[i]
+                                   : ((unsigned long) (unsigned int) lowerBound << 32) ^ (unsigned int) upperBound);
+            unsigned long h = signature ^ (value + 0x9e3779b97f4a7c15UL + (signature << 6) + (signature >> 2));
+            h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9UL;
+            h = (h ^ (h >> 27)) * 0x94d049bb133111ebUL;
+            signature = h ^ (h >> 31);
+        }
+
         // Create the LP implementationific implementation
-        implementation = LPSolver::getInstance()->createConstraint(formulation, positions, coefficients, lowerBound,
-                                                                   upperBound);
+        if (lpSolver)
+            implementation = lpSolver->createConstraint(formulation, positions, coefficients, lowerBound, upperBound);
     }
 
 
     Constraint::~Constraint() {
-        LPSolver::getInstance()->deleteConstraint(implementation);
+        if (lpSolver)
+            lpSolver->deleteConstraint(implementation);
     }
 
 
@@ -76,6 +93,15 @@ namespace vorpal::nibac {
     }
 
 
+    bool Constraint::isDuplicateOf(const Constraint &other) const {
+        return signature == other.signature
+               && lowerBound == other.lowerBound
+               && upperBound == other.upperBound
+               && positions == other.positions
+               && coefficients == other.coefficients;
+    }
+
+
     bool Constraint::isInactive(double *variableValues, double activityTolerance) {
         double evaluation = evaluateConstraint(variableValues);
         return greaterthan(upperBound - evaluation, activityTolerance) ||
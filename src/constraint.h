@@ -7,12 +7,14 @@
 #ifndef CONSTRAINT_H
 #define CONSTRAINT_H
 
+#include <atomic>
 #include <vector>
 #include "common.h"
 
 namespace vorpal::nibac {
-    // Forward declaration to avoid recursive includes.
+    // Forward declarations to avoid recursive includes.
     class Formulation;
+    class LPSolver;
 
     /**
      * A class representing a constraint for a formulation.
@@ -20,7 +22,11 @@ namespace vorpal::nibac {
     class Constraint final {
     private:
         // A unique constraint ID, which we use for columnar information.
-        static unsigned long CURRID;
+        // This is atomic as constraints may be created by several worker threads at once.
+        static std::atomic<unsigned long> CURRID;
+
+        // Whether the constraints created by this thread are only records, as outlined below.
+        static thread_local bool recordOnlyFlag;
 
         // Our own implementation of constraints, coupled with the LP solver
         // specific implementation (stored in spec).
@@ -31,6 +37,12 @@ namespace vorpal::nibac {
         int upperBound;
         void *implementation;
 
+        // A hash of the positions, coefficients and bounds.
+        unsigned long signature;
+
+        // The LP solver of the formulation for which the implementation was created.
+        LPSolver *lpSolver;
+
         Constraint(Formulation &, std::vector<int> &, std::vector<int> &, int, int);
 
         static void quicksort(std::vector<int> &, std::vector<int> &, int, int);
@@ -38,6 +50,12 @@ namespace vorpal::nibac {
     public:
         virtual ~Constraint();
 
+        // While this is set for a thread, the constraints that it creates only record their positions,
+        // coefficients and bounds: they have no ID and no LP implementation, so that the thread need not
+        // use the LP solver, which only the thread of the BAC may. ConcurrentSeparation sets this for the
+        // threads of the cut producers, and creates their cuts from the records on the thread of the BAC.
+        inline static void setRecordOnly(bool precordOnlyFlag) { recordOnlyFlag = precordOnlyFlag; }
+
         // TODO: Make these const?
         inline std::vector<int> &getPositions(void) { return positions; }
 
@@ -53,6 +71,13 @@ namespace vorpal::nibac {
 
         inline void setImplementation(void *pimplementation) { implementation = pimplementation; }
 
+        // Constraints with the same positions, coefficients and bounds have the same signature, and
+        // constraints with different signatures are different.
+        inline unsigned long getSignature() const { return signature; }
+
+        // Check if a constraint has the same positions, coefficients and bounds as this one.
+        bool isDuplicateOf(const Constraint &) const;
+
         // Evaluate the variable part of this constraint using the
         // provided variable values.
         double evaluateConstraint(double *);
@@ -44,6 +44,11 @@ namespace vorpal::nibac {
     }
 
 
+    LPSolver *CPLEXSolver::makeInstance() {
+        return new CPLEXSolver();
+    }
+
+
     void CPLEXSolver::setupFormulation(Formulation &f) {
         // Create a new struct.
         CPLEXInfo *info = new CPLEXInfo;
@@ -283,6 +288,19 @@ namespace vorpal::nibac {
     }
 
 
+    void CPLEXSolver::setObjectiveCutoff(Formulation &f, int cutoff) {
+        // The objective limits stop the LPs early, and the cutoffs prune the branch-and-bound.
+        CPLEXInfo *info = (CPLEXInfo *) f.getData();
+        if (f.getProblemType() == Formulation::MAXIMIZATION) {
+            info->cplexL->setParam(IloCplex::ObjLLim, (double) cutoff - EPSILON);
+            info->cplexI->setParam(IloCplex::CutLo, (double) cutoff - EPSILON);
+        } else {
+            info->cplexL->setParam(IloCplex::ObjULim, (double) cutoff + EPSILON);
+            info->cplexI->setParam(IloCplex::CutUp, (double) cutoff + EPSILON);
+        }
+    }
+
+
     int CPLEXSolver::solveNode(BAC &bac, Node &n, bool fullsolve) {
         Formulation &f = bac.getFormulation();
         CPLEXInfo *info = (CPLEXInfo *) f.getData();
@@ -49,21 +49,26 @@ namespace vorpal::nibac {
             IloRange *rangeI;
         };
 
-        // The CPLEX environment object.
+        // The CPLEX environment object. Each formulation has a solver, and hence an
+        // environment, of its own, as an environment cannot be used by several threads.
         IloEnv env;
 
     protected:
         CPLEXSolver();
 
+    public:
         virtual ~CPLEXSolver();
 
-    public:
+        LPSolver *makeInstance() override;
+
         void setupFormulation(Formulation &) override;
 
         void cleanupFormulation(Formulation &) override;
 
         void setObjectiveFunction(Formulation &, std::vector<int> &, int = INT_MIN, int = INT_MAX) override;
 
+        void setObjectiveCutoff(Formulation &, int) override;
+
         void addConstraint(Formulation &, Constraint *) override;
 
         void removeConstraint(Formulation &, Constraint *) override;
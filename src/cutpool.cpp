@@ -0,0 +1,130 @@
+/**
+ * cutpool.cpp
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+
+#include <limits.h>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include "common.h"
+#include "bac.h"
+#include "constraint.h"
+#include "cutpool.h"
+#include "formulation.h"
+#include "node.h"
+
+namespace vorpal::nibac {
+    const unsigned long CutPool::MAXIMUM_AGE = 100;
+
+
+    CutPool::CutPool(size_t pmaximumSize)
+            : maximumSize(pmaximumSize),
+              size(0),
+              numberSearches(0) {
+    }
+
+
+    void CutPool::evict(void) {
+        std::list<Entry>::iterator last = --entries.end();
+        std::pair<std::unordered_multimap<unsigned long, std::list<Entry>::iterator>::iterator,
+                std::unordered_multimap<unsigned long, std::list<Entry>::iterator>::iterator> range
+                = index.equal_range((*last).signature);
+        for (std::unordered_multimap<unsigned long, std::list<Entry>::iterator>::iterator iter = range.first;
+             iter != range.second;
+             ++iter)
+            if ((*iter).second == last) {
+                index.erase(iter);
+                break;
+            }
+        size -= (*last).size;
+        entries.erase(last);
+    }
+
+
+    void CutPool::insert(Constraint *cut) {
+        std::pair<std::unordered_multimap<unsigned long, std::list<Entry>::iterator>::iterator,
+                std::unordered_multimap<unsigned long, std::list<Entry>::iterator>::iterator> range
+                = index.equal_range(cut->getSignature());
+        for (std::unordered_multimap<unsigned long, std::list<Entry>::iterator>::iterator iter = range.first;
+             iter != range.second;
+             ++iter) {
+            Entry &entry = *((*iter).second);
+            if (entry.lowerBound == cut->getLowerBound() && entry.upperBound == cut->getUpperBound()
+                && entry.positions == cut->getPositions() && entry.coefficients == cut->getCoefficients())
+                return;
+        }
+
+        // A new cut was just found violated, and starts out as the youngest.
+        entries.push_front(Entry());
+        Entry &entry = entries.front();
+        entry.signature = cut->getSignature();
+        entry.positions = cut->getPositions();
+        entry.coefficients = cut->getCoefficients();
+        entry.lowerBound = cut->getLowerBound();
+        entry.upperBound = cut->getUpperBound();
+        entry.numberViolations = 1;
+        entry.lastViolation = numberSearches;
+
+        // An estimate of the memory taken up by the cut, including its place in the list and the index.
+        entry.size = sizeof(Entry) + 6 * sizeof(void *)
+                     + (entry.positions.capacity() + entry.coefficients.capacity()) * sizeof(int);
+        size += entry.size;
+        index.insert(std::make_pair(entry.signature, entries.begin()));
+
+        while (size > maximumSize && !entries.empty())
+            evict();
+    }
+
+
+    void CutPool::addViolatedCuts(BAC &bac, Node &node, double violationTolerance,
+                                  int &numberOfCuts, double &maximumViolation) {
+        numberOfCuts = 0;
+        maximumViolation = 0;
+        ++numberSearches;
+
+        // A cut in the LP is satisfied by its solution, so the cuts violated are not there already.
+        // Each of them becomes the youngest, in turn.
+        Formulation &formulation = bac.getFormulation();
+        double *solutionVariableArray = node.getSolutionVariableArray();
+        std::vector<Constraint *> constraints;
+        std::list<Entry>::iterator iter = entries.begin();
+        while (iter != entries.end()) {
+            Entry &entry = *iter;
+            double value = 0;
+            for (int i = 0; i < (int) entry.positions.size(); ++i)
+                value += entry.coefficients[i] * solutionVariableArray[entry.positions[i]];
+
+            double violation = 0;
+            if (entry.upperBound != INT_MAX && value - entry.upperBound > violation)
+                violation = value - entry.upperBound;
+            if (entry.lowerBound != INT_MIN && entry.lowerBound - value > violation)
+                violation = entry.lowerBound - value;
+            if (violation <= violationTolerance) {
+                ++iter;
+                continue;
+            }
+
+            constraints.push_back(Constraint::createConstraint(formulation, entry.positions, entry.coefficients,
+                                                               entry.lowerBound, entry.upperBound));
+            if (violation > maximumViolation)
+                maximumViolation = violation;
+            ++entry.numberViolations;
+            entry.lastViolation = numberSearches;
+
+            std::list<Entry>::iterator next = iter;
+            ++next;
+            entries.splice(entries.begin(), entries, iter);
+            iter = next;
+        }
+        if (!constraints.empty())
+            numberOfCuts = bac.addCuts(node, constraints);
+
+        // Discard the cuts that have not been violated for too long. The oldest cuts are last, and
+        // while the others may be just as old, they will be discarded in turn.
+        while (!entries.empty()
+               && numberSearches - entries.back().lastViolation > MAXIMUM_AGE * entries.back().numberViolations)
+            evict();
+    }
+};
@@ -0,0 +1,83 @@
+/**
+ * cutpool.h
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+// A CutPool keeps the cuts found during a search that are valid for every node,
+// i.e. those that cut producers pass to BAC::addCuts as global, so that a cut that
+// leaves the LP, because it became inactive or because the node to which it was
+// added was left, need not be found again by its cut producer. At each iteration of
+// the cutting plane algorithm, the cuts in the pool violated by the solution of the
+// LP are added to the node before the cut producers are run. A cut is recognized by
+// its positions, coefficients and bounds (see Constraint::getSignature), and is never
+// held twice.
+//
+// Each cut counts the number of times that it was violated, and its age is the number
+// of times the pool was searched since it last was. A cut that grows too old for the
+// number of times that it was violated is discarded. The pool is also bounded by the
+// memory that its cuts take up, and when it is full, the oldest cut is discarded.
+
+#ifndef CUTPOOL_H
+#define CUTPOOL_H
+
+#include <stddef.h>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include "common.h"
+
+namespace vorpal::nibac {
+    // Class forwards
+    class BAC;
+    class Constraint;
+    class Node;
+
+    class CutPool final {
+    private:
+        struct Entry {
+            unsigned long signature;
+            std::vector<int> positions;
+            std::vector<int> coefficients;
+            int lowerBound;
+            int upperBound;
+            unsigned long numberViolations;
+            unsigned long lastViolation;
+            size_t size;
+        };
+
+        // The number of searches of the pool that a cut survives without being violated, for
+        // each time that it was.
+        static const unsigned long MAXIMUM_AGE;
+
+        size_t maximumSize;
+        size_t size;
+        unsigned long numberSearches;
+
+        // The cuts, the youngest first, and an index of them by signature.
+        std::list<Entry> entries;
+        std::unordered_multimap<unsigned long, std::list<Entry>::iterator> index;
+
+        // Discard the oldest cut.
+        void evict(void);
+
+    public:
+        // Create a pool whose cuts take up at most the given number of bytes.
+        CutPool(size_t);
+
+        virtual ~CutPool() = default;
+
+        // Store a cut, unless the pool already holds it. The pool keeps a copy, so the cut
+        // itself remains with its node.
+        void insert(Constraint *);
+
+        // Add the cuts violated by more than the given tolerance by the solution of the LP of a
+        // node to the node, through BAC::addCuts, so that duplicates of the cuts in the LP are
+        // dropped. The number of cuts added and the maximum violation are returned via the
+        // referenced parameters.
+        void addViolatedCuts(BAC &, Node &, double, int &, double &);
+
+        inline int getNumberCuts(void) const { return entries.size(); }
+    };
+};
+
+#endif
@@ -30,11 +30,21 @@ namespace vorpal::nibac {
         // This is the only method that must be overridden in subclasses; it performs
         // the actual cut-generation. The node is passed in for any node-specific
         // information that may be required. Similarly, the BAC algorithm is given.
-        // Cuts may be either added globally (to the cutpool) or locally (to the node)
-        // via methods in Formulation and Node. The number of cuts and the maximum violation are
-        // returned via the referenced parameters.
+        // Cuts are added to the node via BAC::addCuts, which is told if they are valid at every
+        // node, so that they may be kept in the cut pool, or only in the subtree rooted at the node.
+        // The number of cuts and the maximum violation are returned via the referenced parameters.
         virtual void generateCuts(BAC &, Node &, double, int &, double &) = 0;
 
+        // Called by BAC once the formulation is complete and before the search begins, so
+        // that producers may prepare anything that depends only on the formulation.
+        virtual void initialize(Formulation &) {}
+
+        // Called by a parallel search for each of its workers. Producers that keep no
+        // state between calls to generateCuts may return themselves, to be shared by the
+        // workers; others must return a private copy, which must be manually deleted. By
+        // default, 0 is returned, and the producer cannot be used with more than one thread.
+        virtual CutProducer *makeWorkerCopy(void) { return 0; }
+
     protected:
         // These are convenience method sthat we provide. Many of the cuts we will produce
         // require sorting a list of things according to some numerical value associated
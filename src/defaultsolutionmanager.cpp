@@ -72,6 +72,59 @@ namespace vorpal::nibac {
     }
 
 
+    void DefaultSolutionManager::writeCheckpoint(std::ostream &out) {
+        out << bestsoln << ' ' << solutions.size() << std::endl;
+        for (std::vector<std::vector<int> *>::iterator iter = solutions.begin();
+             iter != solutions.end();
+             ++iter) {
+            std::vector<int> &sol = **iter;
+            out << sol.size();
+            for (std::vector<int>::iterator siter = sol.begin();
+                 siter != sol.end();
+                 ++siter)
+                out << ' ' << *siter;
+            out << std::endl;
+        }
+    }
+
+
+    void DefaultSolutionManager::readCheckpoint(std::istream &in) {
+        double checkpointbestsoln;
+        int numberSolutions, size;
+        in >> checkpointbestsoln >> numberSolutions;
+
+        // As in newSolution, if we are only interested in optimal solutions, those of whichever
+        // of us has the worse best solution are certainly not optimal.
+        bool keepflag = true;
+        if (stype == Formulation::SEARCH || stype == Formulation::GENERATION) {
+            bool bestsolflag = ((ptype == Formulation::MAXIMIZATION && greaterthan(checkpointbestsoln, bestsoln))
+                                || (ptype == Formulation::MINIMIZATION && lessthan(checkpointbestsoln, bestsoln)));
+            bool worsesolflag = ((ptype == Formulation::MAXIMIZATION && lessthan(checkpointbestsoln, bestsoln))
+                                 || (ptype == Formulation::MINIMIZATION && greaterthan(checkpointbestsoln, bestsoln)));
+            if (bestsolflag) {
+                bestsoln = checkpointbestsoln;
+                if (!generateall)
+                    clearVector();
+            } else if (worsesolflag && !generateall)
+                keepflag = false;
+        }
+
+        for (int i = 0; in && i < numberSolutions; ++i) {
+            std::vector<int> *sol = new std::vector<int>;
+            in >> size;
+            for (int j = 0; in && j < size; ++j) {
+                int value;
+                in >> value;
+                sol->push_back(value);
+            }
+            if (keepflag)
+                solutions.push_back(sol);
+            else
+                delete sol;
+        }
+    }
+
+
     void DefaultSolutionManager::clearVector() {
         while (solutions.size() > 0) {
             std::vector<int> *sol = solutions.back();
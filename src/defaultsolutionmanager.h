@@ -35,6 +35,10 @@ namespace vorpal::nibac {
 
         virtual std::vector< std::vector< int> * > &getSolutions();
 
+        virtual void writeCheckpoint(std::ostream &);
+
+        virtual void readCheckpoint(std::istream &);
+
     protected:
         virtual void clearVector();
     };
@@ -0,0 +1,507 @@
+/**
+ * distributedsearch.cpp
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+
+#include <errno.h>
+#include <netdb.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "common.h"
+#include "bac.h"
+#include "bacoptions.h"
+#include "distributedsearch.h"
+#include "formulation.h"
+#include "nibacexception.h"
+#include "nodepath.h"
+#include "nodestack.h"
+#include "solutionmanager.h"
+#include "statistics.h"
+
+// Writing to a closed connection should fail rather than raise SIGPIPE.
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace vorpal::nibac {
+    bool DistributedSearch::Connection::receive() {
+        char buffer[4096];
+        for (;;) {
+            ssize_t size = recv(socket, buffer, sizeof(buffer), 0);
+            if (size > 0) {
+                input.append(buffer, size);
+                return true;
+            }
+            if (size < 0 && errno == EINTR)
+                continue;
+            return false;
+        }
+    }
+
+
+    bool DistributedSearch::Connection::extract(std::string &type, std::string &contents) {
+        std::string::size_type end = input.find('\n');
+        if (end == std::string::npos)
+            return false;
+        std::istringstream header(input.substr(0, end));
+        std::string::size_type size;
+        header >> type >> size;
+        if (input.size() < end + 1 + size)
+            return false;
+        contents = input.substr(end + 1, size);
+        input.erase(0, end + 1 + size);
+        return true;
+    }
+
+
+    bool DistributedSearch::Connection::waitFor(std::string &type, std::string &contents) {
+        while (!extract(type, contents))
+            if (!receive())
+                return false;
+        return true;
+    }
+
+
+    bool DistributedSearch::Connection::ready() const {
+        struct pollfd descriptor;
+        descriptor.fd = socket;
+        descriptor.events = POLLIN;
+        return ::poll(&descriptor, 1, 0) > 0;
+    }
+
+
+    void DistributedSearch::Connection::send(const char *type, const std::string &contents) {
+        std::ostringstream header;
+        header << type << ' ' << contents.size() << '\n';
+        std::string message = header.str() + contents;
+
+        // We ignore failures here: a connection that is closed is noticed when reading from it.
+        const char *data = message.data();
+        std::string::size_type remaining = message.size();
+        while (remaining > 0) {
+            ssize_t size = ::send(socket, data, remaining, MSG_NOSIGNAL);
+            if (size < 0) {
+                if (errno == EINTR)
+                    continue;
+                return;
+            }
+            data += size;
+            remaining -= size;
+        }
+    }
+
+
+    void DistributedSearch::Connection::close() {
+        if (socket != -1)
+            ::close(socket);
+        socket = -1;
+    }
+
+
+    DistributedSearch::DistributedSearch(BAC &pbac, const char *paddress)
+            : bac(pbac),
+              address(paddress),
+              finished(false) {
+    }
+
+
+    DistributedSearch::~DistributedSearch() {
+        coordinator.close();
+        bac.distributedSearch = 0;
+    }
+
+
+    int DistributedSearch::openSocket(bool listenFlag) {
+        int fd;
+
+        // An address containing a / is the path of a Unix socket.
+        if (strchr(address, '/')) {
+            struct sockaddr_un socketAddress;
+            memset(&socketAddress, 0, sizeof(socketAddress));
+            socketAddress.sun_family = AF_UNIX;
+            if (strlen(address) >= sizeof(socketAddress.sun_path))
+                throw NetworkException(address, "socket path is too long");
+            strcpy(socketAddress.sun_path, address);
+
+            if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+                throw NetworkException(address, strerror(errno));
+            if (listenFlag) {
+                unlink(address);
+                if (bind(fd, (struct sockaddr *) &socketAddress, sizeof(socketAddress)) < 0
+                    || listen(fd, SOMAXCONN) < 0) {
+                    ::close(fd);
+                    throw NetworkException(address, strerror(errno));
+                }
+            } else if (connect(fd, (struct sockaddr *) &socketAddress, sizeof(socketAddress)) < 0) {
+                ::close(fd);
+                throw NetworkException(address, strerror(errno));
+            }
+            return fd;
+        }
+
+        // Otherwise, it is of the form host:port.
+        const char *colon = strrchr(address, ':');
+        if (!colon)
+            throw NetworkException(address, "address must be of the form host:port or a socket path");
+        std::string host(address, colon - address);
+
+        struct addrinfo hints, *addresses;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        if (listenFlag)
+            hints.ai_flags = AI_PASSIVE;
+        int result = getaddrinfo(host.empty() ? nullptr : host.c_str(), colon + 1, &hints, &addresses);
+        if (result != 0)
+            throw NetworkException(address, gai_strerror(result));
+
+        fd = -1;
+        for (struct addrinfo *iter = addresses; iter && fd == -1; iter = iter->ai_next) {
+            if ((fd = socket(iter->ai_family, iter->ai_socktype, iter->ai_protocol)) < 0)
+                continue;
+            if (listenFlag) {
+                int reuse = 1;
+                setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+                if (bind(fd, iter->ai_addr, iter->ai_addrlen) == 0 && listen(fd, SOMAXCONN) == 0)
+                    continue;
+            } else if (connect(fd, iter->ai_addr, iter->ai_addrlen) == 0)
+                continue;
+            ::close(fd);
+            fd = -1;
+        }
+        freeaddrinfo(addresses);
+        if (fd == -1)
+            throw NetworkException(address, listenFlag ? "could not listen at address" : "could not connect to address");
+        return fd;
+    }
+
+
+    std::string DistributedSearch::describeProblem() {
+        std::ostringstream out;
+        out << bac.formulation.getNumberVariables() << ' ' << bac.formulation.getNumberBranchingVariables() << ' '
+            << bac.formulation.getSolutionType() << std::endl;
+        return out.str();
+    }
+
+
+    bool DistributedSearch::isBetter(int value, int other) {
+        return bac.formulation.getProblemType() == Formulation::MAXIMIZATION ? value > other : value < other;
+    }
+
+
+    void DistributedSearch::coordinate() {
+        // We explore nothing ourselves, but gather the statistics of the workers.
+        Statistics &statistics = bac.options.getStatistics();
+        statistics.setNumberCutProducers(bac.options.getCutProducers().size());
+
+        int listener = openSocket(true);
+        std::vector<Worker *> workers;
+        std::string type, contents;
+
+        // The subtrees left to explore, the next one last. We start with the root.
+        std::vector<NodePath> queue(1);
+        bool finishedFlag = false;
+
+        try {
+            for (;;) {
+                // The search is over once it is finished and all workers have sent their results.
+                bool doneFlag = finishedFlag;
+                for (std::vector<Worker *>::iterator iter = workers.begin();
+                     iter != workers.end();
+                     ++iter)
+                    if (!(*iter)->doneFlag)
+                        doneFlag = false;
+                if (doneFlag)
+                    break;
+
+                // Wait for a new worker, or for messages from those we have.
+                std::vector<struct pollfd> descriptors;
+                std::vector<Worker *> polledWorkers;
+                if (!finishedFlag) {
+                    struct pollfd descriptor;
+                    descriptor.fd = listener;
+                    descriptor.events = POLLIN;
+                    descriptors.push_back(descriptor);
+                }
+                for (std::vector<Worker *>::iterator iter = workers.begin();
+                     iter != workers.end();
+                     ++iter)
+                    if (!(*iter)->doneFlag) {
+                        struct pollfd descriptor;
+                        descriptor.fd = (*iter)->connection.socket;
+                        descriptor.events = POLLIN;
+                        descriptors.push_back(descriptor);
+                        polledWorkers.push_back(*iter);
+                    }
+                if (::poll(descriptors.data(), descriptors.size(), -1) < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    throw NetworkException(address, strerror(errno));
+                }
+
+                std::vector<struct pollfd>::size_type offset = 0;
+                if (!finishedFlag) {
+                    offset = 1;
+                    if (descriptors[0].revents) {
+                        int fd = accept(listener, nullptr, nullptr);
+                        if (fd >= 0) {
+                            Worker *worker = new Worker;
+                            worker->connection.socket = fd;
+                            worker->helloFlag = false;
+                            worker->busyFlag = false;
+                            worker->askedFlag = false;
+                            worker->doneFlag = false;
+                            workers.push_back(worker);
+                        }
+                    }
+                }
+
+                for (std::vector<Worker *>::size_type i = 0; i < polledWorkers.size(); ++i) {
+                    if (!descriptors[offset + i].revents)
+                        continue;
+                    Worker &worker = *(polledWorkers[i]);
+                    if (!worker.connection.receive()) {
+                        // A worker that closes its connection before saying hello has no part in
+                        // the search, but any other takes its subtrees with it.
+                        if (worker.helloFlag)
+                            throw NetworkException(address, "a worker disconnected before the search was over");
+                        worker.connection.close();
+                        worker.doneFlag = true;
+                        continue;
+                    }
+
+                    while (!worker.doneFlag && worker.connection.extract(type, contents)) {
+                        std::istringstream in(contents);
+                        if (type == "HELLO") {
+                            if (contents != describeProblem()) {
+                                worker.connection.send("REJECT");
+                                worker.connection.close();
+                                worker.doneFlag = true;
+                                continue;
+                            }
+                            worker.helloFlag = true;
+                            if (finishedFlag)
+                                worker.connection.send("DONE");
+                        } else if (type == "IDLE")
+                            worker.busyFlag = false;
+                        else if (type == "PATH") {
+                            queue.push_back(NodePath());
+                            if (!queue.back().read(in))
+                                throw NetworkException(address, "a worker sent an invalid subtree");
+                            worker.askedFlag = false;
+                        } else if (type == "NONE")
+                            worker.askedFlag = false;
+                        else if (type == "BOUND") {
+                            int value;
+                            in >> value;
+                            if (isBetter(value, bac.bestSolutionValue)) {
+                                bac.bestSolutionValue = value;
+                                for (std::vector<Worker *>::iterator iter = workers.begin();
+                                     iter != workers.end();
+                                     ++iter)
+                                    if (*iter != &worker && (*iter)->helloFlag && !(*iter)->doneFlag)
+                                        (*iter)->connection.send("BOUND", contents);
+                            }
+                        } else if (type == "FINISHED") {
+                            if (!finishedFlag) {
+                                finishedFlag = true;
+                                for (std::vector<Worker *>::iterator iter = workers.begin();
+                                     iter != workers.end();
+                                     ++iter)
+                                    if ((*iter)->helloFlag && !(*iter)->doneFlag)
+                                        (*iter)->connection.send("DONE");
+                            }
+                        } else if (type == "RESULT") {
+                            Statistics workerStatistics;
+                            workerStatistics.setNumberCutProducers(statistics.getNumberCuts().size());
+                            if (!workerStatistics.read(in))
+                                throw NetworkException(address, "a worker sent invalid statistics");
+                            statistics.merge(workerStatistics);
+                            bac.options.getSolutionManager()->readCheckpoint(in);
+                            worker.connection.close();
+                            worker.doneFlag = true;
+                        }
+                    }
+                }
+
+                if (finishedFlag)
+                    continue;
+
+                // Give the subtrees in the queue to idle workers.
+                int numberIdle = 0;
+                int numberAsked = 0;
+                for (std::vector<Worker *>::iterator iter = workers.begin();
+                     iter != workers.end();
+                     ++iter) {
+                    Worker &worker = **iter;
+                    if (!worker.helloFlag || worker.doneFlag)
+                        continue;
+                    if (!worker.busyFlag && !queue.empty()) {
+                        std::ostringstream out;
+                        out.precision(17);
+                        out << bac.bestSolutionValue << std::endl;
+                        queue.back().write(out);
+                        queue.pop_back();
+                        worker.connection.send("WORK", out.str());
+                        worker.busyFlag = true;
+                    }
+                    if (!worker.busyFlag)
+                        ++numberIdle;
+                    if (worker.askedFlag)
+                        ++numberAsked;
+                }
+
+                // If we are running low on subtrees, ask busy workers for more. If there are
+                // none to be had, the search is over.
+                for (std::vector<Worker *>::iterator iter = workers.begin();
+                     iter != workers.end() && (int) queue.size() + numberAsked < numberIdle;
+                     ++iter) {
+                    Worker &worker = **iter;
+                    if (worker.helloFlag && !worker.doneFlag && worker.busyFlag && !worker.askedFlag) {
+                        worker.connection.send("DONATE");
+                        worker.askedFlag = true;
+                        ++numberAsked;
+                    }
+                }
+
+                bool workingFlag = false;
+                for (std::vector<Worker *>::iterator iter = workers.begin();
+                     iter != workers.end();
+                     ++iter)
+                    if ((*iter)->helloFlag && !(*iter)->doneFlag && ((*iter)->busyFlag || (*iter)->askedFlag))
+                        workingFlag = true;
+                if (!workingFlag && queue.empty()) {
+                    finishedFlag = true;
+                    for (std::vector<Worker *>::iterator iter = workers.begin();
+                         iter != workers.end();
+                         ++iter)
+                        if ((*iter)->helloFlag && !(*iter)->doneFlag)
+                            (*iter)->connection.send("DONE");
+                }
+            }
+        } catch (...) {
+            for (std::vector<Worker *>::iterator iter = workers.begin();
+                 iter != workers.end();
+                 ++iter) {
+                (*iter)->connection.close();
+                delete *iter;
+            }
+            ::close(listener);
+            throw;
+        }
+
+        for (std::vector<Worker *>::iterator iter = workers.begin();
+             iter != workers.end();
+             ++iter) {
+            (*iter)->connection.close();
+            delete *iter;
+        }
+        ::close(listener);
+        if (strchr(address, '/'))
+            unlink(address);
+    }
+
+
+    void DistributedSearch::work() {
+        // Saying hello also asks for work.
+        coordinator.socket = openSocket(false);
+        coordinator.send("HELLO", describeProblem());
+
+        bac.distributedSearch = this;
+        bac.initialize();
+
+        std::string type, contents;
+        for (;;) {
+            // Wait until we are given work or the search is over.
+            for (;;) {
+                if (!coordinator.waitFor(type, contents))
+                    throw NetworkException(address, "the coordinator disconnected before the search was over");
+                if (type == "WORK" || !handle(type, contents))
+                    break;
+            }
+            if (finished)
+                break;
+
+            std::istringstream in(contents);
+            int value;
+            NodePath path;
+            if (!(in >> value) || !path.read(in))
+                throw NetworkException(address, "the coordinator sent an invalid subtree");
+            if (isBetter(value, bac.bestSolutionValue))
+                bac.bestSolutionValue = value;
+
+            // If the path cannot be replayed, there is nothing in the subtree to explore. If
+            // we finished early, the search is over for everyone.
+            if (bac.replay(path) && !bac.explore()) {
+                if (finished)
+                    break;
+                coordinator.send("FINISHED");
+                while (coordinator.waitFor(type, contents) && handle(type, contents));
+                break;
+            }
+
+            // Ask for more work.
+            coordinator.send("IDLE");
+        }
+
+        // Send our results.
+        std::ostringstream out;
+        out.precision(17);
+        bac.options.getStatistics().write(out);
+        bac.options.getSolutionManager()->writeCheckpoint(out);
+        coordinator.send("RESULT", out.str());
+        coordinator.close();
+    }
+
+
+    bool DistributedSearch::poll() {
+        // A closed connection is noticed once we wait for the coordinator.
+        std::string type, contents;
+        while (!finished) {
+            if (coordinator.extract(type, contents))
+                handle(type, contents);
+            else if (!coordinator.ready() || !coordinator.receive())
+                break;
+        }
+        return !finished;
+    }
+
+
+    bool DistributedSearch::handle(const std::string &type, const std::string &contents) {
+        if (type == "DONATE") {
+            NodePath path;
+            if (bac.nodeStack && bac.nodeStack->donate(path)) {
+                std::ostringstream out;
+                out.precision(17);
+                path.write(out);
+                coordinator.send("PATH", out.str());
+            } else
+                coordinator.send("NONE");
+        } else if (type == "BOUND") {
+            std::istringstream in(contents);
+            int value;
+            if (in >> value && isBetter(value, bac.bestSolutionValue))
+                bac.bestSolutionValue = value;
+        } else if (type == "DONE")
+            finished = true;
+        else if (type == "REJECT")
+            throw IllegalParameterException("BACOptions::CoordinatorAddress", address,
+                                            "the coordinator is solving a different problem");
+        return !finished;
+    }
+
+
+    void DistributedSearch::reportSolutionValue(int value) {
+        std::ostringstream out;
+        out << value << std::endl;
+        coordinator.send("BOUND", out.str());
+    }
+};
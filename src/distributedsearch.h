@@ -0,0 +1,148 @@
+/**
+ * distributedsearch.h
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+// A DistributedSearch explores the branch-and-cut tree of a BAC with several
+// processes, possibly on different machines: a coordinator, and any number of
+// workers that connect to it over a socket. Each worker is a process solving
+// the same problem, and runs a BAC that explores the subtrees handed to it
+// depth-first.
+//
+// The coordinator keeps a queue of subtrees as NodePaths, starting with the
+// root, and gives one to each idle worker, which replays it from its own root
+// (see BAC::replay). When the queue holds fewer subtrees than there are idle
+// workers, the coordinator asks busy workers for more; the next time such a
+// worker is between nodes, it gives away the shallowest open subtree on its
+// stack (see NodeStack::donate). The search is over when all workers are idle
+// and there is no work left, or when a worker finishes early.
+//
+// Whenever a worker improves upon the best solution value, it tells the
+// coordinator, which passes the value on to the other workers so that they can
+// prune against it. Solutions and statistics are kept by each worker, and sent
+// to the coordinator at the end of the search, which adds them to those of its
+// own options as it would the contents of a checkpoint.
+//
+// Addresses are of the form host:port for TCP, where an empty host means any
+// interface for the coordinator; an address containing a / is the path of a
+// Unix socket.
+//
+// Messages consist of a line holding a type and the size of the contents,
+// followed by the contents, which are written in the same textual form as a
+// checkpoint:
+// worker to coordinator:
+//   HELLO     the number of variables, branching variables and solution type;
+//             the worker is then waiting for work
+//   IDLE      the worker is done with the subtree it was last given
+//   PATH      a subtree given away at the request of the coordinator
+//   NONE      the worker has no subtree to give away
+//   BOUND     an improved best solution value
+//   FINISHED  the worker finished early, i.e. the search is over
+//   RESULT    the statistics and the state of the solution manager
+// coordinator to worker:
+//   WORK      the best solution value and a subtree to explore
+//   DONATE    a request for a subtree
+//   BOUND     an improved best solution value
+//   DONE      the search is over; the worker replies with its RESULT
+//   REJECT    the worker is solving a different problem
+//
+// A worker is given a subtree only when it is waiting for one, and says IDLE
+// once for each subtree that it is given, so the coordinator always knows
+// which workers are exploring a subtree. A worker that disconnects before the
+// search is over takes its solutions and the subtrees left on its stack with
+// it, so the search fails rather than give an incomplete result.
+
+#ifndef DISTRIBUTEDSEARCH_H
+#define DISTRIBUTEDSEARCH_H
+
+#include <string>
+#include <vector>
+#include "common.h"
+#include "bac.h"
+#include "nodepath.h"
+
+namespace vorpal::nibac {
+    class DistributedSearch final {
+    private:
+        // A connection over which messages are exchanged. Data received is kept until
+        // it makes up a complete message.
+        struct Connection {
+            int socket;
+            std::string input;
+
+            Connection() : socket(-1) {}
+
+            // Read whatever data is available, waiting for some if there is none.
+            // Returns false if the connection was closed.
+            bool receive();
+
+            // Take the next complete message from the data received, if there is one.
+            bool extract(std::string &, std::string &);
+
+            // Wait for the next complete message. Returns false if the connection was closed.
+            bool waitFor(std::string &, std::string &);
+
+            // Determine if there is data to be read without waiting for it.
+            bool ready() const;
+
+            void send(const char *, const std::string & = std::string());
+
+            void close();
+        };
+
+        // A worker, as seen by the coordinator.
+        struct Worker {
+            Connection connection;
+
+            // Whether the worker has said hello, whether it has work, whether it has been
+            // asked for a subtree and has not yet answered, and whether it has sent its
+            // results.
+            bool helloFlag;
+            bool busyFlag;
+            bool askedFlag;
+            bool doneFlag;
+        };
+
+        // The BAC that coordinates, or that works for a coordinator.
+        BAC &bac;
+
+        // The address at which we listen or to which we connect.
+        const char *address;
+
+        // For a worker: the connection to the coordinator, and whether the search is over.
+        Connection coordinator;
+        bool finished;
+
+    public:
+        DistributedSearch(BAC &, const char *);
+
+        virtual ~DistributedSearch();
+
+        // Coordinate the search until it is over, listening for workers at the address.
+        void coordinate();
+
+        // Work for the coordinator at the address until the search is over.
+        void work();
+
+        // Called by a worker between nodes: handle any messages from the coordinator, giving
+        // away part of the tree if asked to. Returns false if the search is over.
+        bool poll();
+
+        // Called by a worker when it improves upon the best solution value.
+        void reportSolutionValue(int);
+
+    private:
+        // Open a socket at an address, either listening on it or connected to it.
+        int openSocket(bool);
+
+        // The problem, as described in a HELLO message.
+        std::string describeProblem();
+
+        // Handle a message received by a worker. Returns false if the search is over.
+        bool handle(const std::string &, const std::string &);
+
+        // Whether a solution value is better than another.
+        bool isBetter(int, int);
+    };
+};
+#endif
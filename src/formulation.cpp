@@ -4,8 +4,10 @@
  * By Sebastian Raaphorst 2003 - 2018.
  */
 
+#include <limits.h>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include "common.h"
 #include "formulation.h"
 #include "column.h"
@@ -20,12 +22,43 @@ namespace vorpal::nibac {
             : problemType(pproblemType),
               solutionType(psolutionType),
               numberVariables(pnumberVariables),
+              objectiveLowerBound(INT_MIN),
+              objectiveUpperBound(INT_MAX),
+              lpSolver(LPSolver::createSolver()),
               nonBranchingIndex(pnonBranchingIndex) {
-        LPSolver::getInstance()->setupFormulation(*this);
+        lpSolver->setupFormulation(*this);
         columns.resize(numberVariables);
     }
 
 
+    Formulation::Formulation(Formulation &other)
+            : problemType(other.problemType),
+              solutionType(other.solutionType),
+              numberVariables(other.numberVariables),
+              objectiveLowerBound(INT_MIN),
+              objectiveUpperBound(INT_MAX),
+              lpSolver(LPSolver::createSolver()),
+              nonBranchingIndex(other.nonBranchingIndex) {
+        lpSolver->setupFormulation(*this);
+        columns.resize(numberVariables);
+
+        if (!other.objectiveFunction.empty())
+            setObjectiveFunction(other.objectiveFunction, other.objectiveLowerBound, other.objectiveUpperBound);
+
+        // The constraints are recreated in this formulation in the same order.
+        for (std::map<unsigned long, Constraint *>::iterator iter = other.constraints.begin();
+             iter != other.constraints.end();
+             ++iter) {
+            Constraint *constraint = (*iter).second;
+            addConstraint(Constraint::createConstraint(*this,
+                                                       constraint->getPositions(),
+                                                       constraint->getCoefficients(),
+                                                       constraint->getLowerBound(),
+                                                       constraint->getUpperBound()));
+        }
+    }
+
+
     Formulation::~Formulation() {
         // Delete any remaining constraints. This MUST be done
         // before the formulation is cleaned up, because constraints
@@ -35,20 +68,23 @@ namespace vorpal::nibac {
             iter = constraints.begin();
             Constraint *constraint = (*iter).second;
             constraints.erase(iter);
-            LPSolver::getInstance()->removeConstraint(*this, constraint);
+            lpSolver->removeConstraint(*this, constraint);
             delete constraint;
         }
 
         // We clean up the formulation last of all, freeing any
         // LP-solver specific data structures (model and data
-        // variables).
-        LPSolver::getInstance()->cleanupFormulation(*this);
+        // variables), and then the solver itself.
+        lpSolver->cleanupFormulation(*this);
+        delete lpSolver;
     }
 
 
     void Formulation::setObjectiveFunction(std::vector<int> &coefficients, int lowerBound, int upperBound) {
         objectiveFunction = coefficients;
-        LPSolver::getInstance()->setObjectiveFunction(*this, coefficients, lowerBound, upperBound);
+        objectiveLowerBound = lowerBound;
+        objectiveUpperBound = upperBound;
+        lpSolver->setObjectiveFunction(*this, coefficients, lowerBound, upperBound);
     }
 
 
@@ -57,7 +93,7 @@ namespace vorpal::nibac {
         constraints[constraint->getID()] = constraint;
 
         // ...and to our LP-solver model
-        LPSolver::getInstance()->addConstraint(*this, constraint);
+        lpSolver->addConstraint(*this, constraint);
 
         // Add the ID to the column information.
         std::vector<int> &positions = constraint->getPositions();
@@ -78,7 +114,7 @@ namespace vorpal::nibac {
         constraints.erase(constraint->getID());
 
         // ...and from our LP-solver model
-        LPSolver::getInstance()->removeConstraint(*this, constraint);
+        lpSolver->removeConstraint(*this, constraint);
 
         // ...and remove the ID from the relevant columns.
         std::vector<int> &positions = constraint->getPositions();
@@ -94,18 +130,74 @@ namespace vorpal::nibac {
     void Formulation::addCut(Constraint *cut) {
         // Add it to our list...
         cuts[cut->getID()] = cut;
+        cutSignatures.insert(std::make_pair(cut->getSignature(), cut));
 
         // ...and to our LP-solver model
-        LPSolver::getInstance()->addCut(*this, cut);
+        lpSolver->addCut(*this, cut);
     }
 
 
     void Formulation::removeCut(Constraint *cut) {
         // Remove it from our list...
         cuts.erase(cut->getID());
+        removeCutSignature(cut);
 
         // ...and from our LP-solver model
-        LPSolver::getInstance()->removeCut(*this, cut);
+        lpSolver->removeCut(*this, cut);
+    }
+
+
+    void Formulation::addCuts(std::vector<Constraint *> &pcuts) {
+        for (std::vector<Constraint *>::iterator iter = pcuts.begin();
+             iter != pcuts.end();
+             ++iter) {
+            cuts[(*iter)->getID()] = *iter;
+            cutSignatures.insert(std::make_pair((*iter)->getSignature(), *iter));
+        }
+        lpSolver->addCuts(*this, pcuts);
+    }
+
+
+    void Formulation::removeCuts(std::vector<Constraint *> &pcuts) {
+        for (std::vector<Constraint *>::iterator iter = pcuts.begin();
+             iter != pcuts.end();
+             ++iter) {
+            cuts.erase((*iter)->getID());
+            removeCutSignature(*iter);
+        }
+        lpSolver->removeCuts(*this, pcuts);
+    }
+
+
+    void Formulation::removeCutSignature(Constraint *cut) {
+        std::pair<std::unordered_multimap<unsigned long, Constraint *>::iterator,
+                std::unordered_multimap<unsigned long, Constraint *>::iterator> range
+                = cutSignatures.equal_range(cut->getSignature());
+        for (std::unordered_multimap<unsigned long, Constraint *>::iterator iter = range.first;
+             iter != range.second;
+             ++iter)
+            if ((*iter).second == cut) {
+                cutSignatures.erase(iter);
+                return;
+            }
+    }
+
+
+    bool Formulation::hasDuplicateCut(const Constraint &constraint) {
+        std::pair<std::unordered_multimap<unsigned long, Constraint *>::iterator,
+                std::unordered_multimap<unsigned long, Constraint *>::iterator> range
+                = cutSignatures.equal_range(constraint.getSignature());
+        for (std::unordered_multimap<unsigned long, Constraint *>::iterator iter = range.first;
+             iter != range.second;
+             ++iter)
+            if (constraint.isDuplicateOf(*((*iter).second)))
+                return true;
+        return false;
+    }
+
+
+    void Formulation::setObjectiveCutoff(int cutoff) {
+        lpSolver->setObjectiveCutoff(*this, cutoff);
     }
 
 
@@ -114,7 +206,7 @@ namespace vorpal::nibac {
         fixings[variable] = value;
 
         // ...and in the LP.
-        LPSolver::getInstance()->fixVariable(*this, variable, value);
+        lpSolver->fixVariable(*this, variable, value);
     }
 
 
@@ -123,7 +215,7 @@ namespace vorpal::nibac {
         fixings.erase(variable);
 
         // ...and from the LP.
-        LPSolver::getInstance()->unfixVariable(*this, variable);
+        lpSolver->unfixVariable(*this, variable);
     }
 
 
@@ -151,7 +243,7 @@ namespace vorpal::nibac {
 
 
     bool Formulation::exportModel(const char *filename) {
-        return LPSolver::getInstance()->exportModel(*this, filename);
+        return lpSolver->exportModel(*this, filename);
     }
 
 
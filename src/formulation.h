@@ -10,11 +10,15 @@
 #include <limits.h>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include "common.h"
 #include "column.h"
 #include "constraint.h"
 
 namespace vorpal::nibac {
+    // Forward declaration to avoid recursive includes.
+    class LPSolver;
+
     /**
      *  A formulation of an ILP independent of LP solver. We use a structure similar to CPLEX, where we assume a
      *  sparsely populated matrix and we maintain indices into the matrix to represent inequalities. Note that we
@@ -44,14 +48,19 @@ namespace vorpal::nibac {
         SolutionType solutionType;
         int numberVariables;
         std::vector<int> objectiveFunction;
+        int objectiveLowerBound;
+        int objectiveUpperBound;
         std::map<unsigned long, Constraint *> constraints;
         std::vector<Column> columns;
 
-        // Cuts and fixings.
+        // Cuts and fixings, and an index of the cuts by signature (see Constraint::getSignature).
         std::map<unsigned long, Constraint *> cuts;
+        std::unordered_multimap<unsigned long, Constraint *> cutSignatures;
         std::map<int, int> fixings;
 
-        // Some LP-solver specific data for the problem, if it should be needed.
+        // The LP solver for this formulation, and some LP-solver specific data for the
+        // problem, if it should be needed.
+        LPSolver *lpSolver;
         void *data;
 
         // A problem can have branching variables and non-branching variables;
@@ -72,6 +81,11 @@ namespace vorpal::nibac {
     public:
         Formulation(ProblemType, SolutionType, int, int= -1);
 
+        // Copy the model (objective function and constraints) of a formulation into a new one
+        // with its own LP solver, e.g. for a worker of a parallel search. Cuts and fixings
+        // are not copied, as they belong to the nodes that made them.
+        Formulation(Formulation &);
+
         virtual ~Formulation();
 
         // Retrieve the problem type and the solution type.
@@ -84,6 +98,10 @@ namespace vorpal::nibac {
 
         inline const std::vector<int> &getObjectiveFunction(void) { return objectiveFunction; }
 
+        // Tighten the bound on the objective function in the direction of optimization
+        // (see LPSolver::setObjectiveCutoff).
+        void setObjectiveCutoff(int);
+
         // Adding / removing a constraint
         void addConstraint(Constraint *);
 
@@ -98,8 +116,18 @@ namespace vorpal::nibac {
 
         void removeCut(Constraint *);
 
+        void addCuts(std::vector<Constraint *> &);
+
+        void removeCuts(std::vector<Constraint *> &);
+
         inline const std::map<unsigned long, Constraint *> &getCuts() { return cuts; }
 
+        // Determine whether there is a cut with the same positions, coefficients and bounds as
+        // the given constraint.
+        bool hasDuplicateCut(const Constraint &);
+
+        inline const std::map<int, int> &getFixings() { return fixings; }
+
         // Fixing variables. This is used to set constraints in the formulation with variables
         // fixed to certain values, and then to remove them.
         void fixVariable(int, int);
@@ -119,6 +147,8 @@ namespace vorpal::nibac {
 
         virtual int getMatrixCoefficient(int, int);
 
+        inline LPSolver *getLPSolver() const { return lpSolver; }
+
         // Methods to alter the model and data
         inline void setData(void *pdata) { data = pdata; }
 
@@ -147,6 +177,9 @@ namespace vorpal::nibac {
         // Method used to sort a vector of variable indices and maintain a corresponding
         // array of variable coefficients.
         void quicksort(std::vector<int> &, std::vector<int> &, int, int) const;
+
+        // Remove a cut from the index of the cuts by signature.
+        void removeCutSignature(Constraint *);
     };
 };
 
@@ -5,277 +5,464 @@
  */
 
 #include <assert.h>
-extern "C" {
-#include <glpk.h>
-}
 #include <float.h>
+#include <glpk.h>
+#include <limits.h>
+#include <algorithm>
+#include <sstream>
+#include <utility>
+#include <vector>
+#include "common.h"
 #include "bac.h"
+#include "bacoptions.h"
+#include "constraint.h"
 #include "formulation.h"
 #include "nibacexception.h"
 #include "node.h"
-#include "common.h"
 #include "glpksolver.h"
 
+namespace vorpal::nibac {
+    LPSolver *GLPKSolver::makeInstance() {
+        // All of the state for a formulation is kept in its data, so there is
+        // nothing to share between instances.
+        return new GLPKSolver();
+    }
+
+
+    void GLPKSolver::setupFormulation(Formulation &f) {
+        // Create a new LP.
+        GLPKInfo *info = new GLPKInfo;
+        glp_prob *lp = glp_create_prob();
+        if (!lp)
+            throw OutOfMemoryException();
+
+        // Configure the simplex method: the dual simplex method, falling back to the primal
+        // simplex method if it fails, and no presolving, so that the basis is kept between
+        // solves. The limits are set for each solve from the options.
+        glp_init_smcp(&(info->smcp));
+        info->smcp.msg_lev = GLP_MSG_ERR;
+        info->smcp.meth = GLP_DUALP;
+        info->smcp.presolve = GLP_OFF;
+
+        // Configure the branch-and-bound, which starts from the optimal basis of the LP.
+        glp_init_iocp(&(info->iocp));
+        info->iocp.msg_lev = GLP_MSG_ERR;
+        info->iocp.presolve = GLP_OFF;
+        info->iocp.tol_int = EPSILON;
+        info->iocp.cb_func = cutoffCallback;
+        info->iocp.cb_info = info;
+
+        info->maximizationFlag = false;
+        info->objectiveLowerBound = -DBL_MAX;
+        info->objectiveUpperBound = DBL_MAX;
+
+        // Add the columns and their bounds.
+        int offset = glp_add_cols(lp, f.getNumberVariables());
+        for (int i = 0; i < f.getNumberVariables(); ++i) {
+            glp_set_col_kind(lp, i + offset, GLP_IV);
+            std::ostringstream stream;
+            stream << "vx_" << i + offset;
+            glp_set_col_name(lp, i + offset, stream.str().c_str());
+            glp_set_col_bnds(lp, i + offset, GLP_DB, 0.0, 1.0);
+        }
+        info->lp = lp;
+        info->offset = offset;
+        f.setData((void *) info);
+    }
+
+
+    void GLPKSolver::cleanupFormulation(Formulation &f) {
+        // Get the structure.
+        GLPKInfo *info = (GLPKInfo *) f.getData();
+        glp_delete_prob(info->lp);
+        delete info;
+        f.setData((void *) 0);
+    }
+
+
+    void GLPKSolver::addConstraint(Formulation &f, Constraint *c) {
+        GLPKInfo *info = (GLPKInfo *) f.getData();
+        std::vector<Constraint *> constraints(1, c);
+        addRows(info, constraints);
+    }
+
+
+    void GLPKSolver::addRows(GLPKInfo *info, std::vector<Constraint *> &constraints) {
+        if (constraints.empty())
+            return;
+
+        // Create the rows for all of the constraints at once. The rows are not
+        // named, as they are found through the constraints.
+        int rowoffset = glp_add_rows(info->lp, constraints.size());
+        assert(rowoffset == (int) info->rows.size() + 1);
+
+        for (std::vector<Constraint *>::iterator iter = constraints.begin();
+             iter != constraints.end();
+             ++iter, ++rowoffset) {
+            Constraint *c = *iter;
+            info->rows.push_back(c);
+            c->setImplementation((void *) (long) rowoffset);
+
+            // Add the necessary coefficients and bounds, using the scratch arrays,
+            // which are indexed from 1. A bound of INT_MIN or INT_MAX is no bound.
+            int type;
+            if (c->getLowerBound() == INT_MIN)
+                type = (c->getUpperBound() == INT_MAX ? GLP_FR : GLP_UP);
+            else if (c->getUpperBound() == INT_MAX)
+                type = GLP_LO;
+            else
+                type = (c->getLowerBound() == c->getUpperBound() ? GLP_FX : GLP_DB);
+            glp_set_row_bnds(info->lp, rowoffset, type, c->getLowerBound(), c->getUpperBound());
+            std::vector<int> &positions = c->getPositions();
+            std::vector<int> &coefficients = c->getCoefficients();
+            assert(positions.size() == coefficients.size());
+            info->ind.resize(positions.size() + 1);
+            info->val.resize(coefficients.size() + 1);
+
+            int i = 1;
+            for (std::vector<int>::iterator piter = positions.begin();
+                 piter != positions.end();
+                 ++piter)
+                info->ind[i++] = *piter + info->offset;
+            i = 1;
+            for (std::vector<int>::iterator citer = coefficients.begin();
+                 citer != coefficients.end();
+                 ++citer)
+                info->val[i++] = (double) *citer;
+            glp_set_mat_row(info->lp, rowoffset, positions.size(), &(info->ind[0]), &(info->val[0]));
+        }
+    }
+
+
+    void GLPKSolver::removeConstraint(Formulation &f, Constraint *c) {
+        GLPKInfo *info = (GLPKInfo *) f.getData();
+        std::vector<Constraint *> constraints(1, c);
+        deleteRows(info, constraints);
+    }
+
+
+    void GLPKSolver::addCut(Formulation &f, Constraint *c) {
+        addConstraint(f, c);
+    }
+
 
-void GLPKSolver::setupFormulation(Formulation &f)
-{
-  // Create a new LP.
-  LPXInfo *info = new LPXInfo;
-  LPX *lp = lpx_create_prob();
-  if (!lp)
-    throw new OutOfMemoryException();
-
-  // Configure it.
-  lpx_set_int_parm(lp, LPX_K_MSGLEV, 1);
-  lpx_set_int_parm(lp, LPX_K_DUAL, 1);
-  lpx_set_real_parm(lp, LPX_K_TOLINT, EPSILON);
-  //  lpx_set_int_param(lp, LPX_K_PRESOL, 1);
-
-  // Make it a MIP.
-  lpx_set_class(lp, LPX_MIP);
-
-  // Add the columns and their bounds.
-  int offset = lpx_add_cols(lp, f.getNumberVariables());
-  for (int i=0; i < f.getNumberVariables(); ++i) {
-    lpx_set_col_kind(lp, i+offset, LPX_IV);
-    std::ostringstream stream;
-    stream << "vx_" << i+offset;
-    lpx_set_col_name(lp, i+offset, const_cast< char* >(stream.str().c_str()));
-    lpx_set_col_bnds(lp, i+offset, LPX_DB, 0.0, 1.0);
-  }
-  info->lp = lp;
-  info->offset = offset;
-  f.setData((void*)info);
-}
-
-
-void GLPKSolver::cleanupFormulation(Formulation &f)
-{
-  // Get the structure.
-  LPXInfo *info = (LPXInfo*) f.getData();
-  lpx_delete_prob(info->lp);
-  delete info;
-  f.setData((void*)0);
-}
-
-
-void GLPKSolver::addConstraint(Formulation &f, Constraint *c)
-{
-  LPXInfo *info = (LPXInfo*) f.getData();
-
-  // Now create a row for the constraint and name it.
-  int rowoffset = lpx_add_rows(info->lp, 1);
-  std::ostringstream stream;
-  stream << rowoffset;
-  lpx_set_row_name(info->lp, rowoffset, const_cast< char* >(stream.str().c_str()));
-  c->setImplementation((void*)rowoffset);
-
-  // Add the necessary coefficients and bounds.
-  lpx_set_row_bnds(info->lp, rowoffset,
-		   (c->getLowerBound() == c->getUpperBound() ? LPX_FX : LPX_DB),
-		   c->getLowerBound(), c->getUpperBound());
-  std::vector< int > &positions = c->getPositions();
-  std::vector< int > &coefficients = c->getCoefficients();
-  assert(positions.size() == coefficients.size());
-  int *ind = new int[positions.size()+1];
-  double *val = new double[coefficients.size()+1];
-
-  int i=1;
-  for (std::vector< int >::iterator iter = positions.begin();
-       iter != positions.end();
-       ++iter)
-    ind[i++] = *iter + info->offset;
-  i=1;
-  for (std::vector< int >::iterator iter = coefficients.begin();
-       iter != coefficients.end();
-       ++iter)
-    val[i++] = (double) *iter;
-  lpx_set_mat_row(info->lp, rowoffset, positions.size(), ind, val);
-}
-
-
-void GLPKSolver::removeConstraint(Formulation &f, Constraint *c)
-{
-  LPXInfo *info = (LPXInfo*) f.getData();
-
-  // Now create a row for the constraint and name it.
-  std::ostringstream stream;
-  stream << ((long)(c->getImplementation()));
-  
-  int num[2];
-  int bound = lpx_get_num_rows(info->lp);
-  for (int i=1; i <= bound; ++i) {
-    const char *name = lpx_get_row_name(info->lp, i);
-    if (name && strcmp(stream.str().c_str(), name) == 0) {
-      num[1] = i;
-      lpx_del_rows(info->lp, 1, num);
-      break;
+    void GLPKSolver::removeCut(Formulation &f, Constraint *c) {
+        removeConstraint(f, c);
     }
-  }
-
-  c->setImplementation((void*)0);
-}
-
-
-void GLPKSolver::addCut(Formulation &f, Constraint *c)
-{
-  addConstraint(f, c);
-}
-
-
-void GLPKSolver::removeCut(Formulation &f, Constraint *c)
-{
-  removeConstraint(f, c);
-}
-
-
-void GLPKSolver::fixVariable(Formulation &f, int var, int val)
-{
-  LPXInfo *info = (LPXInfo*) f.getData();
-  lpx_set_col_bnds(info->lp, var+info->offset, LPX_FX,
-		   val, val);
-}
-
-
-void GLPKSolver::unfixVariable(Formulation &f, int var)
-{
-  LPXInfo *info = (LPXInfo*) f.getData();
-  lpx_set_col_bnds(info->lp, var+info->offset, LPX_DB,
-		   0.0, 1.0);
-}
-
-
-void GLPKSolver::setObjectiveFunction(Formulation &f,
-				      std::vector< int > &objectivecoefficients,
-				      int lbound, int ubound)
-{
-  LPXInfo *info = (LPXInfo*) f.getData();
-  lpx_set_obj_dir(info->lp,
-		  f.getProblemType() == Formulation::MINIMIZATION ?
-		  LPX_MIN : LPX_MAX);
-
-  // Keep track of the number of nonzero entries so that we can add a constraint
-  // representing the bounds on the objective function.
-  int count=0;
-  int i=0;
-  for (std::vector< int >::iterator iter = objectivecoefficients.begin();
-       iter != objectivecoefficients.end();
-       ++iter) {
-    if (*iter)
-      ++count;
-    lpx_set_obj_coef(info->lp, i+info->offset, (double)(*iter));
-    ++i;
-  }
-
-  // Constrain the objective function.
-  lpx_set_real_parm(info->lp, LPX_K_OBJLL, lbound-EPSILON);
-  lpx_set_real_parm(info->lp, LPX_K_OBJUL, ubound+EPSILON);
-  return;
-  // Now we create a constraint for the objective function to bound it.
-  int *ind = new int[count+1];
-  double *val = new double[count+1];
-  i=1;
-  int j=0;
-  for (std::vector< int >::iterator iter = objectivecoefficients.begin();
-       iter != objectivecoefficients.end();
-       ++iter) {
-    if (*iter) {
-      ind[i] = j+info->offset;
-      val[i] = *iter;
-      ++i;
+
+
+    void GLPKSolver::addCuts(Formulation &f, std::vector<Constraint *> &cuts) {
+        GLPKInfo *info = (GLPKInfo *) f.getData();
+        addRows(info, cuts);
+    }
+
+
+    void GLPKSolver::removeCuts(Formulation &f, std::vector<Constraint *> &cuts) {
+        GLPKInfo *info = (GLPKInfo *) f.getData();
+        deleteRows(info, cuts);
+    }
+
+
+    void GLPKSolver::deleteRows(GLPKInfo *info, std::vector<Constraint *> &constraints) {
+        if (constraints.empty())
+            return;
+
+        // Mark the rows to be deleted, and delete them all at once.
+        int *num = new int[constraints.size() + 1];
+        int count = 0;
+        for (std::vector<Constraint *>::iterator iter = constraints.begin();
+             iter != constraints.end();
+             ++iter) {
+            int row = (int) (long) ((*iter)->getImplementation());
+            assert(row >= 1 && row <= (int) info->rows.size() && info->rows[row - 1] == *iter);
+            num[++count] = row;
+            info->rows[row - 1] = 0;
+            (*iter)->setImplementation((void *) 0);
+        }
+        glp_del_rows(info->lp, count, num);
+        delete[] num;
+
+        // The remaining rows keep their order, and move up to fill the gaps.
+        int row = 0;
+        for (std::vector<Constraint *>::iterator iter = info->rows.begin();
+             iter != info->rows.end();
+             ++iter)
+            if (*iter) {
+                info->rows[row++] = *iter;
+                (*iter)->setImplementation((void *) (long) row);
+            }
+        info->rows.resize(row);
+    }
+
+
+    void GLPKSolver::fixVariable(Formulation &f, int var, int val) {
+        GLPKInfo *info = (GLPKInfo *) f.getData();
+        glp_set_col_bnds(info->lp, var + info->offset, GLP_FX, val, val);
+    }
+
+
+    void GLPKSolver::unfixVariable(Formulation &f, int var) {
+        GLPKInfo *info = (GLPKInfo *) f.getData();
+        glp_set_col_bnds(info->lp, var + info->offset, GLP_DB, 0.0, 1.0);
     }
-    ++j;
-  }
-
-  int rowoffset = lpx_add_rows(info->lp, 1);
-  lpx_set_row_bnds(info->lp, rowoffset, (lbound == ubound ? LPX_FX : LPX_DB),
-		   (double)lbound, (double)ubound);
-  lpx_set_mat_row(info->lp, rowoffset, count, ind, val);;
-  lpx_set_row_name(info->lp, rowoffset, "obj");
-}
-
-
-int GLPKSolver::solveNode(BAC &bac, Node &n, bool fullsolve)
-{
-  Formulation &f = bac.getFormulation();
-  LPXInfo *info = (LPXInfo*) f.getData();
-  int status;
-
-  // As, even for integer methods we require an LP solution to
-  // have been calculated, we simply start by solving the LP using
-  // the simplex method.
-  lpx_adv_basis(info->lp);
-  status = lpx_simplex(info->lp);
-  if (status != LPX_E_OK)
-    return -1;
-  
-  // Make sure that a feasible solution was found.
-  status = lpx_get_status(info->lp);
-  if (status == LPX_UNDEF || status == LPX_INFEAS
-      || status == LPX_NOFEAS || status == LPX_UNBND)
-    return -1;
-
-  if (fullsolve) {
-    // Solve the problem using MIP.
-    status = lpx_integer(info->lp);
-    if (status != LPX_E_OK)
-      return -1;
-
-    // Make sure that a feasible solution was found.
-    status = lpx_mip_status(info->lp);
-    if (status == LPX_I_UNDEF || status == LPX_I_NOFEAS)
-      return -1;
-
-    // Copy it to the node.
-    n.setSolutionValue(lpx_mip_obj_val(info->lp));
-    double *solvars = n.getSolutionVariableArray();
-    for (int i=0; i < n.getNumberBranchingVariables(); ++i)
-      solvars[i] = lpx_mip_col_val(info->lp, i+info->offset);
-  }
-  else {
-    // Copy the LP solution to the node.
-    n.setSolutionValue(lpx_get_obj_val(info->lp));
-    double *solvars = n.getSolutionVariableArray();
-    for (int i=0; i < n.getNumberBranchingVariables(); ++i)
-      solvars[i] = lpx_get_col_prim(info->lp, i+info->offset);
-  }    
-
-  // I don't think there's a way to get the number of nodes visited by
-  // GLPK, so we just return 1.
-  return 1;
-}
-
-
-void *GLPKSolver::createConstraint(Formulation&, std::vector< int >&,
-				   std::vector< int >&, int, int)
-{
-  // This method need not do anything. Everything will be handled
-  // when the constraint is added.
-  return (void*)0;
-}
-
-
-void GLPKSolver::deleteConstraint(void*)
-{
-}
-
-
-bool GLPKSolver::exportModel(Formulation &f, const char *filename)
-{
-  LPXInfo *info = (LPXInfo*) f.getData();
-  int status = lpx_write_cpxlp(info->lp, const_cast<char*>(filename));
-  return (status == 0);
-}
 
 
+    void GLPKSolver::setObjectiveFunction(Formulation &f, std::vector<int> &objectivecoefficients,
+                                          int lbound, int ubound) {
+        GLPKInfo *info = (GLPKInfo *) f.getData();
+        info->maximizationFlag = (f.getProblemType() == Formulation::MAXIMIZATION);
+        glp_set_obj_dir(info->lp, info->maximizationFlag ? GLP_MAX : GLP_MIN);
+
+        int i = 0;
+        for (std::vector<int>::iterator iter = objectivecoefficients.begin();
+             iter != objectivecoefficients.end();
+             ++iter, ++i)
+            glp_set_obj_coef(info->lp, i + info->offset, (double) (*iter));
+
+        // Constrain the objective function. The dual simplex method stops as soon as the
+        // objective passes the bound in the direction of optimization, as it can only
+        // become worse from there, and the branch-and-bound as soon as no subproblem left
+        // can meet the bounds.
+        info->objectiveLowerBound = (lbound == INT_MIN ? -DBL_MAX : lbound - EPSILON);
+        info->objectiveUpperBound = (ubound == INT_MAX ? DBL_MAX : ubound + EPSILON);
+        info->smcp.obj_ll = info->objectiveLowerBound;
+        info->smcp.obj_ul = info->objectiveUpperBound;
+    }
+
+
+    void GLPKSolver::setObjectiveCutoff(Formulation &f, int cutoff) {
+        // Both the dual simplex method and the branch-and-bound (see cutoffCallback) use the
+        // bounds on the objective function, so tightening them suffices.
+        GLPKInfo *info = (GLPKInfo *) f.getData();
+        if (info->maximizationFlag) {
+            if (cutoff - EPSILON > info->objectiveLowerBound) {
+                info->objectiveLowerBound = cutoff - EPSILON;
+                info->smcp.obj_ll = info->objectiveLowerBound;
+            }
+        } else if (cutoff + EPSILON < info->objectiveUpperBound) {
+            info->objectiveUpperBound = cutoff + EPSILON;
+            info->smcp.obj_ul = info->objectiveUpperBound;
+        }
+    }
+
+
+    int GLPKSolver::solveNode(BAC &bac, Node &n, bool fullsolve) {
+        Formulation &f = bac.getFormulation();
+        GLPKInfo *info = (GLPKInfo *) f.getData();
+        BACOptions &options = bac.getOptions();
+        int status;
+
+        info->smcp.it_lim = (options.getLPIterationLimit() > 0 ? options.getLPIterationLimit() : INT_MAX);
+        info->smcp.tm_lim = (options.getLPTimeLimit() > 0 ? options.getLPTimeLimit() : INT_MAX);
+
+        // As, even for integer methods we require an LP solution to
+        // have been calculated, we simply start by solving the LP using
+        // the simplex method. For the first LP at a node, we start from
+        // the basis of its closest ancestor, which differs from an optimal
+        // one only by the fixings and cuts made since, so that the dual
+        // simplex method needs few iterations. For further LPs at the node,
+        // we start from the basis of the last one, where the new cuts are
+        // basic. Only if neither gives us a valid basis do we construct one.
+        const Node::Basis *basis = n.getAncestorBasis();
+        bool warmFlag;
+        if (n.getNumberLPsSolved() == 0)
+            warmFlag = (basis && installBasis(info, *basis));
+        else
+            warmFlag = isValidBasis(info);
+        if (!warmFlag)
+            glp_adv_basis(info->lp, 0);
+        status = glp_simplex(info->lp, &(info->smcp));
+        if (warmFlag && (status == GLP_EBADB || status == GLP_ESING || status == GLP_ECOND)) {
+            // The basis may be singular or ill-conditioned, in which case we start over.
+            glp_adv_basis(info->lp, 0);
+            status = glp_simplex(info->lp, &(info->smcp));
+        }
+
+        // If we ran out of iterations or time, the node must still be explored.
+        if (status == GLP_EITLIM || status == GLP_ETMLIM) {
 #ifdef DEBUG
-void GLPKSolver::printVariables(Formulation&)
-{
-}
+            std::cerr << "GLPK reached the LP " << (status == GLP_EITLIM ? "iteration" : "time")
+                      << " limit at depth " << n.getDepth() << "." << std::endl;
+#endif
+            saveBasis(info, n.getBasis());
+            setUnsolved(info, n);
+            return 0;
+        }
+
+        // Otherwise, if the objective passed its bounds, or the LP could not be solved,
+        // there is nothing to be found here.
+        if (status != 0)
+            return -1;
+
+        // Make sure that an optimal solution was found.
+        status = glp_get_status(info->lp);
+        if (status != GLP_OPT)
+            return -1;
+
+        // Keep the basis for the descendants of the node.
+        saveBasis(info, n.getBasis());
+
+        if (fullsolve) {
+            // Solve the problem using branch-and-bound, which starts from the optimal basis
+            // that we have just found.
+            status = glp_intopt(info->lp, &(info->iocp));
+            if (status != 0 && status != GLP_ESTOP)
+                return -1;
+
+            // Make sure that a feasible solution was found. If the search was stopped, the
+            // solution found may still meet the bounds.
+            status = glp_mip_status(info->lp);
+            if (status != GLP_OPT && status != GLP_FEAS)
+                return -1;
+            double value = glp_mip_obj_val(info->lp);
+            if (value < info->objectiveLowerBound || value > info->objectiveUpperBound)
+                return -1;
+
+            // Copy it to the node.
+            n.setSolutionValue(value);
+            double *solvars = n.getSolutionVariableArray();
+            for (int i = 0; i < n.getNumberBranchingVariables(); ++i)
+                solvars[i] = glp_mip_col_val(info->lp, i + info->offset);
+        } else {
+            // Copy the LP solution, and its reduced costs, to the node.
+            n.setSolutionValue(glp_get_obj_val(info->lp));
+            double *solvars = n.getSolutionVariableArray();
+            double *reducedCosts = n.getReducedCostArray();
+            for (int i = 0; i < n.getNumberBranchingVariables(); ++i) {
+                solvars[i] = glp_get_col_prim(info->lp, i + info->offset);
+                reducedCosts[i] = glp_get_col_dual(info->lp, i + info->offset);
+            }
+            n.setReducedCostsFlag(true);
+        }
+
+        // GLPK does not report the number of nodes that branch-and-bound
+        // visited, so like an LP, we report no subnodes.
+        return 0;
+    }
+
+
+    void GLPKSolver::setUnsolved(GLPKInfo *info, Node &n) {
+        // The objective value of a dual feasible basis bounds that of the LP, as the dual
+        // simplex method only makes it worse. Otherwise, we only have the bounds given, which
+        // are infinite if there are none, and BAC rounds the value to an int, so we keep it in
+        // the range of an int.
+        if (glp_get_dual_stat(info->lp) == GLP_FEAS)
+            n.setSolutionValue(glp_get_obj_val(info->lp));
+        else if (info->maximizationFlag)
+            n.setSolutionValue(std::min(info->objectiveUpperBound, (double) INT_MAX));
+        else
+            n.setSolutionValue(std::max(info->objectiveLowerBound, (double) INT_MIN));
+
+        short int *partialSolutionArray = n.getPartialSolutionArray();
+        double *solvars = n.getSolutionVariableArray();
+        for (int i = 0; i < n.getNumberBranchingVariables(); ++i)
+            solvars[i] = (partialSolutionArray[i] == -1 ? 0.5 : partialSolutionArray[i]);
+    }
+
+
+    void GLPKSolver::cutoffCallback(glp_tree *tree, void *data) {
+        if (glp_ios_reason(tree) != GLP_ISELECT)
+            return;
+
+        // The best subproblem left bounds all of the others.
+        GLPKInfo *info = (GLPKInfo *) data;
+        int best = glp_ios_best_node(tree);
+        if (best == 0)
+            return;
+        double bound = glp_ios_node_bound(tree, best);
+        if (info->maximizationFlag ? bound < info->objectiveLowerBound : bound > info->objectiveUpperBound)
+            glp_ios_terminate(tree);
+    }
+
+
+    bool GLPKSolver::isValidBasis(GLPKInfo *info) {
+        // A basis is valid if it has as many basic variables as there are rows.
+        int rows = glp_get_num_rows(info->lp);
+        int cols = glp_get_num_cols(info->lp);
+        int count = 0;
+        for (int i = 1; i <= rows; ++i)
+            if (glp_get_row_stat(info->lp, i) == GLP_BS)
+                ++count;
+        for (int i = 1; i <= cols; ++i)
+            if (glp_get_col_stat(info->lp, i) == GLP_BS)
+                ++count;
+        return (count == rows);
+    }
+
+
+    void GLPKSolver::saveBasis(GLPKInfo *info, Node::Basis &basis) {
+        int rows = glp_get_num_rows(info->lp);
+        int cols = glp_get_num_cols(info->lp);
+
+        basis.columnStatuses.resize(cols);
+        for (int i = 1; i <= cols; ++i)
+            basis.columnStatuses[i - 1] = (unsigned char) glp_get_col_stat(info->lp, i);
+
+        // Rows are recorded by the IDs of their constraints, sorted so that they
+        // can be looked up when installing the basis. Most rows are basic, and
+        // only the others are recorded.
+        basis.rowStatuses.clear();
+        for (int i = 1; i <= rows; ++i) {
+            int stat = glp_get_row_stat(info->lp, i);
+            if (stat != GLP_BS)
+                basis.rowStatuses.push_back(std::make_pair(info->rows[i - 1]->getID(), (unsigned char) stat));
+        }
+        std::sort(basis.rowStatuses.begin(), basis.rowStatuses.end());
+    }
+
+
+    bool GLPKSolver::installBasis(GLPKInfo *info, const Node::Basis &basis) {
+        int rows = glp_get_num_rows(info->lp);
+        int cols = glp_get_num_cols(info->lp);
+        if ((int) basis.columnStatuses.size() != cols)
+            return false;
+
+        // GLPK adjusts the status of a nonbasic variable to its bounds, so the
+        // variables fixed or freed since the basis was saved need no special care.
+        // Rows for constraints that did not exist then are made basic.
+        for (int i = 1; i <= cols; ++i)
+            glp_set_col_stat(info->lp, i, basis.columnStatuses[i - 1]);
+        for (int i = 1; i <= rows; ++i) {
+            int stat = GLP_BS;
+            std::pair<unsigned long, unsigned char> key(info->rows[i - 1]->getID(), 0);
+            std::vector<std::pair<unsigned long, unsigned char> >::const_iterator iter
+                    = std::lower_bound(basis.rowStatuses.begin(), basis.rowStatuses.end(), key);
+            if (iter != basis.rowStatuses.end() && (*iter).first == key.first)
+                stat = (*iter).second;
+            glp_set_row_stat(info->lp, i, stat);
+        }
+
+        // Rows deleted since may have been nonbasic, leaving too few basic variables.
+        return isValidBasis(info);
+    }
+
+
+    void *GLPKSolver::createConstraint(Formulation &, std::vector<int> &, std::vector<int> &, int, int) {
+        // This method need not do anything. Everything will be handled
+        // when the constraint is added.
+        return (void *) 0;
+    }
+
+
+    void GLPKSolver::deleteConstraint(void *) {
+    }
+
+
+    bool GLPKSolver::exportModel(Formulation &f, const char *filename) {
+        GLPKInfo *info = (GLPKInfo *) f.getData();
+        int status = glp_write_lp(info->lp, 0, filename);
+        return (status == 0);
+    }
+
+
+#ifdef DEBUG
+    void GLPKSolver::printVariables(Formulation&) {
+    }
 #endif
 
 
-// Create a static instance of GLPKSolver; this will be assigned as the static
-// instance in LPSolve and made accessible. Simply link this solver in with
-// end-user code to obtain a program that uses GLPK.
-GLPKSolver GLPKSolver::_glpksolver;
+    // Create a static instance of GLPKSolver; this will be assigned as the static
+    // instance in LPSolver and used to create the solvers for formulations. Simply
+    // link this solver in with end-user code to obtain a program that uses GLPK.
+    GLPKSolver GLPKSolver::_glpksolver;
+};
@@ -7,14 +7,12 @@
 #ifndef GLPKSOLVER_H
 #define GLPKSOLVER_H
 
-#include <limits.h>
-
-extern "C" {
 #include <glpk.h>
-}
-
+#include <limits.h>
 #include <vector>
+#include "common.h"
 #include "lpsolver.h"
+#include "node.h"
 
 namespace vorpal::nibac {
     // Class forwards
@@ -24,29 +22,81 @@ namespace vorpal::nibac {
     class Node;
 
     /**
-     * An interface between the generic BAC framework and the free GLPK. This is a concrete implementation of LPSolver.
+     * An interface between the generic BAC framework and the free GLPK, using its glp_* API. This is a concrete
+     * implementation of LPSolver.
+     *
+     * LPs are solved by the dual simplex method, which suits the re-solves of the branch-and-cut: a fixing or a cut
+     * leaves the basis of the last LP dual feasible (see Node::Basis). Presolving is disabled, as it would discard
+     * the basis. Nodes that are to be fully solved are solved by GLPK's branch-and-bound, which is stopped as soon
+     * as no subproblem left can meet the bounds on the objective function.
+     *
+     * Every LP is solved in full: the variables fixed and the rows made redundant by the fixings at a node are not
+     * left out of it, so the flag to do so (BACOptions::reduceLP, -G) is ignored.
      */
     class GLPKSolver final : public LPSolver {
     private:
         static GLPKSolver _glpksolver;
 
         // Data structure to populate the Formulation::data field.
-        struct LPXInfo {
-            LPX *lp;
+        // The constraint of each row is kept, by row index, so that rows can be renumbered
+        // as rows before them are deleted; each constraint holds the index of its row as its
+        // implementation, so that its row is found immediately. The index and value arrays
+        // are scratch space for setting the coefficients of rows, kept to avoid allocating
+        // them for every row. The bounds on the objective function are those given to
+        // setObjectiveFunction.
+        struct GLPKInfo {
+            glp_prob *lp;
             int offset;
+            std::vector<Constraint *> rows;
+            std::vector<int> ind;
+            std::vector<double> val;
+            glp_smcp smcp;
+            glp_iocp iocp;
+            bool maximizationFlag;
+            double objectiveLowerBound;
+            double objectiveUpperBound;
         };
 
+        // Add rows for several constraints in one call.
+        void addRows(GLPKInfo *, std::vector<Constraint *> &);
+
+        // Delete the rows of several constraints in one call, and renumber the rows after them.
+        void deleteRows(GLPKInfo *, std::vector<Constraint *> &);
+
+        // Determine if the current basis has as many basic variables as there are rows.
+        bool isValidBasis(GLPKInfo *);
+
+        // Save the current basis to a node, or install the basis of a node, returning
+        // false if it does not give a valid basis for the current LP.
+        void saveBasis(GLPKInfo *, Node::Basis &);
+
+        bool installBasis(GLPKInfo *, const Node::Basis &);
+
+        // Give a node whose LP reached a limit the weakest result that is still correct: the
+        // best bound known, and the value 1/2 for every free variable, so that the node is
+        // branched upon rather than pruned or taken for a solution.
+        void setUnsolved(GLPKInfo *, Node &);
+
+        // The callback for GLPK's branch-and-bound, which stops it once no subproblem left can
+        // meet the bounds on the objective function.
+        static void cutoffCallback(glp_tree *, void *);
+
     protected:
         GLPKSolver() = default;
-        virtual ~GLPKSolver() = default;
 
     public:
+        virtual ~GLPKSolver() = default;
+
+        virtual LPSolver *makeInstance();
+
         virtual void setupFormulation(Formulation &);
 
         virtual void cleanupFormulation(Formulation &);
 
         virtual void setObjectiveFunction(Formulation &, std::vector<int> &, int= INT_MIN, int= INT_MAX);
 
+        virtual void setObjectiveCutoff(Formulation &, int);
+
         virtual void addConstraint(Formulation &, Constraint *);
 
         virtual void removeConstraint(Formulation &, Constraint *);
@@ -55,6 +105,10 @@ namespace vorpal::nibac {
 
         virtual void removeCut(Formulation &, Constraint *);
 
+        virtual void addCuts(Formulation &, std::vector<Constraint *> &);
+
+        virtual void removeCuts(Formulation &, std::vector<Constraint *> &);
+
         virtual void fixVariable(Formulation &, int, int);
 
         virtual void unfixVariable(Formulation &, int);
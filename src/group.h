@@ -38,8 +38,7 @@ namespace vorpal::nibac {
         // of efficiency.
         // Multiply is viewed as applying the second perm, then the first.
         static inline void multiply(int *p1, int *p2, int *target) {
-            static int i;
-            for (i = 0; i < x; ++i)
+            for (int i = 0; i < x; ++i)
                 target[i] = p1[p2[i]];
         }
 
@@ -47,8 +46,7 @@ namespace vorpal::nibac {
         static void invert(int *, int *);
 
         static inline bool isIdentity(int *p) {
-            static int i;
-            for (i = 0; i < x; ++i)
+            for (int i = 0; i < x; ++i)
                 if (p[i] != i)
                     return false;
             return true;
@@ -84,11 +82,10 @@ namespace vorpal::nibac {
         // Get the element in the specified position of the base.
         virtual int getBaseElement(int);
 
-#ifdef NODEGROUPS
-        // Duplicates a group; used if we are storing a copy of a group at each node. The
-        // copy must be manually deleted.
+        // Duplicates a group; used if we are storing a copy of a group at each node, or
+        // to give each worker of a parallel search its own group. The copy must be
+        // manually deleted.
         virtual Group *makeCopy() = 0;
-#endif
     };
 };
 #endif
@@ -62,6 +62,21 @@ namespace vorpal::nibac {
     }
 
 
+    void ImmediateSolutionManager::writeCheckpoint(std::ostream &out) {
+        out << bestsoln << std::endl;
+    }
+
+
+    void ImmediateSolutionManager::readCheckpoint(std::istream &in) {
+        // The solutions of the checkpoint were output by the search that wrote it.
+        double checkpointbestsoln;
+        in >> checkpointbestsoln;
+        if ((ptype == Formulation::MAXIMIZATION && greaterthan(checkpointbestsoln, bestsoln))
+            || (ptype == Formulation::MINIMIZATION && lessthan(checkpointbestsoln, bestsoln)))
+            bestsoln = checkpointbestsoln;
+    }
+
+
     ImmediateSolutionManagerCreator::ImmediateSolutionManagerCreator()
             : problemType(Formulation::PROBLEMTYPE_UNDEFINED),
               solutionType(Formulation::SOLUTIONTYPE_UNDEFINED),
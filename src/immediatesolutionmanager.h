@@ -38,6 +38,11 @@ namespace vorpal::nibac {
         virtual ~ImmediateSolutionManager() = default;
 
         void newSolution(Node &) override;
+
+        // The solutions have already been output, so only the best solution value is kept.
+        void writeCheckpoint(std::ostream &) override;
+
+        void readCheckpoint(std::istream &) override;
     };
 
     /**
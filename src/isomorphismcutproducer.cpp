@@ -4,16 +4,17 @@
  * By Sebastian Raaphorst, 2003 - 2018.
  */
 
+#include <algorithm>
 #include <string>
 #include <map>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 #include "common.h"
 #include "isomorphismcutproducer.h"
 #include "bac.h"
 #include "cutproducer.h"
 #include "group.h"
-#include "isomorphismcut.h"
 #include "lpsolver.h"
 #include "margotbac.h"
 #include "node.h"
@@ -27,7 +28,9 @@ namespace vorpal::nibac {
     IsomorphismCutProducer::IsomorphismCutProducer(int pnumberVariables,
                                                    double pIC_MIN_FRACTIONAL_VALUE)
             : numberVariables(pnumberVariables),
-              IC_MIN_FRACTIONAL_VALUE(pIC_MIN_FRACTIONAL_VALUE) {
+              IC_MIN_FRACTIONAL_VALUE(pIC_MIN_FRACTIONAL_VALUE),
+              numberCandidates(0),
+              containing(pnumberVariables) {
         used = new bool[numberVariables];
         for (int i = 0; i < numberVariables; ++i)
             used[i] = false;
@@ -58,6 +61,78 @@ namespace vorpal::nibac {
     }
 
 
+    CutProducer *IsomorphismCutProducer::makeWorkerCopy(void) {
+        return new IsomorphismCutProducer(numberVariables, IC_MIN_FRACTIONAL_VALUE);
+    }
+
+
+    void IsomorphismCutProducer::addCandidate(int numberIndices, int *indices, double violation) {
+        if (numberCandidates == (int) candidates.size()) {
+            candidates.resize(numberCandidates + 1);
+            hits.push_back(0);
+        }
+        Candidate &candidate = candidates[numberCandidates];
+        candidate.indices.assign(indices, indices + numberIndices);
+        std::sort(candidate.indices.begin(), candidate.indices.end());
+
+        unsigned long hash = numberIndices;
+        for (std::vector<int>::iterator iter = candidate.indices.begin(); iter != candidate.indices.end(); ++iter)
+            hash ^= (unsigned long) *iter + 0x9e3779b97f4a7c15UL + (hash << 6) + (hash >> 2);
+        candidate.hash = hash;
+
+        // A duplicate is the most common case, and we can rule it out directly.
+        std::pair<std::unordered_multimap<unsigned long, int>::iterator,
+                std::unordered_multimap<unsigned long, int>::iterator> range = candidateIndex.equal_range(hash);
+        for (std::unordered_multimap<unsigned long, int>::iterator iter = range.first; iter != range.second; ++iter) {
+            Candidate &other = candidates[(*iter).second];
+            if (other.activeFlag && other.indices == candidate.indices)
+                return;
+        }
+
+        // Count, for each active candidate sharing a variable with this one, how many variables
+        // they share. If it is all of the variables of the other candidate, then it is contained
+        // in this one, which is then the weaker cut; if it is all of ours, then this one is the
+        // stronger cut, and the other is removed. As the active candidates never contain one another,
+        // at most one of the two can happen.
+        for (std::vector<int>::iterator iter = candidate.indices.begin(); iter != candidate.indices.end(); ++iter) {
+            std::vector<int> &others = containing[*iter];
+            for (std::vector<int>::iterator oiter = others.begin(); oiter != others.end(); ++oiter)
+                if (candidates[*oiter].activeFlag && hits[*oiter]++ == 0)
+                    touched.push_back(*oiter);
+        }
+
+        bool dominatedFlag = false;
+        for (std::vector<int>::iterator iter = touched.begin(); iter != touched.end(); ++iter) {
+            if (hits[*iter] == (int) candidates[*iter].indices.size())
+                dominatedFlag = true;
+            else if (hits[*iter] == numberIndices)
+                candidates[*iter].activeFlag = false;
+            hits[*iter] = 0;
+        }
+        touched.clear();
+        if (dominatedFlag)
+            return;
+
+        candidate.violation = violation;
+        candidate.activeFlag = true;
+        candidateIndex.insert(std::make_pair(hash, numberCandidates));
+        for (std::vector<int>::iterator iter = candidate.indices.begin(); iter != candidate.indices.end(); ++iter)
+            containing[*iter].push_back(numberCandidates);
+        ++numberCandidates;
+    }
+
+
+    void IsomorphismCutProducer::clearCandidates(void) {
+        for (int i = 0; i < numberCandidates; ++i)
+            for (std::vector<int>::iterator iter = candidates[i].indices.begin();
+                 iter != candidates[i].indices.end();
+                 ++iter)
+                containing[*iter].clear();
+        candidateIndex.clear();
+        numberCandidates = 0;
+    }
+
+
     void IsomorphismCutProducer::generateCuts(BAC &bac, Node &node, double violationTolerance,
                                               int &numberOfCuts, double &maximumViolation) {
         numberOfCuts = 0;
@@ -71,9 +146,6 @@ namespace vorpal::nibac {
         int *part_zero = ((MargotBAC &) bac).getPartZero();
 
         // Some variables we need for later on.
-        IsomorphismCut *cuts = 0;
-        IsomorphismCut *cut, *iter, *tmpcut;
-        bool addflag;
         int *h;
         bool flag;
         int permelem, elem;
@@ -116,36 +188,7 @@ namespace vorpal::nibac {
 
                 // Check canonicity, and if not canonical, we make a cut if we can.
                 if (g->getPosition(elem) >= part_zero[index]) {
-                    cut = new IsomorphismCut(g->getBaseSetSize(), index + 1, selected, sum_x[index] - index);
-                    addflag = true;
-
-                    // Check for duplicates and containment.
-                    for (iter = cuts; iter;) {
-                        if (*cut == *iter) {
-                            addflag = false;
-                            delete cut;
-                            break;
-                        }
-
-                        if (*cut < *iter) {
-                            // We want to delete iter, as cut is a subcut.
-                            tmpcut = iter;
-                            iter = iter->deleteCut();
-                            if (tmpcut == cuts)
-                                cuts = iter;
-                            delete tmpcut;
-                            continue;
-                        }
-
-                        // These cuts are unrelated, so we simply loop.
-                        iter = iter->getNext();
-                    }
-
-                    // Add the cut if we've deemed it appropriate to do so.
-                    if (addflag) {
-                        cut->setNext(cuts);
-                        cuts = cut;
-                    }
+                    addCandidate(index + 1, selected, sum_x[index] - index);
 
                     // As per Margot's algorithms, in this case, we do not extend (we want
                     // minimal cuts) and simply loop on the next possible elem of remain.
@@ -183,26 +226,27 @@ namespace vorpal::nibac {
             pos[index] = -1;
         }
 
-        // We now have a list of cuts. We add them.
-        // We now have a linked list of minimal cuts without repetition; iterate over the list, deleting nodes and
-        // creating formulation cuts.
+        // We now have the minimal cuts without repetition; create the formulation cuts for them, most
+        // recently found first. They are added to the node all at once.
         Formulation &formulation = bac.getFormulation();
+        std::vector<Constraint *> constraints;
+        for (int i = numberCandidates - 1; i >= 0; --i) {
+            Candidate &candidate = candidates[i];
+            if (!candidate.activeFlag)
+                continue;
 
-        for (iter = cuts; iter;) {
-            Constraint *constraint = Constraint::createConstraint(formulation, iter->getNumberIndices(),
-                                                                  iter->getIndices(), LT,
-                                                                  iter->getNumberIndices() - 1);
-            node.addCut(constraint);
+            constraints.push_back(Constraint::createConstraint(formulation, candidate.indices, LT,
+                                                               candidate.indices.size() - 1));
 
             ++numberOfCuts;
-            if (iter->getViolation() > maximumViolation)
-                maximumViolation = iter->getViolation();
-
-            // Now delete this cut.
-            tmpcut = iter;
-            iter = iter->deleteCut();
-            delete tmpcut;
+            if (candidate.violation > maximumViolation)
+                maximumViolation = candidate.violation;
         }
+        clearCandidates();
+
+        // They depend on the fixings at the node, and so are only valid in the subtree rooted here.
+        if (!constraints.empty())
+            numberOfCuts = bac.addCuts(node, constraints);
     }
 
 
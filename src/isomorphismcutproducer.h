@@ -9,11 +9,12 @@
 
 #include <string>
 #include <map>
+#include <unordered_map>
+#include <vector>
 #include "common.h"
 #include "bac.h"
 #include "cutproducer.h"
 #include "group.h"
-#include "isomorphismcut.h"
 #include "node.h"
 #include "permutationpool.h"
 
@@ -42,6 +43,35 @@ namespace vorpal::nibac {
         int **hperms;
         double *sum_x;
 
+        // The cuts found so far in a call to generateCuts. They are kept from one call to
+        // the next with their index vectors, so that a candidate cut is stored without any
+        // allocation once the producer has warmed up; only the first numberCandidates are
+        // in use, and of these, the active ones form the cuts found so far.
+        struct Candidate {
+            std::vector<int> indices;
+            unsigned long hash;
+            double violation;
+            bool activeFlag;
+        };
+        std::vector<Candidate> candidates;
+        int numberCandidates;
+
+        // The candidates by the hash of their indices, used to detect a duplicate in constant
+        // time, and for each variable, the candidates that contain it, used to find the cuts
+        // that contain, or are contained by, a new one without comparing it to every other.
+        // hits counts, for each candidate, the variables of a new cut that it contains.
+        std::unordered_multimap<unsigned long, int> candidateIndex;
+        std::vector<std::vector<int> > containing;
+        std::vector<int> hits;
+        std::vector<int> touched;
+
+        // Add a candidate cut over the given variables with the given violation, unless it
+        // duplicates a cut found so far or contains one, removing any that contain it.
+        void addCandidate(int, int *, double);
+
+        // Forget the candidates, keeping their storage.
+        void clearCandidates(void);
+
     public:
         IsomorphismCutProducer(int, double= IC_DEFAULT_MIN_FRACTIONAL_VALUE);
 
@@ -49,6 +79,9 @@ namespace vorpal::nibac {
 
         // Cut generator
         void generateCuts(BAC &, Node &, double, int &, double &) override;
+
+        // The backtracking workspace is private to each worker.
+        CutProducer *makeWorkerCopy(void) override;
     };
 
 
@@ -5,6 +5,7 @@
  */
 
 #include "common.h"
+#include "nibacexception.h"
 #include "node.h"
 #include "lpsolver.h"
 
@@ -14,6 +15,16 @@ namespace vorpal::nibac {
 
 
     LPSolver::LPSolver() {
-        instance = this;
+        // Only the first solver created becomes the default instance; the others are
+        // made from it for formulations.
+        if (!instance)
+            instance = this;
     }
-};
\ No newline at end of file
+
+
+    LPSolver *LPSolver::createSolver() {
+        if (!instance)
+            throw NoLPSolverException();
+        return instance->makeInstance();
+    }
+};
@@ -18,20 +18,37 @@ namespace vorpal::nibac {
     /**
      * This class encapsulates all of the LP-solver specific tasks so that the remainder of
      * the code can remain as general as possible. We use this class in a factory-sort of way;
-     * when the constructor is called for a subclass of this class, the created object is set up
-     * as the default instance via the instance member. This can then be accessed statically using
-     * the getInstance() method. If the user wants multiple LPSolvers, this must be managed manually.
+     * when the constructor is called for the first time for a subclass of this class (normally
+     * for the static instance that the subclass links in), the created object is set up as the
+     * default instance via the instance member. This can be accessed statically using the
+     * getInstance() method.
+     *
+     * Each Formulation owns an LPSolver of its own, created from the default instance by
+     * createSolver(), and any state that the solver needs (e.g. a CPLEX environment) belongs to
+     * that object. Thus, several formulations can be solved at the same time, e.g. by the workers
+     * of a parallel search.
      */
     class LPSolver {
     protected:
         static LPSolver *instance;
 
         LPSolver();
-        virtual ~LPSolver() = default;
 
     public:
+        virtual ~LPSolver() = default;
+
         inline static LPSolver *getInstance() { return instance; }
 
+        /**
+         * Create a new solver for a formulation from the default instance.
+         */
+        static LPSolver *createSolver();
+
+        /**
+         * Create a new solver of the same type as this one, with state of its own.
+         */
+        virtual LPSolver *makeInstance() = 0;
+
         /**
          * Set up a formulation. We need to manipulate the data structures:
          * Formulation::data
@@ -46,6 +63,16 @@ namespace vorpal::nibac {
          */
         virtual void setObjectiveFunction(Formulation &, std::vector<int> &, int= INT_MIN, int= INT_MAX) = 0;
 
+        /**
+         * Tighten the bound on the objective function given to setObjectiveFunction in the
+         * direction of optimization, i.e. the lower bound for maximization and the upper bound
+         * for minimization, to the given value if it is tighter. BAC calls this whenever it has
+         * a better solution, so that an LP that cannot meet it can be abandoned early, and
+         * solveNode can return -1 for it. This is only an optimization, and by default, the
+         * cutoff is ignored.
+         */
+        virtual void setObjectiveCutoff(Formulation &, int) {}
+
 
         virtual void addConstraint(Formulation &, Constraint *) = 0;
         virtual void removeConstraint(Formulation &, Constraint *) = 0;
@@ -53,6 +80,28 @@ namespace vorpal::nibac {
         virtual void addCut(Formulation &, Constraint *) = 0;
         virtual void removeCut(Formulation &, Constraint *) = 0;
 
+        /**
+         * Add several cuts at once, e.g. those of a round of separation. A solver for which
+         * adding rows one by one is costly should override this to add them in one operation.
+         */
+        virtual void addCuts(Formulation &f, std::vector<Constraint *> &cuts) {
+            for (std::vector<Constraint *>::iterator iter = cuts.begin();
+                 iter != cuts.end();
+                 ++iter)
+                addCut(f, *iter);
+        }
+
+        /**
+         * Remove several cuts at once. A solver for which removing a row is costly, e.g. as the
+         * rows after it must be renumbered, should override this to remove them in one pass.
+         */
+        virtual void removeCuts(Formulation &f, std::vector<Constraint *> &cuts) {
+            for (std::vector<Constraint *>::iterator iter = cuts.begin();
+                 iter != cuts.end();
+                 ++iter)
+                removeCut(f, *iter);
+        }
+
         /**
          * Given a node, solve the LP at this node and copy the solution into the node. Should
          * return number of subnodes processed, and -1 for failure. Note that the return value will
@@ -60,6 +109,14 @@ namespace vorpal::nibac {
          * parameter indicates if we should try to solve the node fully here. If this is not possible,
          * it is okay to return a noninteger solution. If an integer solution is returned, the node
          * is assumed to have been fully solved.
+         *
+         * A solver that supports warm starts may save its basis to the node (see Node::Basis),
+         * and start the first LP at a node from the basis of its closest ancestor (see
+         * Node::getAncestorBasis), which is nearly optimal for it.
+         *
+         * A solver that solved the LP to optimality may also copy the reduced costs of the
+         * branching variables into the node (see Node::getReducedCostArray) and set its flag,
+         * which allows BAC to fix variables by reduced cost.
          */
         virtual int solveNode(BAC &, Node &, bool= false) = 0;
 
@@ -0,0 +1,88 @@
+/**
+ * lptrace.cpp
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+
+#include <fstream>
+#include <string>
+#include "common.h"
+#include "formulation.h"
+#include "lptrace.h"
+#include "nibacexception.h"
+#include "node.h"
+
+namespace vorpal::nibac {
+    LPTrace::LPTrace(const char *pfileName, Formulation &formulation, bool recordFlag)
+            : fileName(pfileName),
+              numberBranchingVariables(formulation.getNumberBranchingVariables()) {
+        if (recordFlag) {
+            stream.open(fileName, std::ios::out | std::ios::trunc | std::ios::binary);
+            if (!stream)
+                throw FileOutputException(fileName);
+            stream << "NIBAC-LPTRACE 3" << std::endl;
+            stream << formulation.getNumberVariables() << ' ' << numberBranchingVariables << std::endl;
+            return;
+        }
+
+        stream.open(fileName, std::ios::in | std::ios::binary);
+        if (!stream)
+            throw FileInputException(fileName);
+
+        std::string header;
+        int version, numberVariables, traceNumberBranchingVariables;
+        stream >> header >> version;
+        if (!stream || header != "NIBAC-LPTRACE" || version != 3)
+            throw FileInputException(fileName);
+        if (!(stream >> numberVariables >> traceNumberBranchingVariables) || stream.get() != '\n')
+            throw FileInputException(fileName);
+        if (numberVariables != formulation.getNumberVariables()
+            || traceNumberBranchingVariables != numberBranchingVariables)
+            throw IllegalParameterException("BACOptions::LPReplayFileName", fileName,
+                                            "trace was recorded for a different problem");
+    }
+
+
+    void LPTrace::write(Node &node, int result) {
+        int header[3] = {node.getDepth(), result, node.hasReducedCosts()};
+        stream.write((const char *) header, sizeof(header));
+        if (result >= 0) {
+            double value = node.getSolutionValue();
+            stream.write((const char *) &value, sizeof(value));
+            stream.write((const char *) node.getSolutionVariableArray(), numberBranchingVariables * sizeof(double));
+            if (node.hasReducedCosts())
+                stream.write((const char *) node.getReducedCostArray(), numberBranchingVariables * sizeof(double));
+        }
+        if (!stream)
+            throw FileOutputException(fileName);
+    }
+
+
+    int LPTrace::read(Node &node) {
+        int header[3];
+        if (!stream.read((char *) header, sizeof(header)))
+            throw FileInputException(fileName);
+        int depth = header[0];
+        int result = header[1];
+
+        // If the search has taken a different path from the one recorded, the rest of the
+        // trace is meaningless.
+        if (depth != node.getDepth())
+            throw IllegalParameterException("BACOptions::LPReplayFileName", fileName,
+                                            "trace was recorded for a different search");
+        if (result < 0)
+            return result;
+
+        double value;
+        if (!stream.read((char *) &value, sizeof(value))
+            || !stream.read((char *) node.getSolutionVariableArray(), numberBranchingVariables * sizeof(double)))
+            throw FileInputException(fileName);
+        node.setSolutionValue(value);
+        if (header[2]) {
+            if (!stream.read((char *) node.getReducedCostArray(), numberBranchingVariables * sizeof(double)))
+                throw FileInputException(fileName);
+            node.setReducedCostsFlag(true);
+        }
+        return result;
+    }
+};
@@ -0,0 +1,51 @@
+/**
+ * lptrace.h
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+// An LPTrace is a file holding the results of the LPs solved during a search,
+// in the order in which they were solved: for each, the depth of its node, the
+// value returned by LPSolver::solveNode, and unless the node was pruned, its
+// solution value, the values of the branching variables and their reduced
+// costs, if the LP solver provided them. BAC records a
+// trace if given an LP record file (see BACOptions), and ReplaySolver plays
+// one back, so that the same search can be run again without solving any LPs,
+// which isolates the cost of the rest of the branch-and-cut. After a short
+// text header, the results are kept in binary, so that playing them back
+// costs as little as possible.
+
+#ifndef LPTRACE_H
+#define LPTRACE_H
+
+#include <fstream>
+#include "common.h"
+
+namespace vorpal::nibac {
+    // Class forwards
+    class Formulation;
+    class Node;
+
+    class LPTrace final {
+    private:
+        const char *fileName;
+        std::fstream stream;
+        int numberBranchingVariables;
+
+    public:
+        // Open a trace for the given formulation, for recording if the flag is set, and
+        // for replaying otherwise. When replaying, the trace must have been recorded for
+        // a formulation with the same variables.
+        LPTrace(const char *, Formulation &, bool);
+
+        virtual ~LPTrace() = default;
+
+        // Record the result of the LP of a node.
+        void write(Node &, int);
+
+        // Replay the next result, setting the solution of the node and returning what
+        // solveNode returned. The trace must have been recorded by the same search.
+        int read(Node &);
+    };
+};
+
+#endif
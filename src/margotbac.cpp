@@ -27,6 +27,7 @@ namespace vorpal::nibac {
                          MargotBACOptions &poptions)
             : BAC(pformulation, (BACOptions &) poptions),
               rootGroup(prootGroup),
+              workerGroup(0),
               part_zero(new int[pformulation.getNumberBranchingVariables() + 1]) {
         // Complete initialization on the MargotBACOptions.
         // This gives us the highestCanonicityDepth, which we will need.
@@ -42,29 +43,37 @@ namespace vorpal::nibac {
 
     MargotBAC::~MargotBAC() {
         delete[] part_zero;
+
+        // The nodes must go before the group that they use.
+        if (workerGroup) {
+            delete nodeStack;
+            nodeStack = 0;
+            delete workerGroup;
+        }
     }
 
 
-    void MargotBAC::initialize(void) {
-        // Tell the statistics how many cutters we are using.
-        options.getStatistics().setNumberCutProducers(options.getCutProducers().size());
+    Node *MargotBAC::createRootNode(void) {
+        return new Node(*this,
+                        formulation,
+                        &rootGroup,
+                        formulation.getNumberVariables(),
+                        formulation.getNumberBranchingVariables(),
+                        &(options.getInitial0Fixings()),
+                        &(options.getInitial1Fixings()));
+    }
 
-        // Create the default node. Note that this node is handled by the nodestack and
-        // we do not need to deallocate it.
-        Node *node = new Node(*this,
-                              formulation,
-                              &rootGroup,
-                              formulation.getNumberVariables(),
-                              formulation.getNumberBranchingVariables(),
-                              &(options.getInitial0Fixings()),
-                              &(options.getInitial1Fixings()));
 
-        // We must have a branching scheme defined in order to create a NodeStack.
-        if (options.getBranchingScheme() == 0)
-            throw NoBranchingSchemeException();
+    BACOptions *MargotBAC::createWorkerOptions(void) {
+        return new MargotBACOptions((MargotBACOptions &) options);
+    }
+
 
-        // Create the nodestack and add the new node to it.
-        nodeStack = new NodeStack(*(options.getBranchingScheme()), node, options.getStatistics());
+    BAC *MargotBAC::createWorker(Formulation &pformulation, BACOptions &poptions) {
+        Group *group = rootGroup.makeCopy();
+        MargotBAC *worker = new MargotBAC(pformulation, *group, (MargotBACOptions &) poptions);
+        worker->workerGroup = group;
+        return worker;
     }
 
 
@@ -115,41 +124,8 @@ namespace vorpal::nibac {
         // We just fix this variableent to 0 without calculating the orbit.
         MargotBACOptions &margotOptions = (MargotBACOptions &) options;
         if (!(node.shouldTestCanonicity())
-            || (margotOptions.getOrbitDepthFlags() && margotOptions.getOrbitDepthFlags()[node.getDepth()] == FALSE)) {
-#ifdef DEBUG
-            std::cerr << "\t= Fixing " << variable << " to 0." << std::endl;
-#endif
-
-            // We determine that we are - or will be - checking canonicity in the following cases:
-            // 1. We are enumerating and we want to check final designs for canonicity.
-            // 2. We have not turned off canonicity testing at this node.
-            // 3. We have turned off canonicity testing at this node, and we will turn it on in the future.
-            bool checkingCanonicity =
-                    (formulation.getSolutionType() != Formulation::GENERATION &&
-                     margotOptions.getTestFinalSolutions()) ||
-                    (node.shouldTestCanonicity() &&
-                     ((!margotOptions.getOrbitDepthFlags() || margotOptions.getOrbitDepthFlags()[node.getDepth()])
-                      || (margotOptions.getCanonicityDepthFlags() &&
-                          margotOptions.getCanonicityDepthFlags()[node.getDepth()])));
-
-            // Down the variable if it is going to be useful in the future to do so.
-            // TODO: FOR SOME REASON, IF WE DON'T DOWN HERE, WE FAIL AND ENTER INTO ENDLESS DEPTH!
-            if (checkingCanonicity) {
-                // Make sure it isn't already set to 0.
-                int pos = node.getNumberBranchingVariables() - node.getNumber0FixedVariables() - 1;
-                int oldpos = group->getPosition(variable);
-                if (oldpos > pos)
-                    return false;
-
-                group->down(oldpos, pos);
-            }
-
-            // Tell the node to fix the variable to 0.
-            node.fixVariable(variable, 0);
-
-            // We have completed the task successfully and can return.
-            return true;
-        }
+            || (margotOptions.getOrbitDepthFlags() && margotOptions.getOrbitDepthFlags()[node.getDepth()] == FALSE))
+            return fixSingleVariableTo0(node, variable);
 
         // If we reach this point, we want to set the variable and its orbit under
         // the stabilizer to 0.
@@ -277,6 +253,60 @@ namespace vorpal::nibac {
     }
 
 
+    bool MargotBAC::fixSingleVariableTo0(Node &node, int variable) {
+#ifdef DEBUG
+        std::cerr << "\t= Fixing " << variable << " to 0." << std::endl;
+#endif
+        Group *group = node.getSymmetryGroup();
+        MargotBACOptions &margotOptions = (MargotBACOptions &) options;
+
+        // We determine that we are - or will be - checking canonicity in the following cases:
+        // 1. We are enumerating and we want to check final designs for canonicity.
+        // 2. We have not turned off canonicity testing at this node.
+        // 3. We have turned off canonicity testing at this node, and we will turn it on in the future.
+        bool checkingCanonicity =
+                (formulation.getSolutionType() != Formulation::GENERATION &&
+                 margotOptions.getTestFinalSolutions()) ||
+                (node.shouldTestCanonicity() &&
+                 ((!margotOptions.getOrbitDepthFlags() || margotOptions.getOrbitDepthFlags()[node.getDepth()])
+                  || (margotOptions.getCanonicityDepthFlags() &&
+                      margotOptions.getCanonicityDepthFlags()[node.getDepth()])));
+
+        // Down the variable if it is going to be useful in the future to do so.
+        // TODO: FOR SOME REASON, IF WE DON'T DOWN HERE, WE FAIL AND ENTER INTO ENDLESS DEPTH!
+        if (checkingCanonicity) {
+            // Make sure it isn't already set to 0.
+            int pos = node.getNumberBranchingVariables() - node.getNumber0FixedVariables() - 1;
+            int oldpos = group->getPosition(variable);
+            if (oldpos > pos)
+                return false;
+
+            group->down(oldpos, pos);
+        }
+
+        // Tell the node to fix the variable to 0.
+        node.fixVariable(variable, 0);
+
+        // We have completed the task successfully and can return.
+        return true;
+    }
+
+
+    int MargotBAC::fixByReducedCost(Node &node) {
+        std::vector<int> zeros;
+        std::vector<int> ones;
+        findReducedCostFixings(node, zeros, ones);
+
+        int numberFixed = 0;
+        for (std::vector<int>::iterator iter = zeros.begin(); iter != zeros.end(); ++iter)
+            if (fixSingleVariableTo0(node, *iter))
+                ++numberFixed;
+
+        reportReducedCostFixings(node, numberFixed);
+        return numberFixed;
+    }
+
+
     void MargotBAC::fix0(Node &node) {
         // The assumption here is that:
         // 1. The node is canonical (guaranteed by 0-fixings in parent nodes)
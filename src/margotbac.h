@@ -31,6 +31,9 @@ namespace vorpal::nibac {
         // This group represents the symmetry group of the root node.
         Group &rootGroup;
 
+        // If we are a worker in a parallel search, our root group is a copy that we own.
+        Group *workerGroup;
+
         // This array is used for determining isomorphism of a node, and
         // we maintain it here. How it works is that for x_i set to 1,
         // part_zero[i] = numvars - numvarsfixedto0.
@@ -45,7 +48,12 @@ namespace vorpal::nibac {
         inline int *getPartZero() { return part_zero; }
 
     private:
-        void initialize() override;
+        Node *createRootNode() override;
+
+        // Workers need their own copies of the options and of the symmetry group.
+        BACOptions *createWorkerOptions() override;
+
+        BAC *createWorker(Formulation &, BACOptions &) override;
 
         // We perform 0-fixing in the preprocessing stage.
         int preprocess(Node &) override;
@@ -67,6 +75,15 @@ namespace vorpal::nibac {
         // the orbit of the variable under the stabilizer of F_1 to 0, etc...
         virtual bool fixVariableTo0(Node &, int, bool= true);
 
+        // Fix a single variable to 0 without calculating its orbit, moving it into the 0-fixed
+        // part of the base if we are, or will be, checking canonicity.
+        bool fixSingleVariableTo0(Node &, int);
+
+        // Variables fixed by reduced cost are not fixed for reasons of symmetry, so we fix them
+        // without their orbits, and only those at 0: the variables fixed to 1 determine the
+        // stabilizer used in 0-fixing.
+        virtual int fixByReducedCost(Node &);
+
         // The 0-fixing routine.
         void fix0(Node &);
     };
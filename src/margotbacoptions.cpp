@@ -16,12 +16,28 @@ namespace vorpal::nibac {
               orbitDepthFlags(0),
               canonicityDepthFlagsString(0),
               orbitDepthFlagsString(0),
-              orbitThreshold(0),
               highestCanonicityDepth(INT_MAX),
+              orbitThreshold(0),
               testFinalSolutions(true) {
     }
 
 
+    MargotBACOptions::MargotBACOptions(const MargotBACOptions &other)
+            : BACOptions(other),
+              canonicityDepthFlags(0),
+              orbitDepthFlags(0),
+              canonicityDepthFlagsString(0),
+              orbitDepthFlagsString(0),
+              highestCanonicityDepth(other.highestCanonicityDepth),
+              orbitThreshold(other.orbitThreshold),
+              testFinalSolutions(other.testFinalSolutions) {
+      if (other.canonicityDepthFlagsString)
+        setCanonicityDepthFlagsString(other.canonicityDepthFlagsString);
+      if (other.orbitDepthFlagsString)
+        setOrbitDepthFlagsString(other.orbitDepthFlagsString);
+    }
+
+
     MargotBACOptions::~MargotBACOptions() {
       if (canonicityDepthFlags)
         delete[] canonicityDepthFlags;
@@ -64,6 +64,10 @@ namespace vorpal::nibac {
 
     public:
         MargotBACOptions();
+
+        // Copy the options, e.g. for a worker of a parallel search. The depth flags are not
+        // copied: they are created again from the strings by the MargotBAC using the copy.
+        MargotBACOptions(const MargotBACOptions &);
         virtual ~MargotBACOptions();
 
         // These will not work until the MargotBACOptions have been passed
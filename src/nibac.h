@@ -18,7 +18,9 @@
 #include "cliquecutproducer.h"
 #include "closestvaluebranchingscheme.h"
 #include "commandlineprocessing.h"
+#include "concurrentseparation.h"
 #include "constraint.h"
+#include "cutpool.h"
 #include "cutproducer.h"
 #include "defaultsolutionmanager.h"
 #include "formulation.h"
@@ -27,11 +29,14 @@
 #include "isomorphismcutproducer.h"
 #include "lexicographicvariableorder.h"
 #include "lowestindexbranchingscheme.h"
+#include "lptrace.h"
 #include "margotbac.h"
 #include "margotbacoptions.h"
 #include "matrix.h"
 #include "matrixgroup.h"
 #include "nibacexception.h"
+#include "nodepath.h"
+#include "nodeselector.h"
 #include "problem.h"
 #include "randomvariableorder.h"
 #include "rankedbranchingscheme.h"
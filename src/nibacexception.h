@@ -111,6 +111,21 @@ namespace vorpal::nibac {
     };
 
 
+    class NetworkException final : public DetailedException {
+    public:
+        NetworkException(const char *address, const char *description)
+                : DetailedException(createDescription(address, description)) {
+        }
+
+    private:
+        static const std::string createDescription(const char *address, const char *description) {
+            std::ostringstream stream;
+            stream << "Network error (address: \"" << address << "\"): " << description;
+            return stream.str();
+        }
+    };
+
+
     class NoBranchingSchemeException : public DetailedException {
     public:
         NoBranchingSchemeException()
@@ -119,6 +134,14 @@ namespace vorpal::nibac {
     };
 
 
+    class NoLPSolverException : public DetailedException {
+    public:
+        NoLPSolverException()
+                : DetailedException("No LP solver was linked in.") {
+        }
+    };
+
+
     class NoSolutionManagerException : public DetailedException {
     public:
         NoSolutionManagerException()
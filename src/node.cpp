@@ -7,6 +7,7 @@
 #include <map>
 #include <set>
 #include <list>
+#include <vector>
 #include "node.h"
 #include "bac.h"
 #include "bacoptions.h"
@@ -14,6 +15,7 @@
 #include "formulation.h"
 #include "lpsolver.h"
 #include "variableorder.h"
+#include "variableset.h"
 
 namespace vorpal::nibac {
 // While we only care about the branching variables for the majority of operations, the partial
@@ -48,21 +50,17 @@ namespace vorpal::nibac {
             number0FixedVariables(0),
             numberLPSolves(0),
             solutionValue(0),
-            solutionVariableArray(new double[pnumberBranchingVariables]),
-            partialSolutionArray(new short int[pnumberVariables]) {
-        // Indicate that every variable is free in the partial solution.
+            solutionVariableArray(0),
+            reducedCostsFlag(false),
+            solutionEstimate(0),
+            ancestorBasis(0),
+            state(new State(pnumberVariables, pnumberBranchingVariables, *(pbac.getOptions().getVariableOrder()))),
+            trailMark(0) {
+        // Indicate that every variable is free in the partial solution. The free list starts
+        // out with all variables.
         for (int i = 0; i < numberVariables; ++i)
-            partialSolutionArray[i] = -1;
-
-        // Get the variable order.
-        VariableOrder *variableOrder = bac.getOptions().getVariableOrder();
-
-        // Populate the free list with all variables, and the lookup maps.
-        for (int i = 0; i < numberBranchingVariables; ++i) {
-            freeVariables.insert(i);
-            freeVariableToIndex[i] = variableOrder->variableToIndex(i);
-            indexToFreeVariable[i] = variableOrder->indexToVariable(i);
-        }
+            state->partialSolutionArray[i] = -1;
+        state->trail.reserve(numberBranchingVariables);
 
         // If there are any variables we want to fix to 1, fix them.
         // NOTE that it is tremendously important that we perform the
@@ -85,7 +83,8 @@ namespace vorpal::nibac {
 
 // Note that, in the constructor, we don't modify the number of fixed variables
 // or the number of 0 fixed variables. This will be taken care of in the call
-// to fixVariableTo0 or fixVariableTo1.
+// to fixVariableTo0 or fixVariableTo1. The child takes over the state of the
+// variables from its parent, which must be the deepest node in the tree.
     Node::Node(Node *parent,
                int pbranchVariableIndex,
                int pbranchVariableValue)
@@ -110,20 +109,16 @@ namespace vorpal::nibac {
             number0FixedVariables(parent->number0FixedVariables),
             numberLPSolves(0),
             solutionValue(0),
-            solutionVariableArray(new double[parent->numberBranchingVariables]),
-            partialSolutionArray(new short int[parent->numberVariables]),
-            freeVariables(parent->freeVariables),
-            freeVariableToIndex(parent->freeVariableToIndex),
-            indexToFreeVariable(parent->indexToFreeVariable) {
+            solutionVariableArray(0),
+            reducedCostsFlag(false),
+            solutionEstimate(0),
+            ancestorBasis(parent->basis.empty() ? parent->ancestorBasis : &(parent->basis)),
+            state(parent->state),
+            trailMark(parent->state->trail.size()) {
         // Determine if this node is, by default, canonical.
         // If the parent is canonical and we branched on 0, then we are naturally canonical.
         isCanonicalFlag = parent->isCanonicalFlag && branchVariableValue == 0;
 
-        // Copy the partial solution from the parent.
-        memcpy(partialSolutionArray,
-               parent->partialSolutionArray,
-               sizeof(short int) * numberVariables);
-
         // Set the symmetry group for this node.
 #ifdef NODEGROUPS
         bac.getOptions().getStatistics().getGroupCopyTimer().start();
@@ -144,38 +139,39 @@ namespace vorpal::nibac {
 
 
     Node::~Node() {
-        // Unfix all the fixed variables.
-        for (std::set<int>::iterator iter = fixedVariables.begin();
-             iter != fixedVariables.end();
-             ++iter)
-            formulation.unfixVariable(*iter);
+        // Undo the fixings made at this node, which are the last ones on the trail as
+        // all of our descendants have already been deleted.
+        assert(state->trail.size() >= trailMark);
+        while (state->trail.size() > trailMark) {
+            int variable = state->trail.back();
+            state->trail.pop_back();
+
+            formulation.unfixVariable(variable);
+            state->partialSolutionArray[variable] = -1;
+            state->freeVariables.insert(variable);
+        }
 
         // We need to remove all cuts at the node from the formulation.
-        for (std::set<Constraint *>::iterator iter = cuts.begin();
-             iter != cuts.end();
-             ++iter) {
-            Constraint *cut = *iter;
-            formulation.removeCut(cut);
-            delete cut;
+        if (!cuts.empty()) {
+            std::vector<Constraint *> nodeCuts(cuts.begin(), cuts.end());
+            formulation.removeCuts(nodeCuts);
+            for (std::vector<Constraint *>::iterator iter = nodeCuts.begin();
+                 iter != nodeCuts.end();
+                 ++iter)
+                delete *iter;
+            cuts.clear();
         }
-        cuts.clear();
 
-        if (bac.getOptions().keepCuts()) {
+        if (bac.getOptions().keepCuts() && !removedCuts.empty()) {
             // Add back the constraints that we removed from the
             // branch rooted at this node.
-            for (std::set<Constraint *>::iterator iter = removedCuts.begin();
-                 iter != removedCuts.end();
-                 ++iter)
-                formulation.addCut(*iter);
+            std::vector<Constraint *> restoredCuts(removedCuts.begin(), removedCuts.end());
+            formulation.addCuts(restoredCuts);
         }
 
-        // Delete the partial solution.
-        if (partialSolutionArray)
-            delete[] partialSolutionArray;
-
-        // Delete the array of solution variables.
-        if (solutionVariableArray)
-            delete[] solutionVariableArray;
+        // The root node owns the state of the variables, including the solution arrays.
+        if (depth == 0)
+            delete state;
 
 #ifdef NODEGROUPS
         if (!rootNodeFlag)
@@ -186,16 +182,13 @@ namespace vorpal::nibac {
 
 
     void Node::cleanup(void) {
-        if (solutionVariableArray)
-            delete[] solutionVariableArray;
+        // The array belongs to the node stack, and will be reused by the next node at this depth.
         solutionVariableArray = 0;
     }
 
 
     int Node::getLowestFreeVariableIndex() {
-        assert((freeVariables.empty() && indexToFreeVariable.empty())
-               || (!freeVariables.empty() && !indexToFreeVariable.empty()));
-        return (freeVariables.empty() ? -1 : (*(indexToFreeVariable.begin())).second);
+        return state->freeVariables.getLowest();
     }
 
 
@@ -205,24 +198,41 @@ namespace vorpal::nibac {
     }
 
 
+    void Node::addCuts(std::vector<Constraint *> &added) {
+        cuts.insert(added.begin(), added.end());
+        formulation.addCuts(added);
+    }
+
+
     void Node::removeCut(Constraint *cut) {
-        // If it exists in the list of constraints, remove it from there.
-        std::set<Constraint *>::iterator iter = cuts.find(cut);
-        if (iter != cuts.end()) {
-            cuts.erase(iter);
-            formulation.removeCut(cut);
-            delete cut;
-        } else {
-            // This constraint is either global to the formulation or
-            // defined in a parent node, so we want to restore it when
-            // we backtrack beyond this node if keepConstraints is set.
-            // Otherwise, we simply remove it and delete it.
-            if (bac.getOptions().keepCuts()) {
-                removedCuts.insert(cut);
-                formulation.removeCut(cut);
-            } else {
-                formulation.removeCut(cut);
+        std::vector<Constraint *> removed(1, cut);
+        removeCuts(removed);
+    }
+
+
+    void Node::removeCuts(std::vector<Constraint *> &removed) {
+        // The cuts must be out of the formulation before any of them are deleted.
+        formulation.removeCuts(removed);
+
+        for (std::vector<Constraint *>::iterator riter = removed.begin();
+             riter != removed.end();
+             ++riter) {
+            Constraint *cut = *riter;
+
+            // If it exists in the list of constraints, remove it from there.
+            std::set<Constraint *>::iterator iter = cuts.find(cut);
+            if (iter != cuts.end()) {
+                cuts.erase(iter);
                 delete cut;
+            } else {
+                // This constraint is either global to the formulation or
+                // defined in a parent node, so we want to restore it when
+                // we backtrack beyond this node if keepConstraints is set.
+                // Otherwise, we simply delete it.
+                if (bac.getOptions().keepCuts())
+                    removedCuts.insert(cut);
+                else
+                    delete cut;
             }
         }
     }
@@ -230,6 +240,6 @@ namespace vorpal::nibac {
 
     void Node::setSolutionToPartial() {
         for (int i = 0; i < numberBranchingVariables; ++i)
-            solutionVariableArray[i] = partialSolutionArray[i];
+            solutionVariableArray[i] = state->partialSolutionArray[i];
     }
 };
\ No newline at end of file
@@ -9,9 +9,13 @@
 
 #include <map>
 #include <set>
+#include <utility>
+#include <vector>
 #include "common.h"
 #include "formulation.h"
 #include "group.h"
+#include "variableorder.h"
+#include "variableset.h"
 
 namespace vorpal::nibac {
     class NodeStack;
@@ -24,6 +28,19 @@ namespace vorpal::nibac {
         // Friend class declarations.
         friend class NodeStack;
 
+    public:
+        // A snapshot of the LP basis at a node, as saved by an LPSolver that supports warm
+        // starts, from which the LPs of its descendants can be started: the status of each
+        // column, and the status of each row not in the basis, keyed by the ID of its
+        // constraint as rows come and go with the cuts. Statuses are in the encoding of the
+        // LPSolver.
+        struct Basis {
+            std::vector<unsigned char> columnStatuses;
+            std::vector<std::pair<unsigned long, unsigned char> > rowStatuses;
+
+            inline bool empty() const { return columnStatuses.empty(); }
+        };
+
     private:
 #ifdef NODEGROUPS
         // If this is the root node, we do not destroy its symmetry group upon backtracking.
@@ -91,15 +108,59 @@ namespace vorpal::nibac {
         int numberLPSolves;
         double solutionValue;
         double *solutionVariableArray;
-
-        // The partial solution up to this point.
-        // -1 indicates a free variable.
-        // 0 indicates a variable fixed to 0.
-        // 1 indicates a variable fixed to 1.
-        // Information is needed in this format for quick feasibility
-        // testing, and will prevent the need for us to reconstruct this
-        // array for each node using the fixed and free lists.
-        short int *partialSolutionArray;
+        bool reducedCostsFlag;
+
+        // An estimate of the value of the best solution in the subtree rooted at this
+        // node, as determined by a NodeSelector.
+        double solutionEstimate;
+
+        // The basis of the last LP solved at this node, if one was saved, and the basis of
+        // the closest ancestor for which one was saved, or 0. An ancestor outlives its
+        // descendants on the stack, so the pointer remains valid.
+        Basis basis;
+        const Basis *ancestorBasis;
+
+        // The state of the variables along the path from the root to the node on the top
+        // of the stack, which is shared by all the nodes of a tree. Instead of copying it
+        // for every child, a child makes its fixings in place, recording each on the trail,
+        // and undoes them when it is deleted. Since the tree is explored depth-first, the
+        // state is that of the deepest node that exists, i.e. of the node being processed.
+        struct State {
+            // The partial solution up to this point.
+            // -1 indicates a free variable.
+            // 0 indicates a variable fixed to 0.
+            // 1 indicates a variable fixed to 1.
+            // Information is needed in this format for quick feasibility
+            // testing, and will prevent the need for us to reconstruct this
+            // array for each node using the fixed and free lists.
+            short int *partialSolutionArray;
+
+            // The free variables, in the order determined by the chosen VariableOrder.
+            VariableSet freeVariables;
+
+            // The variables fixed, in the order in which they were fixed.
+            std::vector<int> trail;
+
+            // The reduced costs of the last LP solved, which are only used by the node that
+            // solved it, and so can be shared by all of them.
+            double *reducedCostArray;
+
+            State(int numberVariables, int numberBranchingVariables, VariableOrder &variableOrder)
+                    : partialSolutionArray(new short int[numberVariables]),
+                      freeVariables(numberBranchingVariables, variableOrder),
+                      reducedCostArray(new double[numberBranchingVariables]) {
+            }
+
+            ~State() {
+                delete[] partialSolutionArray;
+                delete[] reducedCostArray;
+            }
+        };
+        State *state;
+
+        // The size of the trail when this node was created: the entries beyond it are
+        // the variables fixed at this node.
+        std::vector<int>::size_type trailMark;
 
         // The cuts associated with this node.
         std::set<Constraint *> cuts;
@@ -108,20 +169,6 @@ namespace vorpal::nibac {
         // be readded when we backtrack to the parent node.
         std::set<Constraint *> removedCuts;
 
-        // The free variables at this node.
-        std::set<int> freeVariables;
-
-        // The variables that we fixed at this node.
-        std::set<int> fixedVariables;
-
-        // A lookup and reverse lookup map that determines the order on the free variables
-        // at the node. freeVariableToIndex maps a variable to its index in the ordering, and
-        // indexToFreeVariable performs the reverse. Note that the index will not be contiguous,
-        // i.e. it will correspond to the original ordering according to the variable order
-        // that is chosen and will not be modified apart from removing fixed entries from the maps.
-        std::map<int, int> freeVariableToIndex;
-        std::map<int, int> indexToFreeVariable;
-
     public:
         Node(BAC &, Formulation &, Group *, int, int, const std::set<int> * = 0, const std::set<int> * = 0);
 
@@ -136,10 +183,18 @@ namespace vorpal::nibac {
 
         inline void reportLPSolved() { ++numberLPSolves; }
 
+        inline Basis &getBasis() { return basis; }
+
+        inline const Basis *getAncestorBasis() const { return ancestorBasis; }
+
         inline void setSolutionValue(double psolutionValue) { solutionValue = psolutionValue; }
 
         inline double getSolutionValue() const { return solutionValue; }
 
+        inline void setSolutionEstimate(double psolutionEstimate) { solutionEstimate = psolutionEstimate; }
+
+        inline double getSolutionEstimate() const { return solutionEstimate; }
+
         inline int getDepth() const { return depth; }
 
         inline int getBranchVariableIndex() const { return branchVariableIndex; }
@@ -178,29 +233,34 @@ namespace vorpal::nibac {
 
         inline double *getSolutionVariableArray() { return solutionVariableArray; }
 
-        inline short int *getPartialSolutionArray() { return partialSolutionArray; }
+        // The reduced costs of the branching variables in the last LP solved at the node, in terms
+        // of the objective function of the problem, if the LP solver provided them (see
+        // LPSolver::solveNode). Like the partial solution, they are only valid for the node
+        // being processed.
+        inline bool hasReducedCosts() const { return reducedCostsFlag; }
+
+        inline void setReducedCostsFlag(bool preducedCostsFlag) { reducedCostsFlag = preducedCostsFlag; }
 
-        // TODO: These should probably be const!
-        inline std::set<int> &getFreeVariables() { return freeVariables; }
+        inline double *getReducedCostArray() { return state->reducedCostArray; }
 
-        inline std::set<int> &getFixedVariables() { return fixedVariables; }
+        // The partial solution and the free variables are only valid for the deepest node
+        // in the tree (see State above), which is the one being processed.
+        inline short int *getPartialSolutionArray() { return state->partialSolutionArray; }
+
+        // TODO: This should probably be const!
+        inline VariableSet &getFreeVariables() { return state->freeVariables; }
 
         // Fix a variable in the most basic way.
         inline void fixVariable(int variable, int value) {
-            freeVariables.erase(variable);
-            fixedVariables.insert(variable);
+            state->freeVariables.erase(variable);
             ++numberFixedVariables;
             if (value == 0)
                 ++number0FixedVariables;
-            partialSolutionArray[variable] = value;
+            state->partialSolutionArray[variable] = value;
             formulation.fixVariable(variable, value);
 
-            // Remove the entries from the lookup and reverse lookup maps.
-            std::map<int, int>::iterator iter = freeVariableToIndex.find(variable);
-            assert(iter != freeVariableToIndex.end());
-            assert(indexToFreeVariable.find((*iter).second) != indexToFreeVariable.end());
-            indexToFreeVariable.erase((*iter).second);
-            freeVariableToIndex.erase(iter);
+            // Record the fixing so that it can be undone.
+            state->trail.push_back(variable);
         }
 
         // Return the variable of free index of lowest value with respect to the chosen ordering.
@@ -209,6 +269,12 @@ namespace vorpal::nibac {
         void addCut(Constraint *);
         void removeCut(Constraint *);
 
+        // Add or remove several cuts, which is cheaper for the LP solver than adding or removing
+        // them one by one.
+        void addCuts(std::vector<Constraint *> &);
+
+        void removeCuts(std::vector<Constraint *> &);
+
         // Set the solution value to the partial solution.
         void setSolutionToPartial(void);
 
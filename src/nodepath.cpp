@@ -0,0 +1,87 @@
+/**
+ * nodepath.cpp
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+
+#include <istream>
+#include <ostream>
+#include <vector>
+#include "common.h"
+#include "constraint.h"
+#include "nodepath.h"
+
+namespace vorpal::nibac {
+    void NodePath::addCut(Constraint &constraint) {
+        Cut cut;
+        cut.positions = constraint.getPositions();
+        cut.coefficients = constraint.getCoefficients();
+        cut.lowerBound = constraint.getLowerBound();
+        cut.upperBound = constraint.getUpperBound();
+        cuts.push_back(cut);
+    }
+
+
+    void NodePath::clear() {
+        branchVariables.clear();
+        branchValues.clear();
+        cuts.clear();
+        bound = 0;
+        estimate = 0;
+    }
+
+
+    void NodePath::write(std::ostream &out) const {
+        out << branchVariables.size();
+        for (std::vector<int>::size_type i = 0; i < branchVariables.size(); ++i)
+            out << ' ' << branchVariables[i] << ' ' << branchValues[i];
+        out << ' ' << bound << ' ' << estimate << std::endl;
+
+        out << cuts.size() << std::endl;
+        for (std::vector<Cut>::const_iterator iter = cuts.begin();
+             iter != cuts.end();
+             ++iter) {
+            const Cut &cut = *iter;
+            out << cut.lowerBound << ' ' << cut.upperBound << ' ' << cut.positions.size();
+            for (std::vector<int>::size_type i = 0; i < cut.positions.size(); ++i)
+                out << ' ' << cut.positions[i] << ' ' << cut.coefficients[i];
+            out << std::endl;
+        }
+    }
+
+
+    bool NodePath::read(std::istream &in) {
+        clear();
+
+        int depth;
+        if (!(in >> depth) || depth < 0)
+            return false;
+        for (int i = 0; i < depth; ++i) {
+            int variable, value;
+            if (!(in >> variable >> value))
+                return false;
+            addBranch(variable, value);
+        }
+        if (!(in >> bound >> estimate))
+            return false;
+
+        int numberCuts;
+        if (!(in >> numberCuts) || numberCuts < 0)
+            return false;
+        for (int i = 0; i < numberCuts; ++i) {
+            Cut cut;
+            int size;
+            if (!(in >> cut.lowerBound >> cut.upperBound >> size) || size < 0)
+                return false;
+            for (int j = 0; j < size; ++j) {
+                int position, coefficient;
+                if (!(in >> position >> coefficient))
+                    return false;
+                cut.positions.push_back(position);
+                cut.coefficients.push_back(coefficient);
+            }
+            cuts.push_back(cut);
+        }
+        return true;
+    }
+};
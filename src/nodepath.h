@@ -0,0 +1,86 @@
+/**
+ * nodepath.h
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+// A NodePath describes a node of the branch-and-cut tree independently of
+// the NodeStack holding it: it records the branching decisions that lead to
+// the node from the root, and the cuts that were active there. Replaying
+// the decisions from the root of another tree (see BAC::replay) recreates
+// the node, which allows a subtree to be handed from one search to another.
+
+#ifndef NODEPATH_H
+#define NODEPATH_H
+
+#include <istream>
+#include <ostream>
+#include <vector>
+#include "common.h"
+#include "constraint.h"
+
+namespace vorpal::nibac {
+    class NodePath final {
+    public:
+        // A cut, stored without reference to any formulation so that it can be
+        // recreated in another.
+        struct Cut {
+            std::vector<int> positions;
+            std::vector<int> coefficients;
+            int lowerBound;
+            int upperBound;
+        };
+
+    private:
+        // The branching decisions, from the root down: the variable branched
+        // upon and the value to which it was fixed.
+        std::vector<int> branchVariables;
+        std::vector<int> branchValues;
+
+        // The cuts active at the node.
+        std::vector<Cut> cuts;
+
+        // The LP bound and the estimate of the best solution at the parent of the node,
+        // if known, which are used to order the paths set aside by a NodeSelector.
+        double bound;
+        double estimate;
+
+    public:
+        NodePath() : bound(0), estimate(0) {}
+        virtual ~NodePath() = default;
+
+        // The depth of the node described, i.e. the number of branching decisions.
+        inline int getDepth() const { return branchVariables.size(); }
+
+        inline int getBranchVariable(int depth) const { return branchVariables[depth]; }
+
+        inline int getBranchValue(int depth) const { return branchValues[depth]; }
+
+        inline void addBranch(int variable, int value) {
+            branchVariables.push_back(variable);
+            branchValues.push_back(value);
+        }
+
+        // Record a cut active at the node.
+        void addCut(Constraint &);
+
+        inline const std::vector<Cut> &getCuts() const { return cuts; }
+
+        inline double getBound() const { return bound; }
+
+        inline void setBound(double pbound) { bound = pbound; }
+
+        inline double getEstimate() const { return estimate; }
+
+        inline void setEstimate(double pestimate) { estimate = pestimate; }
+
+        // Empty the path so that it describes the root.
+        void clear();
+
+        // Write the path to a stream, and read a path written in this way, e.g. for a
+        // checkpoint of a search. read returns false if the stream did not contain a path.
+        void write(std::ostream &) const;
+
+        bool read(std::istream &);
+    };
+};
+#endif
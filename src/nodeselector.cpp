@@ -0,0 +1,128 @@
+/**
+ * nodeselector.cpp
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+
+#include <map>
+#include <utility>
+#include <vector>
+#include "common.h"
+#include "formulation.h"
+#include "node.h"
+#include "nodepath.h"
+#include "nodeselector.h"
+#include "nodestack.h"
+#include "variableset.h"
+
+namespace vorpal::nibac {
+    NodeSelector::NodeSelector(Formulation &pformulation, Strategy pstrategy, int pdiveLength)
+            : formulation(pformulation),
+              strategy(pstrategy),
+              diveLength(pdiveLength),
+              diveCount(0) {
+    }
+
+
+    double NodeSelector::getPriority(Node &node) {
+        return toPriority(strategy == BESTESTIMATE ? node.getSolutionEstimate() : node.getSolutionValue());
+    }
+
+
+    double NodeSelector::getPriority(const NodePath &path) {
+        return toPriority(strategy == BESTESTIMATE ? path.getEstimate() : path.getBound());
+    }
+
+
+    void NodeSelector::evaluate(Node &node) {
+        ++diveCount;
+
+        // Rounding a fractional variable to its nearest integer changes the objective by
+        // at least its distance to that integer times its coefficient, and can only make
+        // the solution worse.
+        double estimate = node.getSolutionValue();
+        if (strategy == BESTESTIMATE) {
+            double *solutionVariableArray = node.getSolutionVariableArray();
+            VariableSet &freeVariables = node.getFreeVariables();
+            for (VariableSet::iterator iter = freeVariables.begin();
+                 iter != freeVariables.end();
+                 ++iter) {
+                double value = solutionVariableArray[*iter];
+                if (isint(value))
+                    continue;
+                double distance = (value < 0.5 ? value : 1 - value);
+                double coefficient = formulation.getObjectiveCoefficient(*iter);
+                estimate -= toPriority(distance * fabs(coefficient));
+            }
+        }
+        node.setSolutionEstimate(estimate);
+    }
+
+
+    bool NodeSelector::shouldLeave(NodeStack &nodeStack) {
+        if (strategy == DEPTHFIRST)
+            return false;
+        if (strategy == HYBRID && diveCount < diveLength)
+            return false;
+
+        // The children of an open node have its priority. The first open node is the one
+        // whose subtree would be explored next.
+        std::vector<Node *> nodes;
+        nodeStack.getOpenNodes(nodes);
+        if (nodes.empty())
+            return false;
+        double nextPriority = getPriority(*(nodes.front()));
+
+        if (!pool.empty() && greaterthan((*(pool.rbegin())).first, nextPriority))
+            return true;
+        for (std::vector<Node *>::iterator iter = ++(nodes.begin());
+             iter != nodes.end();
+             ++iter)
+            if (greaterthan(getPriority(**iter), nextPriority))
+                return true;
+        return false;
+    }
+
+
+    void NodeSelector::add(NodePath &path) {
+        double priority = getPriority(path);
+        pool.insert(std::make_pair(priority, std::move(path)));
+    }
+
+
+    bool NodeSelector::select(NodePath &path) {
+        if (pool.empty())
+            return false;
+
+        // Of the subtrees of highest priority, we take the one set aside last, which is
+        // the deepest of those from the same dive.
+        std::multimap<double, NodePath>::iterator iter = --(pool.end());
+        path = std::move((*iter).second);
+        pool.erase(iter);
+        diveCount = 0;
+        return true;
+    }
+
+
+    void NodeSelector::getPaths(std::vector<NodePath> &paths) const {
+        for (std::multimap<double, NodePath>::const_reverse_iterator iter = pool.rbegin();
+             iter != pool.rend();
+             ++iter)
+            paths.push_back((*iter).second);
+    }
+
+
+    const char *NodeSelector::getStrategyName(Strategy strategy) {
+        switch (strategy) {
+            case DEPTHFIRST:
+                return "depth-first";
+            case BESTBOUND:
+                return "best-bound";
+            case BESTESTIMATE:
+                return "best-estimate";
+            case HYBRID:
+                return "hybrid";
+        }
+        return "unknown";
+    }
+};
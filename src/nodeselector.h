@@ -0,0 +1,99 @@
+/**
+ * nodeselector.h
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+// A NodeSelector decides the order in which the open subtrees of the
+// branch-and-cut tree are explored. By default, the tree is explored
+// depth-first using only the NodeStack. The other strategies dive
+// depth-first as long as the subtree that the stack would explore next is at
+// least as promising as any other; when it is not, the open subtrees on the
+// stack are set aside in a pool in the compact form of a NodePath, and the
+// most promising subtree in the pool is recreated (see BAC::replay) and
+// explored instead.
+//
+// The strategies measure how promising a subtree is as follows:
+// BESTBOUND:    the LP bound of its parent.
+// BESTESTIMATE: an estimate of the best integer solution below its parent,
+//               which is the LP bound worsened by the cost of rounding each
+//               fractional variable to its nearest integer.
+// HYBRID:       the LP bound, but we only leave a dive after a fixed number
+//               of nodes, so that good solutions are found early.
+//
+// Strategies other than depth-first need the LP bound, and are only used if
+// LPs are solved at the nodes.
+
+#ifndef NODESELECTOR_H
+#define NODESELECTOR_H
+
+#include <map>
+#include <vector>
+#include "common.h"
+#include "formulation.h"
+#include "node.h"
+#include "nodepath.h"
+#include "nodestack.h"
+
+namespace vorpal::nibac {
+    class NodeSelector {
+    public:
+        enum Strategy {
+            DEPTHFIRST,
+            BESTBOUND,
+            BESTESTIMATE,
+            HYBRID,
+        };
+
+    protected:
+        Formulation &formulation;
+        Strategy strategy;
+        int diveLength;
+
+        // The number of nodes explored since a subtree was last taken from the pool.
+        int diveCount;
+
+        // The subtrees set aside, keyed by priority: the higher, the more promising.
+        std::multimap<double, NodePath> pool;
+
+        // Convert a solution value to a priority, so that higher is always better.
+        inline double toPriority(double value) const {
+            return formulation.getProblemType() == Formulation::MAXIMIZATION ? value : -value;
+        }
+
+        // The priority of a node or of a subtree set aside.
+        virtual double getPriority(Node &);
+
+        virtual double getPriority(const NodePath &);
+
+    public:
+        NodeSelector(Formulation &, Strategy, int);
+
+        virtual ~NodeSelector() = default;
+
+        inline Strategy getStrategy() const { return strategy; }
+
+        // Called for a node that has been processed and whose subtree is still to be
+        // explored, while its LP solution is still available. This records an estimate
+        // of the best solution in the subtree in the node.
+        virtual void evaluate(Node &);
+
+        // Called after a node has been processed: should we leave the dive, setting aside
+        // the subtrees on the stack?
+        virtual bool shouldLeave(NodeStack &);
+
+        // Set aside a subtree.
+        void add(NodePath &);
+
+        // Take the most promising subtree from the pool. Returns false if the pool is empty.
+        bool select(NodePath &);
+
+        inline bool empty() const { return pool.empty(); }
+
+        // Copy the subtrees in the pool, e.g. for a checkpoint of the search.
+        void getPaths(std::vector<NodePath> &) const;
+
+        // The name of a strategy, for output.
+        static const char *getStrategyName(Strategy);
+    };
+};
+#endif
@@ -4,29 +4,85 @@
  * By Sebastian Raaphorst, 2003 - 2018.
  */
 
+#include <map>
+#include <new>
+#include <set>
 #include <vector>
 #include "common.h"
 #include "branchingscheme.h"
+#include "constraint.h"
+#include "formulation.h"
 #include "lpsolver.h"
 #include "node.h"
+#include "nodepath.h"
 #include "statistics.h"
 #include "nodestack.h"
 
 namespace vorpal::nibac {
     NodeStack::NodeStack(BranchingScheme &pbranchingScheme, Node *root, Statistics &pstatistics)
-            : branchingScheme(pbranchingScheme), statistics(pstatistics) {
+            : branchingScheme(pbranchingScheme),
+              statistics(pstatistics),
+              numberBranchingVariables(root->numberBranchingVariables) {
+        assignSolutionVariableArray(root);
         stack.push_back(root);
     }
 
 
     NodeStack::~NodeStack() {
         // We empty out the vector if it isn't already empty
-        Node *n;
-        while (!stack.empty()) {
-            n = stack.back();
-            stack.pop_back();
-            delete n;
-        }
+        while (!stack.empty())
+            pop();
+
+        for (std::vector<void *>::iterator iter = nodeSlots.begin(); iter != nodeSlots.end(); ++iter)
+            ::operator delete(*iter);
+        for (std::vector<double *>::iterator iter = solutionVariableArrays.begin();
+             iter != solutionVariableArrays.end();
+             ++iter)
+            delete[] *iter;
+    }
+
+
+    void NodeStack::reset(Node *root) {
+#ifdef DEBUG
+        assert(stack.empty());
+#endif
+        assignSolutionVariableArray(root);
+        stack.push_back(root);
+    }
+
+
+    Node *NodeStack::push(int variable, int value) {
+        Node *top = stack.back();
+        std::vector<void *>::size_type depth = top->depth + 1;
+        while (nodeSlots.size() <= depth)
+            nodeSlots.push_back(0);
+        if (!nodeSlots[depth])
+            nodeSlots[depth] = ::operator new(sizeof(Node));
+
+        Node *child = new(nodeSlots[depth]) Node(top, variable, value);
+        assignSolutionVariableArray(child);
+        stack.push_back(child);
+        return child;
+    }
+
+
+    void NodeStack::pop() {
+        Node *top = stack.back();
+        stack.pop_back();
+
+        // The root is allocated by the BAC, and every other node in our arena.
+        if (top->depth == 0)
+            delete top;
+        else
+            top->~Node();
+    }
+
+
+    void NodeStack::assignSolutionVariableArray(Node *node) {
+        std::vector<double *>::size_type depth = node->depth;
+        while (solutionVariableArrays.size() <= depth)
+            solutionVariableArrays.push_back(new double[numberBranchingVariables]);
+        node->solutionVariableArray = solutionVariableArrays[depth];
     }
 
 
@@ -38,9 +94,13 @@ namespace vorpal::nibac {
 #ifdef DEBUG
         assert(!stack.empty());
 #endif
-        Node *top = stack.back();
-        stack.pop_back();
-        delete top;
+        pop();
+    }
+
+
+    void NodeStack::clear() {
+        while (!stack.empty())
+            pruneTop();
     }
 
 
@@ -65,8 +125,7 @@ namespace vorpal::nibac {
             // Check if we have fully explored the subtree rooted at this node,
             // and if so, remove it from the tree and continue.
             if (top->nextBranchingVariableValue == -1) {
-                stack.pop_back();
-                delete top;
+                pop();
                 statistics.reportBacktrack();
                 continue;
             }
@@ -75,24 +134,15 @@ namespace vorpal::nibac {
             // determined the branching variable, and if not, find the free variable
             // of lowest index.
             if (top->branchingVariableIndex == -1) {
-                // Get the new branching variable index.
-                top->branchingVariableIndex = branchingScheme.getBranchingVariableIndex(*top);
-
-                // We now no longer need solution information associated with the
-                // node. We delete it to regain memory.
-                top->cleanup();
-
-                // If the branching method returned -1, we could not branch.
-                // This will happen if the node is a leaf. It may also
-                // happen in various other user-defined circumstances.
-                // We pop it, set the parent flags to non-maximal, and proceed.
-                if (top->branchingVariableIndex == -1) {
-                    stack.pop_back();
-                    std::vector<Node *>::reverse_iterator rbeginIter = stack.rbegin();
+                // If we could not branch, we pop the node, set the parent flags to
+                // non-maximal, and proceed.
+                if (!branch(top)) {
+                    statistics.reportLeaf(*top);
+                    std::vector<Node *>::reverse_iterator rbeginIter = stack.rbegin() + 1;
                     std::vector<Node *>::reverse_iterator rendIter = stack.rend();
                     for (; rbeginIter != rendIter; ++rbeginIter)
                         (*rbeginIter)->possiblyMaximalFlag = false;
-                    delete top;
+                    pop();
                     statistics.reportBacktrack();
                     continue;
                 }
@@ -102,12 +152,144 @@ namespace vorpal::nibac {
             // the next branching value. We then loop and allow child to be returned
             // on the next iteration of this loop. We also set the possibility of
             // maximality on the node.
-            Node *child = new Node(top, top->branchingVariableIndex, top->nextBranchingVariableValue);
+            Node *child = push(top->branchingVariableIndex, top->nextBranchingVariableValue);
             child->possiblyMaximalFlag = (top->nextBranchingVariableValue ?
                                           true :
                                           top->possiblyMaximalFlag);
             --(top->nextBranchingVariableValue);
-            stack.push_back(child);
         }
     }
+
+
+    bool NodeStack::branch(Node *node) {
+        // Get the new branching variable index.
+        node->branchingVariableIndex = branchingScheme.getBranchingVariableIndex(*node);
+
+        // If the branching method returned -1, we could not branch.
+        // This will happen if the node is a leaf. It may also
+        // happen in various other user-defined circumstances.
+        // The node keeps its solution information, as donate and
+        // getOpenPaths leave it on the stack for getNextNode, which
+        // asks the branching scheme again.
+        if (node->branchingVariableIndex == -1)
+            return false;
+
+        // We now no longer need solution information associated with the
+        // node. We delete it to regain memory.
+        node->cleanup();
+        return true;
+    }
+
+
+    void NodeStack::getOpenNodes(std::vector<Node *> &nodes) {
+        std::vector<Node *>::reverse_iterator rbeginIter = stack.rbegin();
+        std::vector<Node *>::reverse_iterator rendIter = stack.rend();
+        if (rbeginIter != rendIter && (*rbeginIter)->processedFlag && (*rbeginIter)->branchingVariableIndex == -1) {
+            nodes.push_back(*rbeginIter);
+            ++rbeginIter;
+        }
+        for (; rbeginIter != rendIter; ++rbeginIter)
+            if ((*rbeginIter)->branchingVariableIndex != -1 && (*rbeginIter)->nextBranchingVariableValue >= 0)
+                nodes.push_back(*rbeginIter);
+    }
+
+
+    bool NodeStack::donate(NodePath &path) {
+        if (stack.empty())
+            return false;
+
+        // If the node on the top of the stack has been processed, its children may be given
+        // away as well, so we decide how to branch on it now.
+        Node *top = stack.back();
+        if (top->processedFlag && top->branchingVariableIndex == -1)
+            branch(top);
+
+        // Find the shallowest node that has a child left to create. Nodes deeper in the
+        // stack root smaller subtrees, so this gives away as much work as possible.
+        std::vector<Node *>::size_type index;
+        for (index = 0; index < stack.size(); ++index)
+            if (stack[index]->branchingVariableIndex != -1 && stack[index]->nextBranchingVariableValue >= 0)
+                break;
+        if (index == stack.size())
+            return false;
+
+        // We will not create this child ourselves.
+        Node *node = stack[index];
+        record(index, node->nextBranchingVariableValue, path);
+        --(node->nextBranchingVariableValue);
+        return true;
+    }
+
+
+    void NodeStack::getOpenPaths(std::vector<NodePath> &paths) {
+        if (stack.empty())
+            return;
+
+        Node *top = stack.back();
+        if (top->processedFlag && top->branchingVariableIndex == -1)
+            branch(top);
+
+        // An unprocessed node on the top of the stack is explored first.
+        if (!top->processedFlag) {
+            paths.push_back(NodePath());
+            getTopPath(paths.back());
+        }
+
+        for (std::vector<Node *>::size_type index = stack.size(); index-- > 0;)
+            if (stack[index]->branchingVariableIndex != -1)
+                for (int value = stack[index]->nextBranchingVariableValue; value >= 0; --value) {
+                    paths.push_back(NodePath());
+                    record(index, value, paths.back());
+                }
+    }
+
+
+    void NodeStack::getTopPath(NodePath &path) {
+        // The node has no bound of its own yet, so it is given that of its parent.
+        record(stack.size() - 1, -1, path);
+        if (stack.size() > 1) {
+            path.setBound(stack[stack.size() - 2]->solutionValue);
+            path.setEstimate(stack[stack.size() - 2]->solutionEstimate);
+        }
+    }
+
+
+    void NodeStack::record(std::vector<Node *>::size_type index, int value, NodePath &path) {
+        // Record the branching decisions leading to the child...
+        Node *node = stack[index];
+        for (std::vector<Node *>::size_type i = 1; i <= index; ++i)
+            path.addBranch(stack[i]->branchVariableIndex, stack[i]->branchVariableValue);
+        if (value != -1)
+            path.addBranch(node->branchingVariableIndex, value);
+        path.setBound(node->solutionValue);
+        path.setEstimate(node->solutionEstimate);
+
+        // ...and the cuts made along the way that are still in the formulation.
+        const std::map<unsigned long, Constraint *> &formulationCuts = node->formulation.getCuts();
+        for (std::vector<Node *>::size_type i = 0; i <= index; ++i)
+            for (std::set<Constraint *>::iterator iter = stack[i]->cuts.begin();
+                 iter != stack[i]->cuts.end();
+                 ++iter)
+                if (formulationCuts.find((*iter)->getID()) != formulationCuts.end())
+                    path.addCut(**iter);
+    }
+
+
+    Node *NodeStack::descend(int variable, int value) {
+        Node *top = stack.back();
+        top->processedFlag = true;
+        top->branchingVariableIndex = variable;
+        top->nextBranchingVariableValue = -1;
+        top->cleanup();
+
+        Node *child = push(variable, value);
+        child->processedFlag = true;
+        return child;
+    }
+
+
+    void NodeStack::open(int variable, int value) {
+        // The child is left unprocessed, so that it is returned by getNextNode.
+        descend(variable, value)->processedFlag = false;
+    }
 };
\ No newline at end of file
@@ -20,6 +20,7 @@
 #include "common.h"
 #include "branchingscheme.h"
 #include "node.h"
+#include "nodepath.h"
 #include "statistics.h"
 
 namespace vorpal::nibac {
@@ -29,18 +30,83 @@ namespace vorpal::nibac {
         std::vector<Node *> stack;
         Statistics &statistics;
 
+        // The arena for the nodes and their LP solutions. The stack holds at most one node at
+        // each depth, so the memory for a node below the root, and the array for the solution
+        // of a node, are allocated the first time that a depth is reached and then reused by
+        // every node at that depth for as long as the stack exists. The root is made by the
+        // BAC, and so is allocated as usual.
+        int numberBranchingVariables;
+        std::vector<void *> nodeSlots;
+        std::vector<double *> solutionVariableArrays;
+
+        // Create the child of the node on the top of the stack for the given branching
+        // variable and value in the arena, and push it.
+        Node *push(int, int);
+
+        // Pop the node on the top of the stack, returning its memory to the arena.
+        void pop();
+
+        // Give a node the solution array for its depth.
+        void assignSolutionVariableArray(Node *);
+
+        // Determine the variable on which to branch at a node that has been processed,
+        // returning false if there is none.
+        bool branch(Node *);
+
+        // Record the path to the child with the given value of the node at the given
+        // position in the stack, which must have been branched upon.
+        void record(std::vector<Node *>::size_type, int, NodePath &);
+
     public:
         NodeStack(BranchingScheme &, Node *, Statistics &);
 
         virtual ~NodeStack();
 
+        // Start again from a new root once the stack is empty, keeping the arena.
+        void reset(Node *);
+
         // Prune the most recently visited node from the tree.
         void pruneTop();
 
+        // Prune every node on the stack, leaving nothing to explore.
+        void clear();
+
         // We have no need to manually allow users to push Nodes onto the stack.
         // We can automatically generate children and manage them as needed.
         // This method will return null when there are no further nodes to process.
         Node *getNextNode();
+
+        // The node on the top of the stack.
+        inline Node *getTop() { return stack.back(); }
+
+        // Give an open subtree away to another search: the shallowest node that has a
+        // child left to create is found, the path to that child (and the bound at the
+        // node) is recorded, and the child will not be created here. Returns false if
+        // there is no such node.
+        bool donate(NodePath &);
+
+        // The nodes that have children left to explore, from the top of the stack down,
+        // i.e. in the order in which getNextNode will explore their children. A processed
+        // node on the top of the stack that has not yet been branched upon is included.
+        void getOpenNodes(std::vector<Node *> &);
+
+        // Record a path to every child that is left to create, in the order in which
+        // getNextNode would explore them, so that the search can be continued elsewhere
+        // (e.g. from a checkpoint). The stack is left as it is, apart from deciding how
+        // to branch on the node on the top of the stack if it has been processed.
+        void getOpenPaths(std::vector<NodePath> &);
+
+        // Record the path to the node on the top of the stack, which has not been processed,
+        // with the bound of its parent, e.g. to explore its subtree elsewhere.
+        void getTopPath(NodePath &);
+
+        // These are used to replay a path from the root (see BAC::replay). descend marks the
+        // node on the top of the stack as branched on the given variable, pushes its child
+        // with the given value, and returns it; no other child of the node will be created.
+        // open does the same, but leaves the child to be processed as it is returned by getNextNode.
+        Node *descend(int, int);
+
+        void open(int, int);
     };
 };
 #endif
@@ -0,0 +1,282 @@
+/**
+ * parallelsearch.cpp
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+
+#include <math.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common.h"
+#include "bac.h"
+#include "bacoptions.h"
+#include "cutproducer.h"
+#include "formulation.h"
+#include "node.h"
+#include "nodepath.h"
+#include "nodestack.h"
+#include "parallelsearch.h"
+#include "solutionmanager.h"
+#include "statistics.h"
+
+namespace vorpal::nibac {
+    ParallelSearch::ParallelSearch(BAC &pmaster, int pnumberWorkers)
+            : master(pmaster),
+              numberWorkers(pnumberWorkers),
+              numberIdle(pnumberWorkers - 1),
+              finished(false),
+              numberNodesExplored(0),
+              bestSolutionValue(pmaster.bestSolutionValue),
+              reportedSolutionValue(pmaster.bestSolutionValue) {
+        // We must have a branching scheme defined in order to create the node stacks.
+        if (master.options.getBranchingScheme() == 0)
+            throw NoBranchingSchemeException();
+
+        for (int i = 0; i < numberWorkers; ++i) {
+            Worker *worker = new Worker;
+            worker->options = master.createWorkerOptions();
+            worker->options->getStatistics() = Statistics();
+            worker->bac = 0;
+            worker->formulation = 0;
+            worker->thief = -1;
+            worker->answered = false;
+            worker->hasWork = false;
+            workers.push_back(worker);
+
+            // Replace the cut producers that cannot be shared by private copies,
+            // keeping them in the same order for the statistics. A producer that
+            // can be neither shared nor copied cannot be used by the workers.
+            std::vector<CutProducer *> cutProducers = worker->options->getCutProducers();
+            for (std::vector<CutProducer *>::iterator iter = cutProducers.begin();
+                 iter != cutProducers.end();
+                 ++iter)
+                worker->options->removeCutProducer(*iter);
+            for (std::vector<CutProducer *>::iterator iter = cutProducers.begin();
+                 iter != cutProducers.end();
+                 ++iter) {
+                CutProducer *cutProducer = (*iter)->makeWorkerCopy();
+                if (cutProducer == 0) {
+                    deleteWorkers();
+                    throw IllegalParameterException("BACOptions::NumberThreads", numberWorkers,
+                                                    "a cut producer that cannot be shared or copied "
+                                                    "requires a single thread");
+                }
+                if (cutProducer != *iter)
+                    worker->cutProducers.push_back(cutProducer);
+                worker->options->addCutProducer(cutProducer);
+            }
+            worker->options->getStatistics().setNumberCutProducers(cutProducers.size());
+
+            worker->formulation = new Formulation(master.formulation);
+            worker->bac = master.createWorker(*(worker->formulation), *(worker->options));
+            worker->bac->parallelSearch = this;
+            worker->bac->workerIndex = i;
+        }
+    }
+
+
+    ParallelSearch::~ParallelSearch() {
+        deleteWorkers();
+    }
+
+
+    void ParallelSearch::deleteWorkers() {
+        for (std::vector<Worker *>::iterator iter = workers.begin();
+             iter != workers.end();
+             ++iter) {
+            Worker *worker = *iter;
+
+            // The BAC must go first, as its nodes use the formulation.
+            delete worker->bac;
+            delete worker->formulation;
+            for (std::vector<CutProducer *>::iterator citer = worker->cutProducers.begin();
+                 citer != worker->cutProducers.end();
+                 ++citer)
+                delete *citer;
+            delete worker->options;
+            delete worker;
+        }
+    }
+
+
+    void ParallelSearch::run() {
+        for (int i = 0; i < numberWorkers; ++i)
+            workers[i]->thread = std::thread(&ParallelSearch::work, this, i);
+        for (int i = 0; i < numberWorkers; ++i)
+            workers[i]->thread.join();
+
+        // Gather the results of the workers.
+        Statistics &statistics = master.options.getStatistics();
+        for (int i = 0; i < numberWorkers; ++i)
+            statistics.merge(workers[i]->options->getStatistics());
+        master.bestSolutionValue = bestSolutionValue;
+
+        for (int i = 0; i < numberWorkers; ++i)
+            if (workers[i]->exception)
+                std::rethrow_exception(workers[i]->exception);
+    }
+
+
+    void ParallelSearch::work(int index) {
+        Worker &worker = *(workers[index]);
+        BAC &bac = *(worker.bac);
+
+        try {
+            // The first worker starts at the root, and the others start by waiting for
+            // work to be given to them.
+            bool workingFlag = (index == 0);
+            if (workingFlag)
+                bac.initialize();
+
+            for (;;) {
+                if (!workingFlag) {
+                    if (!acquireWork(index))
+                        return;
+
+                    // If the path cannot be replayed, there is nothing in the subtree to explore.
+                    workingFlag = bac.replay(worker.path);
+                }
+
+                if (workingFlag && !bac.explore()) {
+                    finish();
+                    return;
+                }
+
+                ++numberIdle;
+                workingFlag = false;
+            }
+        } catch (...) {
+            worker.exception = std::current_exception();
+            finish();
+        }
+    }
+
+
+    bool ParallelSearch::acquireWork(int index) {
+        Worker &worker = *(workers[index]);
+        int victim = index;
+
+        for (;;) {
+            refuse(worker);
+            if (finished)
+                return false;
+            if (numberIdle == numberWorkers) {
+                finish();
+                return false;
+            }
+
+            // Ask the next worker in turn, unless someone else is asking already.
+            victim = (victim + 1) % numberWorkers;
+            if (victim == index)
+                continue;
+            int noThief = -1;
+            if (!workers[victim]->thief.compare_exchange_strong(noThief, index)) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Wait for the answer. The worker we asked may itself be waiting for work,
+            // so we keep turning away requests made to us in the meantime.
+            std::unique_lock<std::mutex> lock(worker.answerMutex);
+            while (!worker.answered && !finished) {
+                worker.answerCondition.wait_for(lock, std::chrono::milliseconds(1));
+                lock.unlock();
+                refuse(worker);
+                lock.lock();
+            }
+            if (!worker.answered)
+                return false;
+            worker.answered = false;
+            if (worker.hasWork)
+                return true;
+        }
+    }
+
+
+    bool ParallelSearch::poll(BAC &bac) {
+        if (finished)
+            return false;
+
+        numberNodesExplored.fetch_add(1, std::memory_order_relaxed);
+
+        Worker &worker = *(workers[bac.workerIndex]);
+        if (worker.thief != -1)
+            answer(worker, bac.nodeStack);
+        return true;
+    }
+
+
+    void ParallelSearch::refuse(Worker &worker) {
+        if (worker.thief != -1)
+            answer(worker, 0);
+    }
+
+
+    void ParallelSearch::answer(Worker &worker, NodeStack *nodeStack) {
+        Worker &thief = *(workers[worker.thief]);
+        {
+            std::lock_guard<std::mutex> lock(thief.answerMutex);
+            thief.path.clear();
+            thief.hasWork = (nodeStack != 0 && nodeStack->donate(thief.path));
+
+            // The thief is busy from the moment that work is given to it.
+            if (thief.hasWork)
+                --numberIdle;
+            thief.answered = true;
+        }
+        thief.answerCondition.notify_one();
+        worker.thief = -1;
+    }
+
+
+    void ParallelSearch::finish() {
+        finished = true;
+        for (std::vector<Worker *>::iterator iter = workers.begin();
+             iter != workers.end();
+             ++iter)
+            (*iter)->answerCondition.notify_all();
+    }
+
+
+    void ParallelSearch::reportSolutionValue(int value) {
+        bool maximizationFlag = (master.formulation.getProblemType() == Formulation::MAXIMIZATION);
+        int best = bestSolutionValue.load();
+        while (maximizationFlag ? value > best : value < best)
+            if (bestSolutionValue.compare_exchange_weak(best, value)) {
+                // Record when the best solution value was found, as a search using a single
+                // thread does, unless another worker has already improved upon it. The node
+                // at which it was found has not been counted yet.
+                std::lock_guard<std::mutex> lock(solutionMutex);
+                if (bestSolutionValue.load() == value)
+                    master.options.getStatistics().reportBestSolution(numberNodesExplored.load() + 1);
+                return;
+            }
+    }
+
+
+    void ParallelSearch::reportSolution(Node &node) {
+        std::lock_guard<std::mutex> lock(solutionMutex);
+
+        // A worker checks its solution against the best solution value before reporting
+        // it, but another worker may have found a better one in the meantime. In a search,
+        // only solutions that improve upon those reported are of interest.
+        Formulation::SolutionType solutionType = master.formulation.getSolutionType();
+        if (solutionType == Formulation::SEARCH || solutionType == Formulation::GENERATION) {
+            bool maximizationFlag = (master.formulation.getProblemType() == Formulation::MAXIMIZATION);
+            int value = round(node.getSolutionValue());
+            int bound = (solutionType == Formulation::SEARCH ? reportedSolutionValue : getBestSolutionValue());
+            if (maximizationFlag ? value < bound : value > bound)
+                return;
+            if (solutionType == Formulation::SEARCH && value == bound)
+                return;
+            reportedSolutionValue = value;
+        }
+
+        master.options.getSolutionManager()->newSolution(node);
+    }
+};
@@ -0,0 +1,156 @@
+/**
+ * parallelsearch.h
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+// A ParallelSearch explores the branch-and-cut tree of a BAC with several
+// threads. Each thread runs a worker: a BAC of the same type over its own
+// copy of the formulation (and so its own LP solver), options, and (for
+// MargotBAC) symmetry group, which explores its part of the tree depth-first
+// with its own node stack.
+//
+// Work is balanced by stealing. A worker that runs out of nodes asks another
+// for work; the next time that worker is between nodes, it gives away the
+// shallowest open subtree on its stack as a NodePath (see NodeStack::donate),
+// which the idle worker replays from its own root (see BAC::replay). The
+// search is over when all workers are idle at once, or when a worker finishes
+// early (e.g. a search reaching its bound).
+//
+// The best solution value is shared by all workers so that each can prune
+// against solutions found by the others, and solutions are reported to the
+// solution manager of the original options one at a time. Statistics are kept
+// by each worker and added to those of the original options at the end, except
+// for the point at which the best solution value was found, which is recorded
+// in them directly.
+//
+// The solutions found do not depend on the number of threads, and neither do
+// the nodes explored when no bound is used to prune (e.g. ALLGENERATION without
+// bounds) and the branching scheme is not ranked. When the best solution value
+// is used to prune, as in a SEARCH or a GENERATION, the number of nodes explored
+// depends on when each worker learns of it, which depends on how the threads
+// happen to be scheduled. Pruning only by the solutions that a serial search
+// would have found by then would make it repeatable, but only by having the
+// workers wait for one another in the order of the serial search, and so we
+// accept the variation.
+//
+// The same holds for a RankedBranchingScheme, whose rank vector must be the same
+// over the whole tree, and which is therefore shared by the workers: the rank of a
+// variable is set by whichever worker first branches on it freely, and so the
+// variables branched upon, and the number of nodes explored, depend on the
+// scheduling of the threads even when no bound prunes.
+
+#ifndef PARALLELSEARCH_H
+#define PARALLELSEARCH_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common.h"
+#include "bac.h"
+#include "bacoptions.h"
+#include "cutproducer.h"
+#include "formulation.h"
+#include "node.h"
+#include "nodepath.h"
+#include "nodestack.h"
+
+namespace vorpal::nibac {
+    class ParallelSearch final {
+    private:
+        struct Worker {
+            BAC *bac;
+            Formulation *formulation;
+            BACOptions *options;
+
+            // The private copies of cut producers made for this worker, if any.
+            std::vector<CutProducer *> cutProducers;
+
+            std::thread thread;
+
+            // An exception thrown by the worker, which we rethrow from run.
+            std::exception_ptr exception;
+
+            // The index of a worker that has asked this one for work, or -1 if none.
+            std::atomic<int> thief;
+
+            // The answer to a request for work made by this worker: whether the
+            // answer has arrived, whether it contains work, and if so, the path
+            // to the subtree that was given away.
+            std::mutex answerMutex;
+            std::condition_variable answerCondition;
+            bool answered;
+            bool hasWork;
+            NodePath path;
+        };
+
+        // The BAC that started the search.
+        BAC &master;
+
+        int numberWorkers;
+        std::vector<Worker *> workers;
+
+        // The number of workers that have no work. Work given away is counted by the
+        // worker giving it, so if all workers are idle, there is no work left.
+        std::atomic<int> numberIdle;
+
+        // Set when the search is over.
+        std::atomic<bool> finished;
+
+        // The number of nodes explored by all of the workers so far.
+        std::atomic<unsigned long> numberNodesExplored;
+
+        // The best solution value found by any worker.
+        std::atomic<int> bestSolutionValue;
+
+        // Solutions are reported one at a time; we also keep the value of the last
+        // one reported.
+        std::mutex solutionMutex;
+        int reportedSolutionValue;
+
+    public:
+        ParallelSearch(BAC &, int);
+
+        virtual ~ParallelSearch();
+
+        // Run the search to completion.
+        void run();
+
+        // Called by a worker after each node: count the node, and if another worker has
+        // asked for work, give away part of the tree. Returns false if the search is over.
+        bool poll(BAC &);
+
+        // The best solution value shared by the workers.
+        inline int getBestSolutionValue() const { return bestSolutionValue.load(std::memory_order_relaxed); }
+
+        void reportSolutionValue(int);
+
+        // Report a solution found by a worker to the solution manager.
+        void reportSolution(Node &);
+
+    private:
+        // The main loop of a worker thread.
+        void work(int);
+
+        // Called by an idle worker: ask the others for work until some is given, in
+        // which case its path is in the worker's path and true is returned, or until
+        // the search is over, in which case false is returned.
+        bool acquireWork(int);
+
+        // Tell a worker that has asked this one for work, if any, that it has none.
+        void refuse(Worker &);
+
+        // Answer the request for work made to a worker, giving away a subtree from the
+        // node stack if there is one to give.
+        void answer(Worker &, NodeStack *);
+
+        // End the search.
+        void finish();
+
+        // Delete the workers and what was made for them.
+        void deleteWorkers();
+    };
+};
+#endif
@@ -5,6 +5,7 @@
  */
 #include <assert.h>
 #include <string.h>
+#include <mutex>
 #include "common.h"
 #include "permutationpool.h"
 
@@ -48,6 +49,8 @@ namespace vorpal::nibac {
 #ifndef NOPERMPOOL
 
     int *PermutationPool::newPermutation() {
+        std::lock_guard<std::mutex> lock(poolMutex);
+
         // Check if there are no free permutations, and if that is the case, then allocate more.
         if (freetop < 0) {
             // Create the new pool.
@@ -76,6 +79,7 @@ namespace vorpal::nibac {
 #ifndef NOPERMPOOL
 
     void PermutationPool::freePermutation(int *perm) {
+        std::lock_guard<std::mutex> lock(poolMutex);
         ++freetop;
         assert(freetop < poolsize);
         permpool[freetop] = perm;
@@ -7,6 +7,7 @@
 #ifndef PERMUTATIONPOOL_H
 #define PERMUTATIONPOOL_H
 
+#include <mutex>
 #include "common.h"
 
 namespace vorpal::nibac {
@@ -25,6 +26,9 @@ namespace vorpal::nibac {
         int freetop;
         int poolsize;
         double increasefactor;
+
+        // The pool is shared by the groups of all the workers in a parallel search.
+        std::mutex poolMutex;
 #endif
 
         // Size of permutations.
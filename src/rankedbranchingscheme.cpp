@@ -8,6 +8,8 @@
 #include "rankedbranchingscheme.h"
 #include "nibacexception.h"
 #include "node.h"
+#include "variableset.h"
+#include <mutex>
 #include <set>
 
 namespace vorpal::nibac {
@@ -25,13 +27,15 @@ namespace vorpal::nibac {
 
 
     int RankedBranchingScheme::getBranchingVariableIndex(Node &n) {
+        std::lock_guard<std::mutex> lock(rankMutex);
+
         // Iterate over the free variables and determine the one with minimum value in
         // the rank vector.
         int min = v;
         int variable = -1;
-        std::set<int> &freevars = n.getFreeVariables();
-        std::set<int>::iterator beginIter = freevars.begin();
-        std::set<int>::iterator endIter = freevars.end();
+        VariableSet &freevars = n.getFreeVariables();
+        VariableSet::iterator beginIter = freevars.begin();
+        VariableSet::iterator endIter = freevars.end();
         for (; beginIter != endIter; ++beginIter)
             if (rankvector[*beginIter] < min) {
                 variable = *beginIter;
@@ -45,7 +49,7 @@ namespace vorpal::nibac {
         variable = chooseBranchingVariableIndex(n);
         if (variable == -1 && !n.getFreeVariables().empty())
             throw UnexpectedResultException("Branching scheme chose no variable, but free variables exist");
-        if (n.getFreeVariables().find(variable) == n.getFreeVariables().end())
+        if (!n.getFreeVariables().contains(variable))
             throw UnexpectedResultException("Branching scheme chose a free variable not in the node's free list");
 
         // Modify the rank vector and the index.
@@ -7,6 +7,7 @@
 #ifndef RANKEDBRANCHINGSCHEME_H
 #define RANKEDBRANCHINGSCHEME_H
 
+#include <mutex>
 #include "branchingscheme.h"
 #include "common.h"
 
@@ -26,6 +27,11 @@ namespace vorpal::nibac {
         int index;
         int *rankvector;
 
+        // The rank vector must be consistent over the whole tree, so the workers of a
+        // parallel search share it. The order in which they extend it, and so the
+        // branching, then depends on the scheduling of the threads.
+        std::mutex rankMutex;
+
     protected:
         // The constructor now requires the number of variables in the problem
         // in order to allocate the rank vector.
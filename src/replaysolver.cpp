@@ -0,0 +1,103 @@
+/**
+ * replaysolver.cpp
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+
+#include <vector>
+#include "common.h"
+#include "bac.h"
+#include "bacoptions.h"
+#include "constraint.h"
+#include "formulation.h"
+#include "lptrace.h"
+#include "nibacexception.h"
+#include "node.h"
+#include "replaysolver.h"
+
+#ifdef DEBUG
+#include <iostream>
+#endif
+
+namespace vorpal::nibac {
+    LPSolver *ReplaySolver::makeInstance() {
+        return new ReplaySolver();
+    }
+
+
+    void ReplaySolver::setupFormulation(Formulation &f) {
+        // The trace is the data of the formulation. It is opened when the first LP is
+        // solved, as the options naming it are only available then.
+        f.setData((void *) 0);
+    }
+
+
+    void ReplaySolver::cleanupFormulation(Formulation &f) {
+        LPTrace *trace = (LPTrace *) f.getData();
+        delete trace;
+        f.setData((void *) 0);
+    }
+
+
+    void ReplaySolver::setObjectiveFunction(Formulation &, std::vector<int> &, int, int) {
+    }
+
+
+    void ReplaySolver::addConstraint(Formulation &, Constraint *) {
+    }
+
+
+    void ReplaySolver::removeConstraint(Formulation &, Constraint *) {
+    }
+
+
+    void ReplaySolver::addCut(Formulation &, Constraint *) {
+    }
+
+
+    void ReplaySolver::removeCut(Formulation &, Constraint *) {
+    }
+
+
+    void ReplaySolver::fixVariable(Formulation &, int, int) {
+    }
+
+
+    void ReplaySolver::unfixVariable(Formulation &, int) {
+    }
+
+
+    int ReplaySolver::solveNode(BAC &bac, Node &n, bool) {
+        Formulation &f = bac.getFormulation();
+        LPTrace *trace = (LPTrace *) f.getData();
+        if (!trace) {
+            const char *fileName = bac.getOptions().getLPReplayFileName();
+            if (!fileName)
+                throw MissingDataException("ReplaySolver requires an LP replay file.");
+            trace = new LPTrace(fileName, f, false);
+            f.setData((void *) trace);
+        }
+        return trace->read(n);
+    }
+
+
+    void *ReplaySolver::createConstraint(Formulation &, std::vector<int> &, std::vector<int> &, int, int) {
+        return (void *) 0;
+    }
+
+
+    void ReplaySolver::deleteConstraint(void *) {
+    }
+
+
+#ifdef DEBUG
+    void ReplaySolver::printVariables(Formulation &) {
+        std::cerr << "ReplaySolver has no variables to print." << std::endl;
+    }
+#endif
+
+
+    // Create a static instance of ReplaySolver; this will be assigned as the static
+    // instance in LPSolver and used to create the solvers for formulations.
+    ReplaySolver ReplaySolver::_replaysolver;
+};
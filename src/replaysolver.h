@@ -0,0 +1,75 @@
+/**
+ * replaysolver.h
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+
+#ifndef REPLAYSOLVER_H
+#define REPLAYSOLVER_H
+
+#include <limits.h>
+#include <vector>
+#include "common.h"
+#include "lpsolver.h"
+
+namespace vorpal::nibac {
+    // Class forwards
+    class BAC;
+    class Constraint;
+    class Formulation;
+    class LPTrace;
+    class Node;
+
+    /**
+     * An LP solver that solves nothing: it plays back the results of the LPs of an earlier run of the same
+     * search, as recorded in an LPTrace (see BACOptions::getLPRecordFileName), from the file given as the LP
+     * replay file. The search then takes exactly the same path as it did, with the cost of the LPs all but
+     * removed, so that the time spent in the rest of the branch-and-cut (nodes, symmetry, cuts) can be
+     * measured on its own. Simply link it in instead of another solver.
+     *
+     * As the results do not depend on the formulation, the constraints, cuts and fixings given to this solver
+     * are ignored.
+     */
+    class ReplaySolver final : public LPSolver {
+    private:
+        static ReplaySolver _replaysolver;
+
+    protected:
+        ReplaySolver() = default;
+
+    public:
+        virtual ~ReplaySolver() = default;
+
+        virtual LPSolver *makeInstance();
+
+        virtual void setupFormulation(Formulation &);
+
+        virtual void cleanupFormulation(Formulation &);
+
+        virtual void setObjectiveFunction(Formulation &, std::vector<int> &, int= INT_MIN, int= INT_MAX);
+
+        virtual void addConstraint(Formulation &, Constraint *);
+
+        virtual void removeConstraint(Formulation &, Constraint *);
+
+        virtual void addCut(Formulation &, Constraint *);
+
+        virtual void removeCut(Formulation &, Constraint *);
+
+        virtual void fixVariable(Formulation &, int, int);
+
+        virtual void unfixVariable(Formulation &, int);
+
+        virtual int solveNode(BAC &, Node &, bool= false);
+
+        void *createConstraint(Formulation &, std::vector<int> &, std::vector<int> &, int, int);
+
+        void deleteConstraint(void *);
+
+#ifdef DEBUG
+        void printVariables(Formulation &);
+#endif
+    };
+};
+
+#endif
@@ -37,43 +37,52 @@ static int slowcanoncalls = 0;
 
 namespace vorpal::nibac {
 // Static initializaters.
-    int *SchreierSimsGroup::tmpperm1 = 0;
-    int *SchreierSimsGroup::tmpperm2 = 0;
-    std::vector<int *> SchreierSimsGroup::rstack;
-    bool *SchreierSimsGroup::used = 0;
-    int *SchreierSimsGroup::remain = 0;
-    int *SchreierSimsGroup::pos = 0;
-    int **SchreierSimsGroup::hperms = 0;
-    int **SchreierSimsGroup::locperms = 0;
-    std::vector<int> SchreierSimsGroup::Jk;
-    std::map<int, int *>::iterator *SchreierSimsGroup::mapiters = 0;
+    thread_local int *SchreierSimsGroup::tmpperm1 = 0;
+    thread_local int *SchreierSimsGroup::tmpperm2 = 0;
+    thread_local std::vector<int *> SchreierSimsGroup::rstack;
+    thread_local bool *SchreierSimsGroup::used = 0;
+    thread_local int *SchreierSimsGroup::remain = 0;
+    thread_local int *SchreierSimsGroup::pos = 0;
+    thread_local int **SchreierSimsGroup::hperms = 0;
+    thread_local int **SchreierSimsGroup::locperms = 0;
+    thread_local std::vector<int> SchreierSimsGroup::Jk;
+    thread_local std::map<int, int *>::iterator *SchreierSimsGroup::mapiters = 0;
+    thread_local SchreierSimsGroup::WorkspaceGuard SchreierSimsGroup::workspaceGuard;
 
 
     void SchreierSimsGroup::initialize(int basesetsize) {
         GeneratedGroup::initialize(basesetsize);
+        initializeWorkspace();
+    }
+
+
+    void SchreierSimsGroup::initializeWorkspace() {
         tmpperm1 = pool->newPermutation();
         tmpperm2 = pool->newPermutation();
         rstack.reserve(1000);
-        used = new bool[basesetsize];
-        for (int i = 0; i < basesetsize; ++i)
+        used = new bool[x];
+        for (int i = 0; i < x; ++i)
             used[i] = false;
-        remain = new int[basesetsize];
-        pos = new int[basesetsize + 1];
+        remain = new int[x];
+        pos = new int[x + 1];
         pos[0] = -1;
-        hperms = new int *[basesetsize + 1];
-        locperms = new int *[basesetsize + 1];
-        for (int i = 0; i <= basesetsize; ++i) {
+        hperms = new int *[x + 1];
+        locperms = new int *[x + 1];
+        for (int i = 0; i <= x; ++i) {
             hperms[i] = pool->newPermutation();
             locperms[i] = pool->newPermutation();
         }
         getIdentityPermutation(hperms[0]);
         getIdentityPermutation(locperms[0]);
-        Jk.reserve(basesetsize);
-        mapiters = new std::map<int, int *>::iterator[basesetsize];
+        Jk.reserve(x);
+        mapiters = new std::map<int, int *>::iterator[x];
+
+        // Make sure that this thread gives back its workspace when it exits.
+        workspaceGuard.active = true;
     }
 
 
-    void SchreierSimsGroup::destroy() {
+    void SchreierSimsGroup::destroyWorkspace() {
         delete[] mapiters;
 
         // Delete the things we used in the canonicity backtracking.
@@ -90,6 +99,18 @@ namespace vorpal::nibac {
         // Return the work permutations to the pool.
         pool->freePermutation(tmpperm1);
         pool->freePermutation(tmpperm2);
+        tmpperm1 = tmpperm2 = 0;
+    }
+
+
+    SchreierSimsGroup::WorkspaceGuard::~WorkspaceGuard() {
+        if (active && tmpperm1)
+            destroyWorkspace();
+    }
+
+
+    void SchreierSimsGroup::destroy() {
+        destroyWorkspace();
 
 #ifdef MARGOTTIMERS
         std::cerr << "Down: " << downtime << ", " << downcalls << std::endl;
@@ -197,6 +218,7 @@ namespace vorpal::nibac {
 
 
     int SchreierSimsGroup::test(int *p, int first) {
+        checkWorkspace();
         for (int i = first; i < x; ++i) {
             if (base[i] == p[base[i]])
                 // This is the identity, so ignore
@@ -305,6 +327,7 @@ namespace vorpal::nibac {
 #ifdef MARGOTTIMERS
         entertime.start();
 #endif
+        checkWorkspace();
 
         // We first determine if the permutation needs to be copied, and
         // if so, we do so.
@@ -554,6 +577,7 @@ namespace vorpal::nibac {
 
         // One of the flags needs to be set or this call makes no sense.
         assert(canonflag || orbflag);
+        checkWorkspace();
 
         // If we need to, move p to B[k]. This must be done for both canon and orbit
         // calculations.
@@ -752,10 +776,11 @@ namespace vorpal::nibac {
         // something lexicographically smaller. We use an STL vector to store the permuted
         // elements in a stored fashion.
         std::vector<int> sorted;
+        checkWorkspace();
 
-        // Some static members that we need.
-        static int index, indexp1;
-        static std::vector<int>::iterator iter;
+        // Some members that we need.
+        int index, indexp1;
+        std::vector<int>::iterator iter;
 
 #ifdef MARGOTTIMERS
         ++slowcanoncalls;
@@ -767,7 +792,7 @@ namespace vorpal::nibac {
         remain[0] = 0;
 
         // Initialize the first map iterator.
-        static std::map<int, int *>::iterator mendIter;
+        std::map<int, int *>::iterator mendIter;
         mapiters[0] = lists[base[0]].begin();
 
         // Begin the backtracking.
@@ -849,7 +874,7 @@ namespace vorpal::nibac {
 
     int SchreierSimsGroup::insertSorted(int elem, std::vector<int> &elems) {
         // Binary search the elems for the proper position to insert.
-        static int firstpos, lastpos, epos;
+        int firstpos, lastpos, epos = 0;
 
         // If there are no items in elem, we simply insert this element.
         if (!elems.size()) {
@@ -880,7 +905,7 @@ namespace vorpal::nibac {
 
     void SchreierSimsGroup::removeSorted(int elem, std::vector<int> &elems) {
         // Binary search the elems for the proper position to insert.
-        static int firstpos, lastpos, epos;
+        int firstpos, lastpos, epos;
 
         // The set cannot be empty.
         assert(elems.size() > 0);
@@ -907,29 +932,28 @@ namespace vorpal::nibac {
         // TODO: This was assert(true). Why?
         assert(false);
     }
-};
-#ifdef NODEGROUPS
-Group *SchreierSimsGroup::makeCopy()
-{
-  int *p;
-  SchreierSimsGroup *newgroup = new SchreierSimsGroup(base, baseinv);
-
-  // Make copies of all the permutations and insert them into the new group.
-  std::map< int, int* >::iterator beginIter, endIter;
-  for (int i=0; i < x; ++i) {
-    beginIter = lists[i].begin();
-    endIter   = lists[i].end();
-    for (; beginIter != endIter; ++beginIter) {
-      p = pool->newPermutation();
-      memcpy(p, (*beginIter).second, memsize);
-      (newgroup->lists[i])[(*beginIter).first] = p;
+
+
+    Group *SchreierSimsGroup::makeCopy() {
+        int *p;
+        SchreierSimsGroup *newgroup = new SchreierSimsGroup(base, baseinv);
+
+        // Make copies of all the permutations and insert them into the new group.
+        std::map<int, int *>::iterator beginIter, endIter;
+        for (int i = 0; i < x; ++i) {
+            beginIter = lists[i].begin();
+            endIter = lists[i].end();
+            for (; beginIter != endIter; ++beginIter) {
+                p = pool->newPermutation();
+                memcpy(p, (*beginIter).second, memsize);
+                (newgroup->lists[i])[(*beginIter).first] = p;
 #ifdef USEUSETS
-      // NOT ADVISABLE TO USE USETS WITH NODEGROUPS! This will consume huge amounts of RAM.
-      usets[i][(*beginIter).first] = p;
+                // NOT ADVISABLE TO USE USETS WITH NODEGROUPS! This will consume huge amounts of RAM.
+                newgroup->usets[i][(*beginIter).first] = p;
 #endif
-    }
-  }
+            }
+        }
 
-  return newgroup;
-}
-#endif
+        return newgroup;
+    }
+};
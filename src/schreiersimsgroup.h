@@ -40,31 +40,57 @@ namespace vorpal::nibac {
         int *baseinv;
 
         // Temporary workspace permutations.
-        static int *tmpperm1, *tmpperm2;
+        // All of the workspace below is per thread so that the groups of the workers of a
+        // parallel search may be used concurrently; see initializeWorkspace.
+        static thread_local int *tmpperm1, *tmpperm2;
 
         // We simulate recursion by maintaining a stack of permutations.
         // There is no advantage to using an STL stack to do this over a
         // vector, so we'll simply go with a vector.
-        static std::vector<int *> rstack;
+        static thread_local std::vector<int *> rstack;
 
         // These variables are used by the backtracking for testing canonicity
         // and determining orbits in stabilizers. We declare them here and
         // initialize them in the constructor to avoid repeating this work
         // for every call. They are static since we do not need an individual
         // set for each group.
-        static bool *used;
-        static int *remain;
-        static int *pos;
-        static int **hperms;
-        static int **locperms;
-        static std::vector<int> Jk;
-        static std::map<int, int *>::iterator *mapiters;
+        static thread_local bool *used;
+        static thread_local int *remain;
+        static thread_local int *pos;
+        static thread_local int **hperms;
+        static thread_local int **locperms;
+        static thread_local std::vector<int> Jk;
+        static thread_local std::map<int, int *>::iterator *mapiters;
 
     public:
         static void initialize(int);
 
         static void destroy();
 
+    protected:
+        // Allocate the workspace above for the calling thread. This is done by initialize
+        // for the thread that calls it, and lazily for any other thread that uses a group,
+        // in which case the workspace is released when the thread exits.
+        static void initializeWorkspace();
+
+        static void destroyWorkspace();
+
+        inline static void checkWorkspace() {
+            if (!tmpperm1)
+                initializeWorkspace();
+        }
+
+    private:
+        // Releases a lazily allocated workspace when its thread exits.
+        struct WorkspaceGuard {
+            bool active = false;
+
+            ~WorkspaceGuard();
+        };
+
+        static thread_local WorkspaceGuard workspaceGuard;
+
+    public:
         SchreierSimsGroup(int * = 0, int * = 0);
 
         virtual ~SchreierSimsGroup();
@@ -112,9 +138,7 @@ namespace vorpal::nibac {
         // Returns the size of the group.
         unsigned long getSize(void);
 
-#ifdef NODEGROUPS
         virtual Group *makeCopy();
-#endif
 
     private:
 #ifdef DEBUG
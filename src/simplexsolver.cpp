@@ -0,0 +1,991 @@
+/**
+ * simplexsolver.cpp
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+
+#include <math.h>
+#include <assert.h>
+#include <float.h>
+#include <limits.h>
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
+#include "common.h"
+#include "bac.h"
+#include "bacoptions.h"
+#include "constraint.h"
+#include "formulation.h"
+#include "node.h"
+#include "simplexsolver.h"
+
+#ifdef DEBUG
+#include <iostream>
+#endif
+
+namespace vorpal::nibac {
+    const double SimplexSolver::PRIMAL_TOLERANCE = 1e-7;
+    const double SimplexSolver::DUAL_TOLERANCE = 1e-7;
+    const double SimplexSolver::PIVOT_TOLERANCE = 1e-7;
+    const double SimplexSolver::DROP_TOLERANCE = 1e-12;
+    const double SimplexSolver::PERTURBATION = 1e-6;
+    const int SimplexSolver::REFACTOR_INTERVAL = 64;
+
+
+    LPSolver *SimplexSolver::makeInstance() {
+        // All of the state for a formulation is kept in its data, so there is
+        // nothing to share between instances.
+        return new SimplexSolver();
+    }
+
+
+    void SimplexSolver::setupFormulation(Formulation &f) {
+        SimplexInfo *info = new SimplexInfo;
+        int numberVariables = f.getNumberVariables();
+        info->numberVariables = numberVariables;
+        info->cost.assign(numberVariables, 0.0);
+        info->perturbation.assign(numberVariables, 0.0);
+        info->perturbationTotal = 0;
+        info->perturbedFlag = false;
+        info->cutoff = DBL_MAX;
+        info->maximizationFlag = false;
+
+        // Every structural variable starts out free, i.e. in [0,1], and at its lower bound.
+        info->lower.assign(numberVariables, 0.0);
+        info->upper.assign(numberVariables, 1.0);
+        info->status.assign(numberVariables, LOWER);
+
+        info->rowsChangedFlag = true;
+        info->factoredFlag = false;
+        info->numberUpdates = 0;
+        info->reduceFlag = false;
+        info->fixingsChangedFlag = true;
+        f.setData((void *) info);
+    }
+
+
+    void SimplexSolver::cleanupFormulation(Formulation &f) {
+        SimplexInfo *info = (SimplexInfo *) f.getData();
+        delete info;
+        f.setData((void *) 0);
+    }
+
+
+    void SimplexSolver::setObjectiveFunction(Formulation &f, std::vector<int> &objectivecoefficients,
+                                             int lbound, int ubound) {
+        SimplexInfo *info = (SimplexInfo *) f.getData();
+        info->maximizationFlag = (f.getProblemType() == Formulation::MAXIMIZATION);
+
+        int i = 0;
+        for (std::vector<int>::iterator iter = objectivecoefficients.begin();
+             iter != objectivecoefficients.end();
+             ++iter, ++i)
+            info->cost[i] = (info->maximizationFlag ? -(*iter) : *iter);
+
+        // Each cost is moved away from zero by between one and two times PERTURBATION, by an amount that
+        // is scrambled from its index, so that the perturbation is the same from run to run.
+        info->perturbationTotal = 0;
+        for (i = 0; i < info->numberVariables; ++i) {
+            double amount = PERTURBATION * (1 + ((i * 2654435761u) >> 16) % 1024 / 1024.0);
+            info->perturbation[i] = (info->cost[i] < 0 ? -amount : amount);
+            info->perturbationTotal += amount;
+        }
+
+        // Only the bound in the direction of optimization can cut an LP off.
+        if (info->maximizationFlag)
+            info->cutoff = (lbound == INT_MIN ? DBL_MAX : -lbound + EPSILON);
+        else
+            info->cutoff = (ubound == INT_MAX ? DBL_MAX : ubound + EPSILON);
+    }
+
+
+    void SimplexSolver::setObjectiveCutoff(Formulation &f, int cutoff) {
+        SimplexInfo *info = (SimplexInfo *) f.getData();
+        double value = (info->maximizationFlag ? -cutoff + EPSILON : cutoff + EPSILON);
+        if (value < info->cutoff)
+            info->cutoff = value;
+    }
+
+
+    void SimplexSolver::addConstraint(Formulation &f, Constraint *c) {
+        SimplexInfo *info = (SimplexInfo *) f.getData();
+        std::vector<Constraint *> constraints(1, c);
+        addRows(info, constraints);
+    }
+
+
+    void SimplexSolver::removeConstraint(Formulation &f, Constraint *c) {
+        SimplexInfo *info = (SimplexInfo *) f.getData();
+        std::vector<Constraint *> constraints(1, c);
+        deleteRows(info, constraints);
+    }
+
+
+    void SimplexSolver::addCut(Formulation &f, Constraint *c) {
+        addConstraint(f, c);
+    }
+
+
+    void SimplexSolver::removeCut(Formulation &f, Constraint *c) {
+        removeConstraint(f, c);
+    }
+
+
+    void SimplexSolver::addCuts(Formulation &f, std::vector<Constraint *> &cuts) {
+        SimplexInfo *info = (SimplexInfo *) f.getData();
+        addRows(info, cuts);
+    }
+
+
+    void SimplexSolver::removeCuts(Formulation &f, std::vector<Constraint *> &cuts) {
+        SimplexInfo *info = (SimplexInfo *) f.getData();
+        deleteRows(info, cuts);
+    }
+
+
+    void SimplexSolver::addRows(SimplexInfo *info, std::vector<Constraint *> &constraints) {
+        if (constraints.empty())
+            return;
+
+        // The logical variables of new rows are basic, so that the basis remains dual feasible.
+        for (std::vector<Constraint *>::iterator iter = constraints.begin();
+             iter != constraints.end();
+             ++iter) {
+            Constraint *c = *iter;
+            info->rows.push_back(c);
+            c->setImplementation((void *) (long) info->rows.size());
+            info->lower.push_back(c->getLowerBound() == INT_MIN ? -DBL_MAX : c->getLowerBound());
+            info->upper.push_back(c->getUpperBound() == INT_MAX ? DBL_MAX : c->getUpperBound());
+            info->status.push_back(BASIC);
+        }
+        info->rowsChangedFlag = true;
+        info->factoredFlag = false;
+    }
+
+
+    void SimplexSolver::deleteRows(SimplexInfo *info, std::vector<Constraint *> &constraints) {
+        if (constraints.empty())
+            return;
+
+        for (std::vector<Constraint *>::iterator iter = constraints.begin();
+             iter != constraints.end();
+             ++iter) {
+            int row = (int) (long) ((*iter)->getImplementation()) - 1;
+            if (row < 0) {
+                // The row was set aside, and is simply forgotten.
+                std::vector<Constraint *>::iterator dropped = std::find(info->droppedRows.begin(),
+                                                                        info->droppedRows.end(), *iter);
+                assert(dropped != info->droppedRows.end());
+                info->droppedRows.erase(dropped);
+                continue;
+            }
+            assert(row < (int) info->rows.size() && info->rows[row] == *iter);
+            info->rows[row] = 0;
+            (*iter)->setImplementation((void *) 0);
+        }
+
+        // The remaining rows keep their order, and move up to fill the gaps, along with their
+        // logical variables. If a logical variable that was nonbasic is deleted, the basis is left
+        // with too many basic variables, which factorize will take care of.
+        int n = info->numberVariables;
+        int row = 0;
+        for (int i = 0; i < (int) info->rows.size(); ++i)
+            if (info->rows[i]) {
+                info->rows[row] = info->rows[i];
+                info->rows[row]->setImplementation((void *) (long) (row + 1));
+                info->lower[n + row] = info->lower[n + i];
+                info->upper[n + row] = info->upper[n + i];
+                info->status[n + row] = info->status[n + i];
+                ++row;
+            }
+        info->rows.resize(row);
+        info->lower.resize(n + row);
+        info->upper.resize(n + row);
+        info->status.resize(n + row);
+        info->rowsChangedFlag = true;
+        info->factoredFlag = false;
+    }
+
+
+    void SimplexSolver::fixVariable(Formulation &f, int var, int val) {
+        SimplexInfo *info = (SimplexInfo *) f.getData();
+
+        // A variable fixed by a row is now fixed by BAC, and must stay fixed.
+        if (!info->forcedColumns.empty()) {
+            std::vector<int>::iterator forced = std::find(info->forcedColumns.begin(), info->forcedColumns.end(), var);
+            if (forced != info->forcedColumns.end())
+                info->forcedColumns.erase(forced);
+        }
+        info->lower[var] = val;
+        info->upper[var] = val;
+        if (info->status[var] != BASIC)
+            info->status[var] = LOWER;
+        if (info->reduceFlag)
+            info->fixingsChangedFlag = true;
+    }
+
+
+    void SimplexSolver::unfixVariable(Formulation &f, int var) {
+        SimplexInfo *info = (SimplexInfo *) f.getData();
+        if (info->status[var] != BASIC)
+            info->status[var] = (info->lower[var] > 0.5 ? UPPER : LOWER);
+        info->lower[var] = 0.0;
+        info->upper[var] = 1.0;
+        if (info->reduceFlag)
+            info->fixingsChangedFlag = true;
+    }
+
+
+    void SimplexSolver::refreshRows(SimplexInfo *info) {
+        int n = info->numberVariables;
+
+        // Count the entries of each column, and then fill them in, row by row.
+        info->columnStart.assign(n + 1, 0);
+        for (std::vector<Constraint *>::iterator iter = info->rows.begin();
+             iter != info->rows.end();
+             ++iter) {
+            std::vector<int> &positions = (*iter)->getPositions();
+            for (std::vector<int>::iterator piter = positions.begin();
+                 piter != positions.end();
+                 ++piter)
+                ++(info->columnStart[*piter + 1]);
+        }
+        for (int j = 0; j < n; ++j)
+            info->columnStart[j + 1] += info->columnStart[j];
+        info->columnRow.resize(info->columnStart[n]);
+        info->columnValue.resize(info->columnStart[n]);
+
+        std::vector<int> next(info->columnStart.begin(), info->columnStart.end() - 1);
+        for (int i = 0; i < (int) info->rows.size(); ++i) {
+            std::vector<int> &positions = info->rows[i]->getPositions();
+            std::vector<int> &coefficients = info->rows[i]->getCoefficients();
+            for (int k = 0; k < (int) positions.size(); ++k) {
+                int entry = next[positions[k]]++;
+                info->columnRow[entry] = i;
+                info->columnValue[entry] = coefficients[k];
+            }
+        }
+
+        int total = n + info->rows.size();
+        info->x.assign(total, 0.0);
+        info->d.assign(total, 0.0);
+        info->alpha.assign(total, 0.0);
+        info->rowsChangedFlag = false;
+        info->fixingsChangedFlag = true;
+    }
+
+
+    void SimplexSolver::refreshFixings(SimplexInfo *info) {
+        int n = info->numberVariables;
+
+        info->freeColumns.clear();
+        for (int j = 0; j < n; ++j)
+            if (!info->reduceFlag || info->lower[j] != info->upper[j])
+                info->freeColumns.push_back(j);
+
+        info->rowStart.assign(1, 0);
+        info->rowColumn.clear();
+        info->rowValue.clear();
+        for (std::vector<Constraint *>::iterator iter = info->rows.begin();
+             iter != info->rows.end();
+             ++iter) {
+            std::vector<int> &positions = (*iter)->getPositions();
+            std::vector<int> &coefficients = (*iter)->getCoefficients();
+            for (int k = 0; k < (int) positions.size(); ++k)
+                if (!info->reduceFlag || info->lower[positions[k]] != info->upper[positions[k]]) {
+                    info->rowColumn.push_back(positions[k]);
+                    info->rowValue.push_back(coefficients[k]);
+                }
+            info->rowStart.push_back(info->rowColumn.size());
+        }
+        info->fixingsChangedFlag = false;
+    }
+
+
+    void SimplexSolver::getActivityRange(SimplexInfo *info, Constraint *c, double &minimum, double &maximum) {
+        minimum = 0;
+        maximum = 0;
+        std::vector<int> &positions = c->getPositions();
+        std::vector<int> &coefficients = c->getCoefficients();
+        for (int k = 0; k < (int) positions.size(); ++k) {
+            int j = positions[k];
+            if (coefficients[k] > 0) {
+                minimum += coefficients[k] * info->lower[j];
+                maximum += coefficients[k] * info->upper[j];
+            } else {
+                minimum += coefficients[k] * info->upper[j];
+                maximum += coefficients[k] * info->lower[j];
+            }
+        }
+    }
+
+
+    bool SimplexSolver::isRedundant(SimplexInfo *info, Constraint *c) {
+        double minimum, maximum;
+        getActivityRange(info, c, minimum, maximum);
+        return (c->getLowerBound() == INT_MIN || minimum >= c->getLowerBound() - PRIMAL_TOLERANCE)
+               && (c->getUpperBound() == INT_MAX || maximum <= c->getUpperBound() + PRIMAL_TOLERANCE);
+    }
+
+
+    void SimplexSolver::fixForcedColumns(SimplexInfo *info) {
+        // If the least value that a row can take is its upper bound, every free variable must be at the
+        // bound that gives it, and similarly for the greatest value and the lower bound. This does not
+        // change the LP, so the variables need not be fixed by BAC, and are released at the next node.
+        double minimum, maximum;
+        for (std::vector<Constraint *>::iterator iter = info->rows.begin();
+             iter != info->rows.end();
+             ++iter) {
+            Constraint *c = *iter;
+            getActivityRange(info, c, minimum, maximum);
+            bool lowerFlag = (c->getUpperBound() != INT_MAX && fabs(minimum - c->getUpperBound()) <= PRIMAL_TOLERANCE);
+            bool upperFlag = (c->getLowerBound() != INT_MIN && fabs(maximum - c->getLowerBound()) <= PRIMAL_TOLERANCE);
+            if (!lowerFlag && !upperFlag)
+                continue;
+
+            std::vector<int> &positions = c->getPositions();
+            std::vector<int> &coefficients = c->getCoefficients();
+            for (int k = 0; k < (int) positions.size(); ++k) {
+                int j = positions[k];
+                if (info->lower[j] == info->upper[j])
+                    continue;
+                if ((coefficients[k] > 0) == lowerFlag)
+                    info->upper[j] = info->lower[j];
+                else
+                    info->lower[j] = info->upper[j];
+                if (info->status[j] != BASIC)
+                    info->status[j] = LOWER;
+                info->forcedColumns.push_back(j);
+                info->fixingsChangedFlag = true;
+            }
+        }
+    }
+
+
+    void SimplexSolver::releaseForcedColumns(SimplexInfo *info) {
+        for (std::vector<int>::iterator iter = info->forcedColumns.begin();
+             iter != info->forcedColumns.end();
+             ++iter) {
+            int j = *iter;
+            if (info->status[j] != BASIC)
+                info->status[j] = (info->lower[j] > 0.5 ? UPPER : LOWER);
+            info->lower[j] = 0.0;
+            info->upper[j] = 1.0;
+            info->fixingsChangedFlag = true;
+        }
+        info->forcedColumns.clear();
+    }
+
+
+    void SimplexSolver::restoreRows(SimplexInfo *info, bool allFlag) {
+        // The rows brought back have basic logical variables, and so leave the basis dual feasible.
+        std::vector<Constraint *> restored;
+        int row = 0;
+        for (int i = 0; i < (int) info->droppedRows.size(); ++i)
+            if (allFlag || !isRedundant(info, info->droppedRows[i]))
+                restored.push_back(info->droppedRows[i]);
+            else
+                info->droppedRows[row++] = info->droppedRows[i];
+        info->droppedRows.resize(row);
+        addRows(info, restored);
+    }
+
+
+    void SimplexSolver::dropRows(SimplexInfo *info) {
+        // A redundant row whose logical variable is basic can be removed along with it: the basis remains
+        // a basis, and the duals of the other rows are unchanged. A basis saved without the row records
+        // it as basic, which it is when it is brought back.
+        int n = info->numberVariables;
+        std::vector<Constraint *> dropped;
+        for (int i = 0; i < (int) info->rows.size(); ++i)
+            if (info->status[n + i] == BASIC && isRedundant(info, info->rows[i]))
+                dropped.push_back(info->rows[i]);
+        deleteRows(info, dropped);
+        info->droppedRows.insert(info->droppedRows.end(), dropped.begin(), dropped.end());
+    }
+
+
+    void SimplexSolver::loadColumn(SimplexInfo *info, int j, std::vector<double> &v) {
+        int n = info->numberVariables;
+        if (j < n)
+            for (int e = info->columnStart[j]; e < info->columnStart[j + 1]; ++e)
+                v[info->columnRow[e]] = info->columnValue[e];
+        else
+            v[j - n] = -1.0;
+    }
+
+
+    void SimplexSolver::addEta(SimplexInfo *info, int p, const std::vector<double> &v) {
+        info->etaRow.push_back(p);
+        info->etaPivot.push_back(v[p]);
+        for (int i = 0; i < (int) v.size(); ++i)
+            if (i != p && fabs(v[i]) > DROP_TOLERANCE) {
+                info->etaIndex.push_back(i);
+                info->etaValue.push_back(v[i]);
+            }
+        info->etaStart.push_back(info->etaIndex.size());
+    }
+
+
+    void SimplexSolver::ftran(SimplexInfo *info, std::vector<double> &v) {
+        int numberEtas = info->etaRow.size();
+        for (int t = 0; t < numberEtas; ++t) {
+            int p = info->etaRow[t];
+            if (v[p] == 0.0)
+                continue;
+            double vp = v[p] / info->etaPivot[t];
+            v[p] = vp;
+            for (int e = info->etaStart[t]; e < info->etaStart[t + 1]; ++e)
+                v[info->etaIndex[e]] -= info->etaValue[e] * vp;
+        }
+    }
+
+
+    void SimplexSolver::btran(SimplexInfo *info, std::vector<double> &v) {
+        for (int t = (int) info->etaRow.size() - 1; t >= 0; --t) {
+            int p = info->etaRow[t];
+            double s = v[p];
+            for (int e = info->etaStart[t]; e < info->etaStart[t + 1]; ++e)
+                s -= info->etaValue[e] * v[info->etaIndex[e]];
+            v[p] = s / info->etaPivot[t];
+        }
+    }
+
+
+    void SimplexSolver::factorize(SimplexInfo *info) {
+        int n = info->numberVariables;
+        int m = info->rows.size();
+
+        info->head.assign(m, -1);
+        info->position.assign(n + m, -1);
+        info->etaRow.clear();
+        info->etaPivot.clear();
+        info->etaStart.assign(1, 0);
+        info->etaIndex.clear();
+        info->etaValue.clear();
+        info->numberUpdates = 0;
+
+        // The basic logical variables claim their own rows.
+        for (int i = 0; i < m; ++i)
+            if (info->status[n + i] == BASIC) {
+                info->head[i] = n + i;
+                info->position[n + i] = i;
+                info->etaRow.push_back(i);
+                info->etaPivot.push_back(-1.0);
+                info->etaStart.push_back(info->etaIndex.size());
+            }
+
+        // The basic structural variables are pivoted in, sparsest first, each on the row left with
+        // the largest entry. A column with no entry large enough is dropped from the basis.
+        std::vector<std::pair<int, int> > columns;
+        for (int j = 0; j < n; ++j)
+            if (info->status[j] == BASIC)
+                columns.push_back(std::make_pair(info->columnStart[j + 1] - info->columnStart[j], j));
+        std::sort(columns.begin(), columns.end());
+
+        info->work.assign(m, 0.0);
+        for (std::vector<std::pair<int, int> >::iterator iter = columns.begin();
+             iter != columns.end();
+             ++iter) {
+            int j = (*iter).second;
+            loadColumn(info, j, info->work);
+            ftran(info, info->work);
+
+            int p = -1;
+            double largest = PIVOT_TOLERANCE;
+            for (int i = 0; i < m; ++i)
+                if (info->head[i] == -1 && fabs(info->work[i]) > largest) {
+                    p = i;
+                    largest = fabs(info->work[i]);
+                }
+            if (p >= 0) {
+                addEta(info, p, info->work);
+                info->head[p] = j;
+                info->position[j] = p;
+            } else
+                info->status[j] = LOWER;
+            std::fill(info->work.begin(), info->work.end(), 0.0);
+        }
+
+        // The rows left get their logical variables. As no eta so far has pivoted on such a row, the
+        // column of the logical variable is unchanged by them, and its eta is trivial.
+        for (int i = 0; i < m; ++i)
+            if (info->head[i] == -1) {
+                info->status[n + i] = BASIC;
+                info->head[i] = n + i;
+                info->position[n + i] = i;
+                info->etaRow.push_back(i);
+                info->etaPivot.push_back(-1.0);
+                info->etaStart.push_back(info->etaIndex.size());
+            }
+
+        info->factoredFlag = true;
+    }
+
+
+    void SimplexSolver::computePrimal(SimplexInfo *info) {
+        int n = info->numberVariables;
+        int m = info->rows.size();
+
+        for (int j = 0; j < n + m; ++j)
+            if (info->status[j] != BASIC)
+                info->x[j] = (info->status[j] == UPPER ? info->upper[j] : info->lower[j]);
+
+        // The basic variables satisfy Bx_B = -Nx_N.
+        for (int i = 0; i < m; ++i) {
+            std::vector<int> &positions = info->rows[i]->getPositions();
+            std::vector<int> &coefficients = info->rows[i]->getCoefficients();
+            double s = 0;
+            for (int k = 0; k < (int) positions.size(); ++k)
+                if (info->status[positions[k]] != BASIC)
+                    s -= coefficients[k] * info->x[positions[k]];
+            if (info->status[n + i] != BASIC)
+                s += info->x[n + i];
+            info->work[i] = s;
+        }
+        ftran(info, info->work);
+        for (int p = 0; p < m; ++p)
+            info->x[info->head[p]] = info->work[p];
+    }
+
+
+    void SimplexSolver::computeDual(SimplexInfo *info) {
+        int n = info->numberVariables;
+        int m = info->rows.size();
+
+        // The duals are y = c_B B^-1, and the reduced costs d = c - yA.
+        for (int p = 0; p < m; ++p)
+            info->work[p] = (info->head[p] < n ? getCost(info, info->head[p]) : 0.0);
+        btran(info, info->work);
+
+        for (int j = 0; j < n; ++j) {
+            if (info->status[j] == BASIC) {
+                info->d[j] = 0.0;
+                continue;
+            }
+            double s = getCost(info, j);
+            for (int e = info->columnStart[j]; e < info->columnStart[j + 1]; ++e)
+                s -= info->columnValue[e] * info->work[info->columnRow[e]];
+            info->d[j] = s;
+        }
+        for (int i = 0; i < m; ++i)
+            info->d[n + i] = (info->status[n + i] == BASIC ? 0.0 : info->work[i]);
+    }
+
+
+    bool SimplexSolver::makeDualFeasible(SimplexInfo *info) {
+        int total = info->numberVariables + info->rows.size();
+        for (int j = 0; j < total; ++j) {
+            if (info->status[j] == BASIC)
+                continue;
+            if (info->lower[j] == info->upper[j]) {
+                info->status[j] = LOWER;
+                continue;
+            }
+
+            // At its lower bound, a variable must have a nonnegative reduced cost, and at its upper
+            // bound, a nonpositive one. If either will do, we keep it where it is, if we can.
+            unsigned char status = info->status[j];
+            if (info->d[j] > DUAL_TOLERANCE)
+                status = LOWER;
+            else if (info->d[j] < -DUAL_TOLERANCE)
+                status = UPPER;
+            else if (status == LOWER && info->lower[j] == -DBL_MAX)
+                status = UPPER;
+            else if (status == UPPER && info->upper[j] == DBL_MAX)
+                status = LOWER;
+            if ((status == LOWER && info->lower[j] == -DBL_MAX) || (status == UPPER && info->upper[j] == DBL_MAX))
+                return false;
+            info->status[j] = status;
+        }
+        return true;
+    }
+
+
+    void SimplexSolver::coldStart(SimplexInfo *info) {
+        int n = info->numberVariables;
+        for (int j = 0; j < n; ++j)
+            info->status[j] = (getCost(info, j) < 0 && info->lower[j] != info->upper[j] ? UPPER : LOWER);
+        for (int i = 0; i < (int) info->rows.size(); ++i)
+            info->status[n + i] = BASIC;
+        info->factoredFlag = false;
+    }
+
+
+    void SimplexSolver::start(SimplexInfo *info) {
+        if (!info->factoredFlag)
+            factorize(info);
+        computeDual(info);
+        if (!makeDualFeasible(info)) {
+            coldStart(info);
+            factorize(info);
+            computeDual(info);
+            makeDualFeasible(info);
+        }
+        computePrimal(info);
+    }
+
+
+    double SimplexSolver::objectiveValue(SimplexInfo *info) {
+        double value = 0;
+        for (int j = 0; j < info->numberVariables; ++j)
+            value += info->cost[j] * info->x[j];
+        return value;
+    }
+
+
+    double SimplexSolver::dualBound(SimplexInfo *info) {
+        if (!info->perturbedFlag)
+            return objectiveValue(info);
+
+        // The basis bounds the perturbed problem, whose optimum is within perturbationTotal
+        // of the real one, as the structural variables lie in [0,1].
+        double value = 0;
+        for (int j = 0; j < info->numberVariables; ++j)
+            value += getCost(info, j) * info->x[j];
+        return value - info->perturbationTotal;
+    }
+
+
+    SimplexSolver::Result SimplexSolver::dualSimplex(SimplexInfo *info, BACOptions &options) {
+        int n = info->numberVariables;
+        int m = info->rows.size();
+        int total = n + m;
+
+        // Besides the limits requested, we give up on an LP that takes unreasonably many
+        // iterations, e.g. because it cycles, rather than loop forever.
+        int iterationLimit = options.getLPIterationLimit();
+        int timeLimit = options.getLPTimeLimit();
+        int safetyLimit = 1000 + 50 * total;
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+        std::vector<std::pair<double, int> > breakpoints;
+        std::vector<int> &freeColumns = info->freeColumns;
+        int numberFree = freeColumns.size();
+        std::vector<double> &column = info->column;
+        column.assign(m, 0.0);
+
+        for (int iteration = 0;; ++iteration) {
+            if (iterationLimit > 0 && iteration >= iterationLimit)
+                return LIMIT;
+            if (iteration >= safetyLimit) {
+#ifdef DEBUG
+                std::cerr << "SimplexSolver abandoned an LP after " << iteration << " iterations." << std::endl;
+#endif
+                options.getStatistics().reportLPAbandoned();
+                return LIMIT;
+            }
+            if (timeLimit > 0 && (iteration & 63) == 63
+                && std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count()
+                   >= timeLimit)
+                return LIMIT;
+
+            // Rebuild the inverse of the basis every so often, recomputing everything from it
+            // to get rid of accumulated error.
+            if (info->numberUpdates >= REFACTOR_INTERVAL) {
+                info->factoredFlag = false;
+                start(info);
+            }
+
+            // As the basis is dual feasible, it bounds the objective of the LP.
+            if (info->cutoff < DBL_MAX && dualBound(info) > info->cutoff)
+                return CUTOFF;
+
+            // Choose the basic variable that is the furthest outside of its bounds to leave.
+            int r = -1;
+            double largest = PRIMAL_TOLERANCE;
+            for (int p = 0; p < m; ++p) {
+                int j = info->head[p];
+                double infeasibility = info->lower[j] - info->x[j];
+                if (infeasibility < info->x[j] - info->upper[j])
+                    infeasibility = info->x[j] - info->upper[j];
+                if (infeasibility > largest) {
+                    r = p;
+                    largest = infeasibility;
+                }
+            }
+
+            // If there is none, we are done, provided that this is confirmed by a fresh basis.
+            if (r < 0) {
+                if (info->numberUpdates == 0)
+                    return OPTIMAL;
+                info->numberUpdates = REFACTOR_INTERVAL;
+                continue;
+            }
+            int leaving = info->head[r];
+            double bound = (info->x[leaving] < info->lower[leaving] ? info->lower[leaving] : info->upper[leaving]);
+            double delta = info->x[leaving] - bound;
+
+            // Compute the pivot row: row r of the inverse of the basis, times the nonbasic columns. Only
+            // the free variables can enter, so the reduced rows will do.
+            std::vector<double> &rho = info->work;
+            std::fill(rho.begin(), rho.end(), 0.0);
+            rho[r] = 1.0;
+            btran(info, rho);
+            std::vector<double> &alpha = info->alpha;
+            std::fill(alpha.begin(), alpha.end(), 0.0);
+            for (int i = 0; i < m; ++i) {
+                if (fabs(rho[i]) <= DROP_TOLERANCE)
+                    continue;
+                for (int e = info->rowStart[i]; e < info->rowStart[i + 1]; ++e)
+                    alpha[info->rowColumn[e]] += rho[i] * info->rowValue[e];
+                alpha[n + i] = -rho[i];
+            }
+
+            // The ratio test: the breakpoints at which the reduced cost of a nonbasic variable would
+            // change sign as the dual moves in the direction that fixes the leaving variable.
+            double sign = (delta < 0 ? -1.0 : 1.0);
+            breakpoints.clear();
+            for (int k = 0; k < numberFree + m; ++k) {
+                int j = (k < numberFree ? freeColumns[k] : n + k - numberFree);
+                if (info->status[j] == BASIC || info->lower[j] == info->upper[j])
+                    continue;
+                double a = sign * alpha[j];
+                if (info->status[j] == LOWER && a > PIVOT_TOLERANCE)
+                    breakpoints.push_back(std::make_pair(std::max(info->d[j], 0.0) / a, j));
+                else if (info->status[j] == UPPER && a < -PIVOT_TOLERANCE)
+                    breakpoints.push_back(std::make_pair(std::max(-info->d[j], 0.0) / -a, j));
+            }
+            std::sort(breakpoints.begin(), breakpoints.end());
+
+            // Bound flipping: the dual objective improves at a rate that decreases as each breakpoint
+            // is passed, by flipping its variable to its other bound. We pass breakpoints for as long
+            // as the rate remains clearly positive, and the variable of the last becomes basic. If every one
+            // can be passed, the dual is unbounded, and the LP is infeasible.
+            double slope = fabs(delta);
+            int entering = -1;
+            int numberFlips = 0;
+            for (; numberFlips < (int) breakpoints.size(); ++numberFlips) {
+                int j = breakpoints[numberFlips].second;
+                if (info->lower[j] == -DBL_MAX || info->upper[j] == DBL_MAX) {
+                    entering = j;
+                    break;
+                }
+                slope -= (info->upper[j] - info->lower[j]) * fabs(alpha[j]);
+                if (slope <= PRIMAL_TOLERANCE) {
+                    entering = j;
+                    break;
+                }
+            }
+            if (entering < 0)
+                return INFEASIBLE;
+
+            // The entering column, which should agree with the pivot row. If it does not, the inverse
+            // of the basis has become inaccurate, and we rebuild it and try again.
+            std::fill(column.begin(), column.end(), 0.0);
+            loadColumn(info, entering, column);
+            ftran(info, column);
+            if (fabs(column[r] - alpha[entering]) > 1e-6 * (1 + fabs(alpha[entering])) && info->numberUpdates > 0) {
+                info->numberUpdates = REFACTOR_INTERVAL;
+                continue;
+            }
+
+            // Update the reduced costs.
+            double thetaD = info->d[entering] / alpha[entering];
+            for (std::vector<int>::iterator iter = freeColumns.begin(); iter != freeColumns.end(); ++iter)
+                if (info->status[*iter] != BASIC)
+                    info->d[*iter] -= thetaD * alpha[*iter];
+            for (int j = n; j < total; ++j)
+                if (info->status[j] != BASIC)
+                    info->d[j] -= thetaD * alpha[j];
+            info->d[entering] = 0.0;
+            info->d[leaving] = -thetaD;
+
+            // Flip the variables whose breakpoints were passed, and update the basic variables.
+            if (numberFlips > 0) {
+                std::vector<double> &flips = info->work;
+                std::fill(flips.begin(), flips.end(), 0.0);
+                for (int k = 0; k < numberFlips; ++k) {
+                    int j = breakpoints[k].second;
+                    double change;
+                    if (info->status[j] == LOWER) {
+                        info->status[j] = UPPER;
+                        change = info->upper[j] - info->lower[j];
+                    } else {
+                        info->status[j] = LOWER;
+                        change = info->lower[j] - info->upper[j];
+                    }
+                    info->x[j] += change;
+                    if (j < n)
+                        for (int e = info->columnStart[j]; e < info->columnStart[j + 1]; ++e)
+                            flips[info->columnRow[e]] += info->columnValue[e] * change;
+                    else
+                        flips[j - n] -= change;
+                }
+                ftran(info, flips);
+                for (int p = 0; p < m; ++p)
+                    info->x[info->head[p]] -= flips[p];
+            }
+
+            // Move along the entering column until the leaving variable reaches its bound.
+            double thetaP = (info->x[leaving] - bound) / column[r];
+            for (int p = 0; p < m; ++p)
+                info->x[info->head[p]] -= thetaP * column[p];
+            info->x[entering] += thetaP;
+            info->x[leaving] = bound;
+
+            // Update the basis.
+            addEta(info, r, column);
+            info->head[r] = entering;
+            info->position[entering] = r;
+            info->position[leaving] = -1;
+            info->status[entering] = BASIC;
+            info->status[leaving] = (bound == info->lower[leaving] ? LOWER : UPPER);
+            ++(info->numberUpdates);
+        }
+    }
+
+
+    int SimplexSolver::solveNode(BAC &bac, Node &n, bool) {
+        Formulation &f = bac.getFormulation();
+        SimplexInfo *info = (SimplexInfo *) f.getData();
+
+        // The variables fixed by rows at the previous node are released, and the rows set aside that
+        // matter again under the fixings of the node are brought back before the basis is installed,
+        // so that they get their statuses from it.
+        bool reduceFlag = bac.getOptions().reduceLP();
+        if (reduceFlag != info->reduceFlag) {
+            info->reduceFlag = reduceFlag;
+            info->fixingsChangedFlag = true;
+        }
+        releaseForcedColumns(info);
+        restoreRows(info, !reduceFlag);
+
+        // For the first LP at a node, we start from the basis of its closest ancestor. When we
+        // descend, this is the basis we already have; when we backtrack, it is much closer to the
+        // LP than that of the subtree we have just left. Otherwise, we start from the current basis.
+        const Node::Basis *basis = n.getAncestorBasis();
+        if (n.getNumberLPsSolved() == 0 && basis)
+            installBasis(info, *basis);
+
+        if (reduceFlag) {
+            fixForcedColumns(info);
+            dropRows(info);
+        }
+        if (info->rowsChangedFlag)
+            refreshRows(info);
+        if (info->fixingsChangedFlag)
+            refreshFixings(info);
+
+        // Solve with the perturbed costs, and then finish with the real ones.
+        info->perturbedFlag = true;
+        start(info);
+        Result result = dualSimplex(info, bac.getOptions());
+        double bound = dualBound(info);
+        info->perturbedFlag = false;
+        if (result == OPTIMAL) {
+            start(info);
+            result = dualSimplex(info, bac.getOptions());
+            bound = dualBound(info);
+        }
+        if (result == INFEASIBLE || result == CUTOFF)
+            return -1;
+
+        // Keep the basis for the descendants of the node.
+        saveBasis(info, n.getBasis());
+
+        double value = (result == OPTIMAL ? objectiveValue(info) : bound);
+        n.setSolutionValue(info->maximizationFlag ? -value : value);
+        double *solvars = n.getSolutionVariableArray();
+        if (result == OPTIMAL) {
+            // The reduced costs are those of the minimization, and are negated for maximization. Those of
+            // the variables fixed by rows are not kept up to date by the pivots. These variables must take
+            // their values throughout the subtree, so we report them as fixed, with an infinite reduced cost.
+            double *reducedCosts = n.getReducedCostArray();
+            for (int i = 0; i < n.getNumberBranchingVariables(); ++i) {
+                solvars[i] = info->x[i];
+                reducedCosts[i] = (info->maximizationFlag ? -info->d[i] : info->d[i]);
+            }
+            for (std::vector<int>::iterator iter = info->forcedColumns.begin();
+                 iter != info->forcedColumns.end();
+                 ++iter)
+                if (*iter < n.getNumberBranchingVariables())
+                    reducedCosts[*iter] = ((info->lower[*iter] > 0.5) == info->maximizationFlag ? DBL_MAX : -DBL_MAX);
+            n.setReducedCostsFlag(true);
+        } else {
+            // We ran out of iterations or time. The objective of a dual feasible basis still bounds
+            // that of the LP, and we give every free variable the value 1/2, so that the node is
+            // branched upon rather than taken for a solution.
+            short int *partialSolutionArray = n.getPartialSolutionArray();
+            for (int i = 0; i < n.getNumberBranchingVariables(); ++i)
+                solvars[i] = (partialSolutionArray[i] == -1 ? 0.5 : partialSolutionArray[i]);
+        }
+
+        // We only solve the LP, and no subnodes, even if asked to solve the node fully.
+        return 0;
+    }
+
+
+    void SimplexSolver::saveBasis(SimplexInfo *info, Node::Basis &basis) {
+        int n = info->numberVariables;
+        basis.columnStatuses.assign(info->status.begin(), info->status.begin() + n);
+
+        // Rows are recorded by the IDs of their constraints, sorted so that they
+        // can be looked up when installing the basis. Most rows are basic, and
+        // only the others are recorded.
+        basis.rowStatuses.clear();
+        for (int i = 0; i < (int) info->rows.size(); ++i)
+            if (info->status[n + i] != BASIC)
+                basis.rowStatuses.push_back(std::make_pair(info->rows[i]->getID(), info->status[n + i]));
+        std::sort(basis.rowStatuses.begin(), basis.rowStatuses.end());
+    }
+
+
+    void SimplexSolver::installBasis(SimplexInfo *info, const Node::Basis &basis) {
+        int n = info->numberVariables;
+        if ((int) basis.columnStatuses.size() != n)
+            return;
+
+        // Rows for constraints that did not exist then are made basic. If the basis is the one we
+        // have, as it is when we descend, we keep its inverse.
+        bool changedFlag = false;
+        for (int j = 0; j < n; ++j)
+            if (info->status[j] != basis.columnStatuses[j]) {
+                info->status[j] = basis.columnStatuses[j];
+                changedFlag = true;
+            }
+        for (int i = 0; i < (int) info->rows.size(); ++i) {
+            unsigned char status = BASIC;
+            std::pair<unsigned long, unsigned char> key(info->rows[i]->getID(), 0);
+            std::vector<std::pair<unsigned long, unsigned char> >::const_iterator iter
+                    = std::lower_bound(basis.rowStatuses.begin(), basis.rowStatuses.end(), key);
+            if (iter != basis.rowStatuses.end() && (*iter).first == key.first)
+                status = (*iter).second;
+            if (info->status[n + i] != status) {
+                info->status[n + i] = status;
+                changedFlag = true;
+            }
+        }
+        if (changedFlag)
+            info->factoredFlag = false;
+    }
+
+
+    void *SimplexSolver::createConstraint(Formulation &, std::vector<int> &, std::vector<int> &, int, int) {
+        // This method need not do anything. Everything will be handled
+        // when the constraint is added.
+        return (void *) 0;
+    }
+
+
+    void SimplexSolver::deleteConstraint(void *) {
+    }
+
+
+#ifdef DEBUG
+    void SimplexSolver::printVariables(Formulation &f) {
+        SimplexInfo *info = (SimplexInfo *) f.getData();
+        for (int j = 0; j < info->numberVariables; ++j)
+            std::cerr << " x" << j << "=" << info->x[j];
+        std::cerr << std::endl;
+    }
+#endif
+
+
+    // Create a static instance of SimplexSolver; this will be assigned as the static
+    // instance in LPSolver and used to create the solvers for formulations. Simply
+    // link this solver in with end-user code to obtain a program that needs no
+    // external LP solver.
+    SimplexSolver SimplexSolver::_simplexsolver;
+};
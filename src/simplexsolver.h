@@ -0,0 +1,279 @@
+/**
+ * simplexsolver.h
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+
+#ifndef SIMPLEXSOLVER_H
+#define SIMPLEXSOLVER_H
+
+#include <limits.h>
+#include <vector>
+#include "common.h"
+#include "lpsolver.h"
+#include "node.h"
+
+namespace vorpal::nibac {
+    // Class forwards
+    class BAC;
+    class Constraint;
+    class Formulation;
+    class Node;
+
+    /**
+     * A self-contained LP solver that needs no external library: a revised dual simplex method with bound
+     * flipping, specialized for the LPs of a branch-and-cut over 0/1 variables. This is a concrete implementation
+     * of LPSolver; simply link it in instead of another solver.
+     *
+     * Every LP is of the form: optimize cx subject to L <= Ax <= U and 0 <= x <= 1, where a variable may be fixed,
+     * and a bound of a row may be infinite (INT_MIN or INT_MAX in its constraint). We add a logical variable s for
+     * each row, with Ax - s = 0 and L <= s <= U, so that the basis of the slacks is always at hand. Since every
+     * structural variable is boxed, any basis in which the logical variables with an infinite bound are basic can
+     * be made dual feasible by moving each nonbasic variable to the bound that suits the sign of its reduced cost;
+     * in particular, the basis of the slacks can. Thus, the dual simplex method always has a place to start, and
+     * from the previous basis, a fixing or a cut only costs a few iterations. The ratio test passes the
+     * breakpoints of boxed variables by flipping them to their other bound for as long as the dual objective
+     * improves, which saves many iterations on 0/1 problems.
+     *
+     * The rows are those of the constraints themselves, and the inverse of the basis is kept in product form,
+     * as a sequence of sparse eta vectors, which is rebuilt from scratch every so often or when the rows change.
+     *
+     * Deep in the tree, most variables are fixed, and many rows can no longer be violated. If the LP reduction
+     * of BACOptions is on, each node solves only the active part of its LP. With the values of the fixed
+     * variables moved into its bounds, a row that can only be met with every free variable at one of its
+     * bounds fixes them there, for this node only; a row that is then redundant, and whose logical variable
+     * is basic, is set aside until a backtrack makes it matter again; and the fixed variables are left out
+     * of the pricing.
+     *
+     * The objective function bounds given to setObjectiveFunction act as a cutoff: as the dual objective only
+     * becomes worse, an LP is abandoned as soon as it cannot meet them. An LP can also be limited by the LP
+     * iteration and time limits of BACOptions. Nodes to be fully solved are simply solved as LPs.
+     */
+    class SimplexSolver final : public LPSolver {
+    private:
+        static SimplexSolver _simplexsolver;
+
+        // The status of a variable, which is also how it is kept in a Node::Basis.
+        enum Status {
+            BASIC = 0,
+            LOWER = 1,
+            UPPER = 2
+        };
+
+        // The outcome of the dual simplex method.
+        enum Result {
+            OPTIMAL,
+            INFEASIBLE,
+            CUTOFF,
+            LIMIT
+        };
+
+        // Data structure to populate the Formulation::data field.
+        //
+        // Variables 0, ..., n-1 are the structural variables, and variables n, ..., n+m-1 the logical
+        // variables of the rows, in order. The constraint of each row is kept, and holds the index of
+        // its row plus one as its implementation. Costs are those of the minimization equivalent to the
+        // problem, i.e. negated for maximization, as is the cutoff.
+        //
+        // The LPs of 0/1 problems tend to be highly dual degenerate, which makes the dual simplex method
+        // stall or cycle. Thus, we first solve with every cost moved slightly away from zero, by a small
+        // amount that differs from variable to variable, and then remove the perturbation and finish from
+        // the basis found, which rarely takes more than a few iterations.
+        //
+        // The statuses of the variables persist between solves and form the basis from which we start.
+        // The remaining data is rebuilt as needed: the columns of the matrix when the rows change, and the
+        // basis heading and its inverse when the rows or the statuses change other than by a pivot.
+        struct SimplexInfo {
+            int numberVariables;
+            std::vector<Constraint *> rows;
+            std::vector<double> cost;
+            std::vector<double> perturbation;
+            double perturbationTotal;
+            bool perturbedFlag;
+            double cutoff;
+            bool maximizationFlag;
+
+            std::vector<double> lower;
+            std::vector<double> upper;
+            std::vector<unsigned char> status;
+
+            bool rowsChangedFlag;
+            bool factoredFlag;
+
+            // The columns of the structural variables, in compressed form.
+            std::vector<int> columnStart;
+            std::vector<int> columnRow;
+            std::vector<double> columnValue;
+
+            // The basis: the variable at each position, and the position of each variable, or -1.
+            std::vector<int> head;
+            std::vector<int> position;
+
+            // The eta vectors making up the inverse of the basis: the pivot row and value of each,
+            // and the range of its other entries in etaIndex and etaValue.
+            std::vector<int> etaRow;
+            std::vector<double> etaPivot;
+            std::vector<int> etaStart;
+            std::vector<int> etaIndex;
+            std::vector<double> etaValue;
+            int numberUpdates;
+
+            // The reduction of the LP to its active part: the variables fixed by rows for the current node,
+            // the rows set aside as redundant, whose constraints have no implementation, the free structural
+            // variables, and the rows without their fixed variables, in compressed form. Without the
+            // reduction, nothing is fixed, set aside or left out. The reduced costs of the fixed variables
+            // are not kept up to date by the pivots.
+            bool reduceFlag;
+            bool fixingsChangedFlag;
+            std::vector<int> forcedColumns;
+            std::vector<Constraint *> droppedRows;
+            std::vector<int> freeColumns;
+            std::vector<int> rowStart;
+            std::vector<int> rowColumn;
+            std::vector<double> rowValue;
+
+            // The values and reduced costs of the variables, and scratch space.
+            std::vector<double> x;
+            std::vector<double> d;
+            std::vector<double> work;
+            std::vector<double> alpha;
+            std::vector<double> column;
+        };
+
+        // Tolerances for primal and dual feasibility, for the size of a pivot, and for the entries kept
+        // in an eta vector, the size of the perturbation of the costs, and the number of updates of the
+        // basis after which it is rebuilt.
+        static const double PRIMAL_TOLERANCE;
+        static const double DUAL_TOLERANCE;
+        static const double PIVOT_TOLERANCE;
+        static const double DROP_TOLERANCE;
+        static const double PERTURBATION;
+        static const int REFACTOR_INTERVAL;
+
+        // Add or delete the rows of several constraints.
+        void addRows(SimplexInfo *, std::vector<Constraint *> &);
+
+        void deleteRows(SimplexInfo *, std::vector<Constraint *> &);
+
+        // Rebuild the columns after the rows have changed.
+        void refreshRows(SimplexInfo *);
+
+        // Rebuild the free variables and the reduced rows after the rows or the fixings have changed.
+        void refreshFixings(SimplexInfo *);
+
+        // Determine the least and greatest values that the row of a constraint can take with the variables
+        // within their bounds, and from them, if the row can be violated by none of these values.
+        void getActivityRange(SimplexInfo *, Constraint *, double &, double &);
+
+        bool isRedundant(SimplexInfo *, Constraint *);
+
+        // Fix the free variables of the rows that can only be met with all of them at one of their bounds,
+        // or release those fixed by rows at the previous node.
+        void fixForcedColumns(SimplexInfo *);
+
+        void releaseForcedColumns(SimplexInfo *);
+
+        // Bring back the rows set aside that are no longer redundant, or all of them, and set aside the
+        // redundant rows whose logical variables are basic.
+        void restoreRows(SimplexInfo *, bool= false);
+
+        void dropRows(SimplexInfo *);
+
+        // Rebuild the basis heading and its inverse from the statuses. Columns that would make the basis
+        // singular are dropped, and the rows left without a basic variable get their logical variable.
+        void factorize(SimplexInfo *);
+
+        // Add an eta vector for a pivot on a column in the given position, which must be in the work array
+        // as transformed by ftran.
+        void addEta(SimplexInfo *, int, const std::vector<double> &);
+
+        // Multiply a vector by the inverse of the basis, on the left or, for btran, on the right.
+        void ftran(SimplexInfo *, std::vector<double> &);
+
+        void btran(SimplexInfo *, std::vector<double> &);
+
+        // Load the column of a variable into a dense vector, which must be zero.
+        void loadColumn(SimplexInfo *, int, std::vector<double> &);
+
+        // Compute the values of the variables, and the reduced costs, from the basis.
+        void computePrimal(SimplexInfo *);
+
+        void computeDual(SimplexInfo *);
+
+        // Move the nonbasic variables to the bounds that make the basis dual feasible. Returns false if this
+        // is not possible, i.e. a variable would have to move to an infinite bound.
+        bool makeDualFeasible(SimplexInfo *);
+
+        // Make the basis that of the slacks, which is always dual feasible.
+        void coldStart(SimplexInfo *);
+
+        // Prepare the current basis for the dual simplex method: factorize it if needed, make it dual
+        // feasible, falling back on the basis of the slacks, and compute the values of the variables.
+        void start(SimplexInfo *);
+
+        // The cost of a structural variable, perturbed or not.
+        inline double getCost(SimplexInfo *info, int j) {
+            return info->perturbedFlag ? info->cost[j] + info->perturbation[j] : info->cost[j];
+        }
+
+        // The value of the objective of the minimization equivalent to the problem, and a lower bound on its
+        // optimum given by a dual feasible basis, which only differs from it while the costs are perturbed.
+        double objectiveValue(SimplexInfo *);
+
+        double dualBound(SimplexInfo *);
+
+        // Run the dual simplex method from the current basis, which must be dual feasible.
+        Result dualSimplex(SimplexInfo *, BACOptions &);
+
+        // Save the basis to a node, or install the basis of a node.
+        void saveBasis(SimplexInfo *, Node::Basis &);
+
+        void installBasis(SimplexInfo *, const Node::Basis &);
+
+    protected:
+        SimplexSolver() = default;
+
+    public:
+        virtual ~SimplexSolver() = default;
+
+        virtual LPSolver *makeInstance();
+
+        virtual void setupFormulation(Formulation &);
+
+        virtual void cleanupFormulation(Formulation &);
+
+        virtual void setObjectiveFunction(Formulation &, std::vector<int> &, int= INT_MIN, int= INT_MAX);
+
+        virtual void setObjectiveCutoff(Formulation &, int);
+
+        virtual void addConstraint(Formulation &, Constraint *);
+
+        virtual void removeConstraint(Formulation &, Constraint *);
+
+        virtual void addCut(Formulation &, Constraint *);
+
+        virtual void removeCut(Formulation &, Constraint *);
+
+        virtual void addCuts(Formulation &, std::vector<Constraint *> &);
+
+        virtual void removeCuts(Formulation &, std::vector<Constraint *> &);
+
+        virtual void fixVariable(Formulation &, int, int);
+
+        virtual void unfixVariable(Formulation &, int);
+
+        // We have no integer method, so we solve the LP even when asked to solve the node
+        // fully, and BAC branches on it as usual. As only the LP is solved, we return 0.
+        virtual int solveNode(BAC &, Node &, bool= false);
+
+        void *createConstraint(Formulation &, std::vector<int> &, std::vector<int> &, int, int);
+
+        void deleteConstraint(void *);
+
+#ifdef DEBUG
+        void printVariables(Formulation &);
+#endif
+    };
+};
+
+#endif
@@ -7,7 +7,9 @@
 #ifndef SOLUTIONMANAGER_H
 #define SOLUTIONMANAGER_H
 
+#include <istream>
 #include <map>
+#include <ostream>
 #include <string>
 #include "common.h"
 
@@ -26,6 +28,15 @@ namespace vorpal::nibac {
         virtual ~SolutionManager() = default;
 
         virtual void newSolution(Node &) = 0;
+
+        // Write the state of the manager, e.g. the solutions found so far, to a checkpoint of
+        // the search, and restore it when the search is resumed from the checkpoint. A search
+        // may resume from several checkpoints at once (e.g. the results of work units), so
+        // readCheckpoint adds the state read to that of the manager. Managers that keep no
+        // state need not override these.
+        virtual void writeCheckpoint(std::ostream &) {}
+
+        virtual void readCheckpoint(std::istream &) {}
     };
 
 
@@ -4,6 +4,7 @@
  * By Sebastian Raaphorst, 2003 - 2018.
  */
 
+#include <math.h>
 #include <ostream>
 #include <vector>
 #include <map>
@@ -19,7 +20,18 @@ namespace vorpal::nibac {
               numberNodesExplored(0),
               numberStackBacktracks(0),
               numberLPsSolved(0),
-              treeDepth(0) {
+              numberLPsAbandoned(0),
+              numberCutPoolCuts(0),
+              numberDuplicateCuts(0),
+              treeDepth(0),
+              numberSubtreesSetAside(0),
+              numberSubtreesResumed(0),
+              numberWorkUnits(0),
+              leafWeight(0),
+              weightedTreeSize(0),
+              bestSolutionFlag(false),
+              bestSolutionNodes(0),
+              bestSolutionSeconds(0) {
     }
 
 
@@ -32,6 +44,175 @@ namespace vorpal::nibac {
     }
 
 
+    void Statistics::merge(const Statistics &other) {
+        numberCanonicityCalls += other.numberCanonicityCalls;
+        numberCanonicityRejections += other.numberCanonicityRejections;
+        reportNonCanonicalDepth(other.nonCanonicalMaximumDepth);
+        numberNodesExplored += other.numberNodesExplored;
+        numberStackBacktracks += other.numberStackBacktracks;
+        numberLPsSolved += other.numberLPsSolved;
+        numberLPsAbandoned += other.numberLPsAbandoned;
+        numberCutPoolCuts += other.numberCutPoolCuts;
+        numberDuplicateCuts += other.numberDuplicateCuts;
+        reportBranchDepth(other.treeDepth);
+        numberSubtreesSetAside += other.numberSubtreesSetAside;
+        numberSubtreesResumed += other.numberSubtreesResumed;
+        numberWorkUnits += other.numberWorkUnits;
+        leafWeight += other.leafWeight;
+        weightedTreeSize += other.weightedTreeSize;
+
+        // The timers measure the processor time of the whole process, so when several
+        // workers run at once, the times that they report overlap. Our total timer may
+        // be running, and workers do not use theirs.
+        margotTimer.setSeconds(margotTimer.getSeconds() + other.margotTimer.getSeconds());
+        lpSolveTime.setSeconds(lpSolveTime.getSeconds() + other.lpSolveTime.getSeconds());
+        separationTimer.setSeconds(separationTimer.getSeconds() + other.separationTimer.getSeconds());
+        totalTimer.addSeconds(other.totalTimer.getSeconds());
+#ifdef NODEGROUPS
+        groupCopyTimer.setSeconds(groupCopyTimer.getSeconds() + other.groupCopyTimer.getSeconds());
+#endif
+
+        // A parallel search records when it found its best solution itself, so we only take
+        // the point from the other statistics if we have none.
+        if (!bestSolutionFlag && other.bestSolutionFlag) {
+            bestSolutionFlag = true;
+            bestSolutionNodes = other.bestSolutionNodes;
+            bestSolutionSeconds = other.bestSolutionSeconds;
+        }
+
+        if (numberCuts.size() < other.numberCuts.size())
+            numberCuts.resize(other.numberCuts.size(), 0);
+        for (unsigned int i = 0; i < other.numberCuts.size(); ++i)
+            numberCuts[i] += other.numberCuts[i];
+
+        for (std::map<int, int>::const_iterator iter = other.nodesByDepth.begin();
+             iter != other.nodesByDepth.end();
+             ++iter)
+            nodesByDepth[(*iter).first] += (*iter).second;
+        for (std::map<int, int>::const_iterator iter = other.fixingsByDepth.begin();
+             iter != other.fixingsByDepth.end();
+             ++iter)
+            fixingsByDepth[(*iter).first] += (*iter).second;
+        for (std::map<int, double>::const_iterator iter = other.lpTimeByDepth.begin();
+             iter != other.lpTimeByDepth.end();
+             ++iter)
+            lpTimeByDepth[(*iter).first] += (*iter).second;
+    }
+
+
+    void Statistics::write(std::ostream &out) const {
+        out << numberCanonicityCalls << ' ' << numberCanonicityRejections << ' ' << nonCanonicalMaximumDepth << ' '
+            << numberNodesExplored << ' ' << numberStackBacktracks << ' ' << numberLPsSolved << ' '
+            << numberLPsAbandoned << ' ' << numberCutPoolCuts << ' ' << numberDuplicateCuts << ' '
+            << treeDepth << ' ' << numberSubtreesSetAside << ' ' << numberSubtreesResumed << ' '
+            << numberWorkUnits << ' ' << bestSolutionFlag << ' ' << bestSolutionNodes << ' ' << bestSolutionSeconds << std::endl;
+        out << margotTimer.getSeconds() << ' ' << lpSolveTime.getSeconds() << ' '
+            << separationTimer.getSeconds() << ' ' << totalTimer.getSeconds() << std::endl;
+        out << leafWeight << ' ' << weightedTreeSize << std::endl;
+
+        out << numberCuts.size();
+        for (std::vector<unsigned long>::const_iterator iter = numberCuts.begin();
+             iter != numberCuts.end();
+             ++iter)
+            out << ' ' << *iter;
+        out << std::endl;
+
+        out << nodesByDepth.size();
+        for (std::map<int, int>::const_iterator iter = nodesByDepth.begin();
+             iter != nodesByDepth.end();
+             ++iter)
+            out << ' ' << (*iter).first << ' ' << (*iter).second;
+        out << std::endl;
+
+        out << fixingsByDepth.size();
+        for (std::map<int, int>::const_iterator iter = fixingsByDepth.begin();
+             iter != fixingsByDepth.end();
+             ++iter)
+            out << ' ' << (*iter).first << ' ' << (*iter).second;
+        out << std::endl;
+
+        out << lpTimeByDepth.size();
+        for (std::map<int, double>::const_iterator iter = lpTimeByDepth.begin();
+             iter != lpTimeByDepth.end();
+             ++iter)
+            out << ' ' << (*iter).first << ' ' << (*iter).second;
+        out << std::endl;
+    }
+
+
+    bool Statistics::read(std::istream &in) {
+        in >> numberCanonicityCalls >> numberCanonicityRejections >> nonCanonicalMaximumDepth
+           >> numberNodesExplored >> numberStackBacktracks >> numberLPsSolved
+           >> numberLPsAbandoned >> numberCutPoolCuts >> numberDuplicateCuts
+           >> treeDepth >> numberSubtreesSetAside >> numberSubtreesResumed
+           >> numberWorkUnits >> bestSolutionFlag >> bestSolutionNodes >> bestSolutionSeconds;
+
+        double margotSeconds, lpSolveSeconds, separationSeconds, totalSeconds;
+        if (!(in >> margotSeconds >> lpSolveSeconds >> separationSeconds >> totalSeconds))
+            return false;
+        margotTimer.setSeconds(margotSeconds);
+        lpSolveTime.setSeconds(lpSolveSeconds);
+        separationTimer.setSeconds(separationSeconds);
+        totalTimer.setSeconds(totalSeconds);
+        in >> leafWeight >> weightedTreeSize;
+
+        // The cut producers must be the same as those of the search that wrote the checkpoint.
+        unsigned int numberCutProducers;
+        if (!(in >> numberCutProducers) || numberCutProducers != numberCuts.size())
+            return false;
+        for (std::vector<unsigned long>::iterator iter = numberCuts.begin();
+             iter != numberCuts.end();
+             ++iter)
+            in >> *iter;
+
+        int size, depth, count;
+        nodesByDepth.clear();
+        in >> size;
+        for (int i = 0; in && i < size; ++i) {
+            in >> depth >> count;
+            nodesByDepth[depth] = count;
+        }
+        fixingsByDepth.clear();
+        in >> size;
+        for (int i = 0; in && i < size; ++i) {
+            in >> depth >> count;
+            fixingsByDepth[depth] = count;
+        }
+        double seconds;
+        lpTimeByDepth.clear();
+        in >> size;
+        for (int i = 0; in && i < size; ++i) {
+            in >> depth >> seconds;
+            lpTimeByDepth[depth] = seconds;
+        }
+        return !in.fail();
+    }
+
+
+    void Statistics::reportLeaf(Node &node) {
+        // A leaf at depth d contributes 2^-d * (2^(d+1) - 1) to the weighted sum.
+        double weight = ldexp(1.0, -node.getDepth());
+        leafWeight += weight;
+        weightedTreeSize += 2 - weight;
+    }
+
+
+    void Statistics::printProgress(std::ostream &out) const {
+        double seconds = totalTimer.getSeconds();
+        out << "Progress: " << numberNodesExplored << " nodes in " << seconds << " s";
+
+        // Until we have seen a leaf, and while the estimate is no more than what we have
+        // explored, we have nothing to go by.
+        double treeSize = getEstimatedTreeSize();
+        if (treeSize > numberNodesExplored && numberNodesExplored > 0) {
+            double fraction = numberNodesExplored / treeSize;
+            out << ", estimated tree size " << treeSize << " nodes (" << 100 * fraction << "% done), ETA "
+                << seconds * (1 - fraction) / fraction << " s";
+        }
+        out << '.' << std::endl;
+    }
+
+
     std::ostream &operator<<(std::ostream &out, Statistics &statistics) {
         std::map<int, int>::iterator beginIter, endIter;
         int count;
@@ -51,7 +232,17 @@ namespace vorpal::nibac {
         out << "\tNumber of non-canonical rejections: " << statistics.getNumberCanonicityRejections() << std::endl;
         out << "\tHighest depth of non-canonical rejection: " << statistics.getNonCanonicalMaximumDepth() << std::endl;
         out << "Number of LPs solved: " << statistics.getNumberLPsSolved() << std::endl;
+        if (statistics.getNumberLPsAbandoned() > 0)
+            out << "\tNumber of LPs abandoned after too many iterations: " << statistics.getNumberLPsAbandoned()
+                << std::endl;
         out << "Number of stack backtracks: " << statistics.getNumberStackBacktracks() << std::endl;
+        out << "Number of subtrees set aside by node selection: " << statistics.getNumberSubtreesSetAside()
+            << " (" << statistics.getNumberSubtreesResumed() << " resumed)" << std::endl;
+        if (statistics.getNumberWorkUnits() > 0)
+            out << "Number of work units written: " << statistics.getNumberWorkUnits() << std::endl;
+        if (statistics.hasBestSolution())
+            out << "Best solution value found after " << statistics.getBestSolutionNodes() << " nodes ("
+                << statistics.getBestSolutionSeconds() << " s)." << std::endl;
 
         out << "Number of nodes by depth:";
         std::map<int, int> &nodesbydepth = statistics.getNodeCountByDepth();
@@ -75,6 +266,16 @@ namespace vorpal::nibac {
         }
         out << std::endl;
 
+        out << "LP time by depth:";
+        std::map<int, double> &lptimebydepth = statistics.getLPTimeByDepth();
+        count = 0;
+        for (std::map<int, double>::iterator iter = lptimebydepth.begin(); iter != lptimebydepth.end(); ++iter, ++count) {
+            if (count % 5 == 0)
+                out << std::endl;
+            out << '\t' << (*iter).first << ": " << (*iter).second;
+        }
+        out << std::endl;
+
         std::vector<unsigned long> &cutstatistics = statistics.getNumberCuts();
         if (cutstatistics.size() > 0) {
             out << "Cuts:";
@@ -82,6 +283,9 @@ namespace vorpal::nibac {
             std::vector<unsigned long>::iterator vendIter = cutstatistics.end();
             for (; vbeginIter != vendIter; ++vbeginIter)
                 out << " " << *vbeginIter;
+            out << std::endl;
+            out << "\tNumber of cuts added from the cut pool: " << statistics.getNumberCutPoolCuts() << std::endl;
+            out << "\tNumber of duplicate cuts dropped: " << statistics.getNumberDuplicateCuts();
         }
 
         return out;
@@ -7,6 +7,7 @@
 #ifndef STATISTICS_H
 #define STATISTICS_H
 
+#include <istream>
 #include <ostream>
 #include <vector>
 #include <map>
@@ -53,6 +54,13 @@ namespace vorpal::nibac {
         // Number of LP problems solved
         unsigned long numberLPsSolved;
 
+        // Number of LP problems abandoned by the LP solver after unreasonably many iterations
+        unsigned long numberLPsAbandoned;
+
+        // Number of cuts added from the cut pool, and number of duplicate cuts dropped
+        unsigned long numberCutPoolCuts;
+        unsigned long numberDuplicateCuts;
+
         // Total time in the separation algorithm
         Timer separationTimer;
 
@@ -70,10 +78,35 @@ namespace vorpal::nibac {
         // Total time spent solving the problem
         Timer totalTimer;
 
+        // Number of subtrees set aside by node selection, and the number resumed
+        unsigned long numberSubtreesSetAside;
+        unsigned long numberSubtreesResumed;
+
+        // Number of work units written by splitting the search
+        unsigned long numberWorkUnits;
+
+        // The weighted backtrack estimate of the size of the tree. Every node that is branched
+        // upon has two children, so a leaf at depth d is reached with probability 2^-d by a
+        // random dive from the root, which would estimate the tree to have 2^(d+1) - 1 nodes.
+        // We keep the sum of these probabilities over the leaves seen so far, which is the
+        // fraction of the tree that has been explored, and the sum of the estimates weighted
+        // by them.
+        double leafWeight;
+        double weightedTreeSize;
+
+        // Number of nodes explored and time spent when the best solution value
+        // was last improved upon
+        bool bestSolutionFlag;
+        unsigned long bestSolutionNodes;
+        double bestSolutionSeconds;
+
         // Nodes per depth and fixings per depth
         std::map<int, int> nodesByDepth;
         std::map<int, int> fixingsByDepth;
 
+        // Time spent solving LPs per depth
+        std::map<int, double> lpTimeByDepth;
+
 #ifdef MARGOTIMERS
         public:
           // TODO: Are we even using these? I don't think so.
@@ -150,6 +183,21 @@ namespace vorpal::nibac {
 
         inline void reportLPSolved(void) { ++numberLPsSolved; }
 
+        // Number of LPs abandoned by the LP solver after unreasonably many iterations, e.g.
+        // because they cycled
+        inline unsigned long getNumberLPsAbandoned() const { return numberLPsAbandoned; }
+
+        inline void reportLPAbandoned(void) { ++numberLPsAbandoned; }
+
+        // Number of cuts added from the cut pool, and number of duplicate cuts dropped
+        inline unsigned long getNumberCutPoolCuts() const { return numberCutPoolCuts; }
+
+        inline void reportCutPoolCuts(int number) { numberCutPoolCuts += number; }
+
+        inline unsigned long getNumberDuplicateCuts() const { return numberDuplicateCuts; }
+
+        inline void reportDuplicateCuts(int number) { numberDuplicateCuts += number; }
+
         // Separation algorithm timer
         inline Timer &getSeparationTimer() { return separationTimer; }
 
@@ -171,6 +219,47 @@ namespace vorpal::nibac {
         // Total B&C timer
         inline Timer &getTotalTimer() { return totalTimer; }
 
+        // Subtrees set aside and resumed by node selection
+        inline unsigned long getNumberSubtreesSetAside() const { return numberSubtreesSetAside; }
+
+        inline void reportSubtreeSetAside() { ++numberSubtreesSetAside; }
+
+        inline unsigned long getNumberSubtreesResumed() const { return numberSubtreesResumed; }
+
+        inline void reportSubtreeResumed() { ++numberSubtreesResumed; }
+
+        // Leaves of the tree, i.e. nodes that were pruned or could not be branched upon, and
+        // the estimate of the size of the tree that they give, or 0 if there have been none.
+        void reportLeaf(Node &);
+
+        inline double getEstimatedTreeSize() const { return leafWeight > 0 ? weightedTreeSize / leafWeight : 0; }
+
+        // Print a line with the number of nodes explored, the estimate of the size of the tree,
+        // the fraction of the tree explored and the time that the rest should take at the same rate.
+        void printProgress(std::ostream &) const;
+
+        // Work units written by splitting the search
+        inline unsigned long getNumberWorkUnits() const { return numberWorkUnits; }
+
+        inline void reportWorkUnit() { ++numberWorkUnits; }
+
+        // The point at which the best solution value was found, i.e. the time to the optimum.
+        // A parallel search records it in the statistics of the original options, with the
+        // number of nodes explored by all of its workers by then.
+        inline bool hasBestSolution() const { return bestSolutionFlag; }
+
+        inline unsigned long getBestSolutionNodes() const { return bestSolutionNodes; }
+
+        inline double getBestSolutionSeconds() const { return bestSolutionSeconds; }
+
+        inline void reportBestSolution() { reportBestSolution(numberNodesExplored); }
+
+        inline void reportBestSolution(unsigned long nodes) {
+            bestSolutionFlag = true;
+            bestSolutionNodes = nodes;
+            bestSolutionSeconds = totalTimer.getSeconds();
+        }
+
         // Number of nodes at a certain depth.
         inline std::map<int, int> &getNodeCountByDepth() { return nodesByDepth; }
 
@@ -178,6 +267,21 @@ namespace vorpal::nibac {
         // include branching fixings.
         inline std::map<int, int> &getVariableFixingCountByDepth() { return fixingsByDepth; }
 
+        // Time spent solving LPs at each depth, as measured by the LP solver timer.
+        inline std::map<int, double> &getLPTimeByDepth() { return lpTimeByDepth; }
+
+        // Add the statistics gathered by a worker of a parallel search, or read from a
+        // checkpoint of another search, into these.
+        void merge(const Statistics &);
+
+        // Write the statistics gathered by the search to a checkpoint, and read them back,
+        // to be merged into those of the search that resumes from it. The timers for the formulation and the symmetry group are
+        // not included, as they measure work that is done again. read returns false if the
+        // stream did not contain statistics.
+        void write(std::ostream &) const;
+
+        bool read(std::istream &);
+
         // Make the printer a friend of this class.
         friend std::ostream &operator<<(std::ostream &, const Statistics &);
     };
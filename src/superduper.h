@@ -26,7 +26,7 @@ namespace vorpal::nibac::design {
          * This method will be invoked automatically and does not require the user to invoke it.
          * @param n The size of the required matrix. Must be less than 100.
          */
-        static inline void init_super_duper(int n);
+        static void init_super_duper(int n);
 
     public:
 
@@ -36,7 +36,7 @@ namespace vorpal::nibac::design {
          * @param k The size of the subsets.
          * @return The number of k-subsets of an n-set.
          */
-        static inline int C(int n, int k);
+        static int C(int n, int k);
 
         /**
          * Given the size of a base set (the v-set), and a k-subset, this function returns the rank
@@ -46,7 +46,7 @@ namespace vorpal::nibac::design {
          * @param set The k-subset.
          * @return The rank of the k-subset amongst all k-subsets of the v-set.
          */
-        static inline int super(int v, int k, int *set);
+        static int super(int v, int k, int *set);
 
         /**
          * Given the size of a base set (the v-set), the size of a k-subset, and a lexicographical
@@ -56,7 +56,7 @@ namespace vorpal::nibac::design {
          * @param num The lexicographical number of the subset.
          * @param set The array (of size at least k) into which we perform the unranking.
          */
-        static inline void duper(int v, int k, int num, int *set);
+        static void duper(int v, int k, int num, int *set);
     };
 };
 #endif
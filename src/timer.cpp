@@ -5,11 +5,24 @@
  */
 
 #include <limits.h>
+#include <unistd.h>
 #include <sys/times.h>
 #include "common.h"
 #include "timer.h"
 
+// CLK_TCK is obsolete, and no longer defined by current C libraries.
+#ifndef CLK_TCK
+#define CLK_TCK sysconf(_SC_CLK_TCK)
+#endif
+
 namespace vorpal::nibac {
+    Timer::Timer()
+            : cstart(ULONG_MAX),
+              cstop(0),
+              seconds(0) {
+    }
+
+
     void Timer::start() {
         times(&tp);
         cstart = tp.tms_utime;
@@ -36,6 +49,11 @@ namespace vorpal::nibac {
     }
 
 
+    void Timer::addSeconds(double nseconds) {
+        seconds += nseconds;
+    }
+
+
     double Timer::getSeconds() const {
         // If the timer is running, we adjust to return the number
         // of seconds it has been running for so that we can
@@ -43,7 +61,7 @@ namespace vorpal::nibac {
         if (cstart != ULONG_MAX) {
             struct tms tp2;
             times(&tp2);
-            return ((double) (tp2.tms_utime - cstart)) / CLK_TCK;
+            return seconds + ((double) (tp2.tms_utime - cstart)) / CLK_TCK;
         }
         return seconds;
     }
@@ -24,7 +24,7 @@ namespace vorpal::nibac {
         double seconds;
 
     public:
-        Timer() = default;
+        Timer();
         virtual ~Timer() = default;
 
         /**
@@ -48,6 +48,12 @@ namespace vorpal::nibac {
          */
         void setSeconds(double);
 
+        /**
+         * The addSeconds method adds to the number of seconds elapsed, e.g. to account
+         * for time recorded elsewhere, whether or not the Timer is running.
+         */
+        void addSeconds(double);
+
         /**
          * This method returns the number of seconds for which the Timer has been active
          * (i.e. the number of seconds elapsed cumulatively between calls to start and stop).
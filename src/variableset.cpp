@@ -0,0 +1,56 @@
+/**
+ * variableset.cpp
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+
+#include <string.h>
+#include "common.h"
+#include "variableorder.h"
+#include "variableset.h"
+
+namespace vorpal::nibac {
+    VariableSet::VariableSet(int pnumberVariables, VariableOrder &variableOrder)
+            : numberVariables(pnumberVariables),
+              numberWords((pnumberVariables + WORDBITS - 1) / WORDBITS),
+              words(new unsigned long[(pnumberVariables + WORDBITS - 1) / WORDBITS]),
+              count(pnumberVariables),
+              lowestWord(0),
+              variableToIndex(new int[pnumberVariables]),
+              indexToVariable(new int[pnumberVariables]) {
+        for (int i = 0; i < numberVariables; ++i) {
+            variableToIndex[i] = variableOrder.variableToIndex(i);
+            indexToVariable[i] = variableOrder.indexToVariable(i);
+        }
+
+        // Every variable is in the set, and the last word is padded with 0s.
+        memset(words, 0, numberWords * sizeof(unsigned long));
+        for (int i = 0; i < numberVariables / WORDBITS; ++i)
+            words[i] = ~0UL;
+        if (numberVariables % WORDBITS)
+            words[numberVariables / WORDBITS] = (1UL << (numberVariables % WORDBITS)) - 1;
+    }
+
+
+    VariableSet::~VariableSet() {
+        delete[] words;
+        delete[] variableToIndex;
+        delete[] indexToVariable;
+    }
+
+
+    int VariableSet::nextIndex(int index) const {
+        if (index >= numberVariables)
+            return numberVariables;
+
+        // Mask out the bits before the index in its word, and then scan the words.
+        int word = index / WORDBITS;
+        unsigned long bits = words[word] & (~0UL << (index % WORDBITS));
+        while (bits == 0) {
+            if (++word >= numberWords)
+                return numberVariables;
+            bits = words[word];
+        }
+        return word * WORDBITS + __builtin_ctzl(bits);
+    }
+};
@@ -0,0 +1,117 @@
+/**
+ * variableset.h
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+// A set of branching variables, stored as a word-packed bitset. The bits are
+// indexed by the position of the variables in a VariableOrder, so that the
+// variable lowest in the order can be found using count-trailing-zeros, and
+// so that iterating over the set, which scans the words, visits the
+// variables in that order. This is used by Node to maintain its free
+// variables, which are queried and modified at every node of the tree.
+
+#ifndef VARIABLESET_H
+#define VARIABLESET_H
+
+#include <cassert>
+#include <climits>
+#include "common.h"
+#include "variableorder.h"
+
+namespace vorpal::nibac {
+    class VariableSet final {
+    private:
+        enum { WORDBITS = sizeof(unsigned long) * CHAR_BIT };
+
+        int numberVariables;
+        int numberWords;
+        unsigned long *words;
+
+        // The number of variables in the set.
+        int count;
+
+        // All words before this one are known to be empty.
+        mutable int lowestWord;
+
+        // The correspondence between variables and their positions in the order.
+        int *variableToIndex;
+        int *indexToVariable;
+
+        // The position of the lowest set bit at or after the given one, or numberVariables if there is none.
+        int nextIndex(int) const;
+
+    public:
+        // Create the set of all the given number of variables, ordered by the VariableOrder.
+        VariableSet(int, VariableOrder &);
+
+        VariableSet(const VariableSet &) = delete;
+
+        VariableSet &operator=(const VariableSet &) = delete;
+
+        ~VariableSet();
+
+        // Visits the variables of the set in order.
+        class iterator {
+            friend class VariableSet;
+
+        private:
+            const VariableSet *set;
+            int index;
+
+            iterator(const VariableSet *pset, int pindex) : set(pset), index(pindex) {}
+
+        public:
+            inline int operator*() const { return set->indexToVariable[index]; }
+
+            inline iterator &operator++() {
+                index = set->nextIndex(index + 1);
+                return *this;
+            }
+
+            inline bool operator==(const iterator &other) const { return index == other.index; }
+
+            inline bool operator!=(const iterator &other) const { return index != other.index; }
+        };
+
+        inline iterator begin() const { return iterator(this, nextIndex(0)); }
+
+        inline iterator end() const { return iterator(this, numberVariables); }
+
+        inline int size() const { return count; }
+
+        inline bool empty() const { return count == 0; }
+
+        inline bool contains(int variable) const {
+            if (variable < 0 || variable >= numberVariables)
+                return false;
+            int index = variableToIndex[variable];
+            return (words[index / WORDBITS] >> (index % WORDBITS)) & 1UL;
+        }
+
+        inline void insert(int variable) {
+            assert(!contains(variable));
+            int index = variableToIndex[variable];
+            words[index / WORDBITS] |= 1UL << (index % WORDBITS);
+            if (index / WORDBITS < lowestWord)
+                lowestWord = index / WORDBITS;
+            ++count;
+        }
+
+        inline void erase(int variable) {
+            assert(contains(variable));
+            int index = variableToIndex[variable];
+            words[index / WORDBITS] &= ~(1UL << (index % WORDBITS));
+            --count;
+        }
+
+        // The variable of the set that is lowest in the order, or -1 if the set is empty.
+        inline int getLowest() const {
+            if (count == 0)
+                return -1;
+            while (words[lowestWord] == 0)
+                ++lowestWord;
+            return indexToVariable[lowestWord * WORDBITS + __builtin_ctzl(words[lowestWord])];
+        }
+    };
+};
+#endif
@@ -0,0 +1,124 @@
+/**
+ * distributedsearchtest.cpp
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+// Solve a small problem serially, and then with a distributed search over a Unix
+// socket with a coordinator and two workers in processes of their own, and check
+// that both find the same solutions.
+//
+// The problem is that of packing the triples of an 8-set so that no pair is in two
+// of them, and we generate all of the packings of maximum size.
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "nibac.h"
+#include "triplepacking.h"
+
+using namespace vorpal::nibac;
+
+namespace {
+    const int V = 8;
+    const int NUMBER_WORKERS = 2;
+
+    // Solve the problem with the given addresses for a distributed search, returning
+    // the solutions found in a canonical order.
+    std::vector<std::vector<int> > solve(const char *listenAddress, const char *coordinatorAddress) {
+        BACOptions options;
+        CommandLineProcessing commandLineProcessing(options);
+        LowestIndexBranchingSchemeCreator branchingSchemeCreator;
+        commandLineProcessing.registerCreator(branchingSchemeCreator, 0, true);
+        LexicographicVariableOrderCreator variableOrderCreator;
+        commandLineProcessing.registerCreator(variableOrderCreator, 0, true);
+        DefaultSolutionManagerCreator solutionManagerCreator;
+        solutionManagerCreator.setProblemType(Formulation::MAXIMIZATION);
+        solutionManagerCreator.setSolutionType(Formulation::GENERATION);
+        commandLineProcessing.registerCreator(solutionManagerCreator, 0, true);
+
+        int argc = 1;
+        char name[] = "distributedsearchtest";
+        char *argvArray[] = {name, 0};
+        char **argv = argvArray;
+        commandLineProcessing.populateBACOptions(argc, argv);
+        commandLineProcessing.finishBACOptionsConfiguration();
+        options.setListenAddress(listenAddress);
+        options.setCoordinatorAddress(coordinatorAddress);
+
+        TriplePacking problem(options, V, Formulation::GENERATION);
+        problem.solve();
+
+        std::vector<std::vector<int> > solutions;
+        std::vector<std::vector<int> *> &found = ((DefaultSolutionManager *) options.getSolutionManager())->getSolutions();
+        for (std::vector<std::vector<int> *>::iterator iter = found.begin(); iter != found.end(); ++iter)
+            solutions.push_back(**iter);
+        std::sort(solutions.begin(), solutions.end());
+        return solutions;
+    }
+
+
+    // Work for the coordinator at the address, waiting for it to listen.
+    int work(const char *address) {
+        for (int attempt = 0; attempt < 500; ++attempt) {
+            try {
+                solve(0, address);
+                return 0;
+            } catch (NetworkException &e) {
+                usleep(10000);
+            } catch (std::exception &e) {
+                std::cerr << "worker: " << e.what() << std::endl;
+                return 1;
+            }
+        }
+        std::cerr << "worker: could not connect to " << address << std::endl;
+        return 1;
+    }
+}
+
+
+int main(void) {
+    std::vector<std::vector<int> > serialSolutions = solve(0, 0);
+
+    std::ostringstream addressStream;
+    addressStream << "/tmp/nibac-distributedsearchtest." << getpid();
+    std::string address = addressStream.str();
+
+    std::vector<pid_t> workers;
+    for (int i = 0; i < NUMBER_WORKERS; ++i) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            std::cerr << "could not start a worker" << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (pid == 0)
+            _exit(work(address.c_str()));
+        workers.push_back(pid);
+    }
+
+    std::vector<std::vector<int> > distributedSolutions;
+    bool successFlag = true;
+    try {
+        distributedSolutions = solve(address.c_str(), 0);
+    } catch (std::exception &e) {
+        std::cerr << "coordinator: " << e.what() << std::endl;
+        successFlag = false;
+    }
+
+    for (std::vector<pid_t>::iterator iter = workers.begin(); iter != workers.end(); ++iter) {
+        int status;
+        if (waitpid(*iter, &status, 0) != *iter || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            successFlag = false;
+    }
+
+    std::cout << "serial search: " << serialSolutions.size() << " solutions" << std::endl;
+    std::cout << "distributed search: " << distributedSolutions.size() << " solutions" << std::endl;
+    if (serialSolutions.empty() || distributedSolutions != serialSolutions)
+        successFlag = false;
+    std::cout << (successFlag ? "PASSED" : "FAILED") << std::endl;
+    return successFlag ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,375 @@
+/**
+ * lpsolvertest.cpp
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+// Solve single LPs with the LP solver linked in, through the nodes of a BAC as the
+// search does, and check the results: infeasible LPs and LPs cut off by the bounds
+// on the objective function give no bound, an LP stopped by the iteration limit still
+// gives one, variables fixed by rows are reported with an infinite reduced cost, and
+// the LPs solved warm after fixings, cuts and backtracks, with and without LP reduction,
+// agree with the same LPs solved from scratch in full.
+//
+// Some of the checks are particular to SimplexSolver, and are only made when it is
+// the solver linked in.
+
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+#include "nibac.h"
+#include "lpsolver.h"
+
+using namespace vorpal::nibac;
+
+namespace {
+    const double TOLERANCE = 1e-6;
+
+    int failures = 0;
+
+    void check(bool condition, const char *description) {
+        if (!condition) {
+            std::cerr << "FAILED: " << description << std::endl;
+            ++failures;
+        }
+    }
+
+
+    // A BAC that gives access to its nodes, so that their LPs can be solved one at a time.
+    class LPBAC final : public BAC {
+    public:
+        LPBAC(Formulation &pformulation, BACOptions &poptions)
+                : BAC(pformulation, poptions) {
+            initialize();
+        }
+
+        Node *getRoot() { return nodeStack->getNextNode(); }
+
+        Node *descend(int variable, int value) { return nodeStack->descend(variable, value); }
+
+        void backtrack() { nodeStack->pruneTop(); }
+
+        // Solve the LP of a node, returning its status as given by LPSolver::solveNode.
+        int solve(Node &node) {
+            int status = formulation.getLPSolver()->solveNode(*this, node);
+            node.reportLPSolved();
+            return status;
+        }
+    };
+
+
+    // Options with no symmetry and the simplest branching, and a fresh set of statistics.
+    class LPOptions {
+    public:
+        BACOptions options;
+        LexicographicVariableOrder variableOrder;
+        LowestIndexBranchingScheme branchingScheme;
+
+        LPOptions() {
+            options.setVariableOrder(&variableOrder);
+            options.setBranchingScheme(&branchingScheme);
+        }
+    };
+
+
+    void addRow(Formulation &formulation, std::vector<int> positions, Sense sense, int bound) {
+        formulation.addConstraint(Constraint::createConstraint(formulation, positions, sense, bound));
+    }
+
+
+    // The odd cycle x0 + x1 <= 1, x1 + x2 <= 1, x0 + x2 <= 1 maximizing x0 + x1 + x2, whose
+    // LP optimum is 3/2 with every variable at 1/2, and which takes more than one iteration
+    // from the basis of the slacks.
+    void setupTriangle(Formulation &formulation) {
+        std::vector<int> objective(3, 1);
+        formulation.setObjectiveFunction(objective);
+        addRow(formulation, std::vector<int>{0, 1}, LT, 1);
+        addRow(formulation, std::vector<int>{1, 2}, LT, 1);
+        addRow(formulation, std::vector<int>{0, 2}, LT, 1);
+    }
+
+
+    void testTriangle() {
+        LPOptions lpOptions;
+        Formulation formulation(Formulation::MAXIMIZATION, Formulation::SEARCH, 3);
+        setupTriangle(formulation);
+        LPBAC bac(formulation, lpOptions.options);
+        Node *root = bac.getRoot();
+
+        check(bac.solve(*root) == 0, "the odd cycle has an optimal LP");
+        check(fabs(root->getSolutionValue() - 1.5) <= TOLERANCE, "the LP optimum of the odd cycle is 3/2");
+        check(root->hasReducedCosts(), "an optimal LP gives reduced costs");
+        for (int i = 0; i < 3; ++i)
+            check(fabs(root->getSolutionVariableArray()[i] - 0.5) <= TOLERANCE, "the odd cycle LP is all 1/2");
+
+        // Asking for a sum of at least 2 makes the LP infeasible.
+        std::vector<int> positions{0, 1, 2};
+        Constraint *cut = Constraint::createConstraint(formulation, positions, GT, 2);
+        formulation.addCut(cut);
+        check(bac.solve(*root) == -1, "an infeasible LP gives no bound");
+        formulation.removeCut(cut);
+        delete cut;
+        check(bac.solve(*root) == 0, "removing the cut makes the LP feasible again");
+        check(fabs(root->getSolutionValue() - 1.5) <= TOLERANCE, "removing the cut restores the LP optimum");
+    }
+
+
+    void testCutoff() {
+        LPOptions lpOptions;
+        Formulation formulation(Formulation::MAXIMIZATION, Formulation::SEARCH, 3);
+        setupTriangle(formulation);
+        LPBAC bac(formulation, lpOptions.options);
+        Node *root = bac.getRoot();
+
+        // A solution of value 2 cannot be beaten here, as the LP bound is 3/2.
+        formulation.setObjectiveCutoff(2);
+        check(bac.solve(*root) == -1, "an LP that cannot meet the cutoff gives no bound");
+
+        // Neither can a solution of value 2 be met when it is the lower bound asked for.
+        LPOptions boundOptions;
+        Formulation boundFormulation(Formulation::MAXIMIZATION, Formulation::SEARCH, 3);
+        std::vector<int> objective(3, 1);
+        boundFormulation.setObjectiveFunction(objective, 2, INT_MAX);
+        addRow(boundFormulation, std::vector<int>{0, 1}, LT, 1);
+        addRow(boundFormulation, std::vector<int>{1, 2}, LT, 1);
+        addRow(boundFormulation, std::vector<int>{0, 2}, LT, 1);
+        LPBAC boundBAC(boundFormulation, boundOptions.options);
+        check(boundBAC.solve(*(boundBAC.getRoot())) == -1, "an LP that cannot meet the objective bound gives no bound");
+    }
+
+
+    void testIterationLimit() {
+        LPOptions lpOptions;
+        lpOptions.options.setLPIterationLimit(1);
+        Formulation formulation(Formulation::MAXIMIZATION, Formulation::SEARCH, 3);
+        setupTriangle(formulation);
+        LPBAC bac(formulation, lpOptions.options);
+        Node *root = bac.getRoot();
+
+        // The node must still be explored, with a bound no better than the LP optimum.
+        check(bac.solve(*root) == 0, "an LP stopped by the iteration limit is not pruned");
+        check(root->getSolutionValue() >= 1.5 - TOLERANCE, "an LP stopped by the iteration limit gives a valid bound");
+#ifndef NIBAC_GLPK
+        for (int i = 0; i < 3; ++i)
+            check(root->getSolutionVariableArray()[i] == 0.5, "an LP stopped by the iteration limit is branched upon");
+#endif
+    }
+
+
+#ifndef NIBAC_GLPK
+    void testForcedColumns() {
+        // Maximize x0 + x1 + x2 + x3 subject to x0 + x1 = 2 and x2 <= 0, which can only be
+        // met with x0 = x1 = 1 and x2 = 0.
+        LPOptions lpOptions;
+        lpOptions.options.reduceLP(true);
+        Formulation formulation(Formulation::MAXIMIZATION, Formulation::SEARCH, 4);
+        std::vector<int> objective(4, 1);
+        formulation.setObjectiveFunction(objective);
+        addRow(formulation, std::vector<int>{0, 1}, EQ, 2);
+        addRow(formulation, std::vector<int>{2}, LT, 0);
+        LPBAC bac(formulation, lpOptions.options);
+        Node *root = bac.getRoot();
+
+        check(bac.solve(*root) == 0, "the LP with forced columns is optimal");
+        check(fabs(root->getSolutionValue() - 3) <= TOLERANCE, "the LP with forced columns has optimum 3");
+        double *reducedCosts = root->getReducedCostArray();
+        check(reducedCosts[0] == DBL_MAX && reducedCosts[1] == DBL_MAX, "columns forced to 1 are reported as fixed");
+        check(reducedCosts[2] == -DBL_MAX, "columns forced to 0 are reported as fixed");
+        check(fabs(reducedCosts[3]) < DBL_MAX, "free columns have a finite reduced cost");
+    }
+#endif
+
+
+    // A random set packing problem, with rows of coefficients 1 and 2.
+    void setupPacking(Formulation &formulation, std::mt19937 &generator) {
+        int numberVariables = formulation.getNumberVariables();
+        std::vector<int> objective(numberVariables);
+        for (int i = 0; i < numberVariables; ++i)
+            objective[i] = 1 + generator() % 9;
+        formulation.setObjectiveFunction(objective);
+
+        for (int row = 0; row < 3 * numberVariables / 4; ++row) {
+            std::vector<int> positions;
+            std::vector<int> coefficients;
+            while (positions.size() < 2) {
+                positions.clear();
+                coefficients.clear();
+                for (int i = 0; i < numberVariables; ++i)
+                    if (generator() % 5 == 0) {
+                        positions.push_back(i);
+                        coefficients.push_back(1 + generator() % 2);
+                    }
+            }
+            formulation.addConstraint(Constraint::createConstraint(formulation, positions, coefficients,
+                                                                   LT, 1 + generator() % 3));
+        }
+    }
+
+
+    // Solve the current LP of a formulation from scratch, in a copy of it, and in full.
+    int solveCold(Formulation &formulation, double &value) {
+        LPOptions lpOptions;
+        Formulation cold(formulation);
+        const std::map<int, int> &fixings = formulation.getFixings();
+        for (std::map<int, int>::const_iterator iter = fixings.begin(); iter != fixings.end(); ++iter)
+            cold.fixVariable((*iter).first, (*iter).second);
+        std::vector<Constraint *> cuts;
+        const std::map<unsigned long, Constraint *> &warmCuts = formulation.getCuts();
+        for (std::map<unsigned long, Constraint *>::const_iterator iter = warmCuts.begin();
+             iter != warmCuts.end();
+             ++iter) {
+            Constraint *cut = (*iter).second;
+            cuts.push_back(Constraint::createConstraint(cold, cut->getPositions(), cut->getCoefficients(),
+                                                        cut->getLowerBound(), cut->getUpperBound()));
+        }
+        cold.addCuts(cuts);
+
+        int status;
+        {
+            LPBAC bac(cold, lpOptions.options);
+            Node *root = bac.getRoot();
+            status = bac.solve(*root);
+            value = root->getSolutionValue();
+        }
+
+        cold.removeCuts(cuts);
+        for (std::vector<Constraint *>::iterator iter = cuts.begin(); iter != cuts.end(); ++iter)
+            delete *iter;
+        return status;
+    }
+
+
+    // Check that the solution of an LP meets its rows, cuts and fixings.
+    bool isFeasible(Formulation &formulation, Node &node) {
+        double *solution = node.getSolutionVariableArray();
+        for (int i = 0; i < formulation.getNumberVariables(); ++i)
+            if (solution[i] < -TOLERANCE || solution[i] > 1 + TOLERANCE)
+                return false;
+        const std::map<int, int> &fixings = formulation.getFixings();
+        for (std::map<int, int>::const_iterator iter = fixings.begin(); iter != fixings.end(); ++iter)
+            if (fabs(solution[(*iter).first] - (*iter).second) > TOLERANCE)
+                return false;
+
+        const std::map<unsigned long, Constraint *> *rows[] = {&formulation.getConstraints(), &formulation.getCuts()};
+        for (int k = 0; k < 2; ++k)
+            for (std::map<unsigned long, Constraint *>::const_iterator iter = rows[k]->begin();
+                 iter != rows[k]->end();
+                 ++iter) {
+                double activity = (*iter).second->evaluateConstraint(solution);
+                if (activity < (*iter).second->getLowerBound() - TOLERANCE
+                    || activity > (*iter).second->getUpperBound() + TOLERANCE)
+                    return false;
+            }
+        return true;
+    }
+
+
+    // Solve LPs warm, with or without LP reduction, and compare them to the same LPs solved cold.
+    void testWarmResolves(bool reduceFlag) {
+        const int NUMBER_VARIABLES = 24;
+        const int NUMBER_STEPS = 400;
+        const int MAXIMUM_DEPTH = 8;
+
+        std::mt19937 generator(2018);
+        LPOptions lpOptions;
+        lpOptions.options.reduceLP(reduceFlag);
+        Formulation formulation(Formulation::MAXIMIZATION, Formulation::SEARCH, NUMBER_VARIABLES);
+        setupPacking(formulation, generator);
+        LPBAC bac(formulation, lpOptions.options);
+        Node *node = bac.getRoot();
+
+        // The cuts added at each node along the path from the root.
+        std::vector<std::vector<Constraint *> > cuts(1);
+        int numberCompared = 0;
+        int numberFeasible = 0;
+        int status = bac.solve(*node);
+
+        for (int step = 0; step < NUMBER_STEPS; ++step) {
+            int operation = generator() % 10;
+            const std::map<int, int> &fixings = formulation.getFixings();
+            if (node->getDepth() > 0 && (operation < 2 || status == -1 || node->getDepth() >= MAXIMUM_DEPTH)) {
+                // Backtrack, as the search would from an infeasible LP, and branch on another
+                // variable from the parent.
+                std::vector<Constraint *> &nodeCuts = cuts.back();
+                formulation.removeCuts(nodeCuts);
+                for (std::vector<Constraint *>::iterator iter = nodeCuts.begin(); iter != nodeCuts.end(); ++iter)
+                    delete *iter;
+                cuts.pop_back();
+                bac.backtrack();
+                operation = 9;
+            }
+
+            if (operation < 5 && !cuts.back().empty()) {
+                // Remove a cut of the node.
+                std::vector<Constraint *> &nodeCuts = cuts.back();
+                int index = generator() % nodeCuts.size();
+                Constraint *cut = nodeCuts[index];
+                nodeCuts.erase(nodeCuts.begin() + index);
+                formulation.removeCut(cut);
+                delete cut;
+            } else if (operation < 8 || (int) fixings.size() == NUMBER_VARIABLES) {
+                // Add a cut over a few variables.
+                std::vector<int> positions;
+                while (positions.size() < 3) {
+                    positions.clear();
+                    for (int i = 0; i < NUMBER_VARIABLES; ++i)
+                        if (generator() % 4 == 0)
+                            positions.push_back(i);
+                }
+                Constraint *cut = Constraint::createConstraint(formulation, positions, LT,
+                                                               (int) positions.size() / 2);
+                formulation.addCut(cut);
+                cuts.back().push_back(cut);
+            } else {
+                // Fix a free variable by branching on it.
+                int variable;
+                do
+                    variable = generator() % NUMBER_VARIABLES;
+                while (fixings.find(variable) != fixings.end());
+                node = bac.descend(variable, generator() % 3 == 0);
+                cuts.push_back(std::vector<Constraint *>());
+            }
+
+            status = bac.solve(*node);
+            double coldValue;
+            int coldStatus = solveCold(formulation, coldValue);
+            check(status == coldStatus, "a warm LP has the status of the same LP solved cold");
+            if (status == 0 && coldStatus == 0) {
+                check(fabs(node->getSolutionValue() - coldValue) <= TOLERANCE,
+                      "a warm LP has the optimum of the same LP solved cold");
+                check(isFeasible(formulation, *node), "the solution of a warm LP is feasible");
+                ++numberFeasible;
+            }
+            ++numberCompared;
+        }
+
+        // Clean up the cuts that are left.
+        while (!cuts.empty()) {
+            formulation.removeCuts(cuts.back());
+            for (std::vector<Constraint *>::iterator iter = cuts.back().begin(); iter != cuts.back().end(); ++iter)
+                delete *iter;
+            cuts.pop_back();
+        }
+
+        std::cout << "warm re-solves" << (reduceFlag ? " with LP reduction: " : ": ") << numberCompared << " compared, " << numberFeasible << " feasible" << std::endl;
+        check(numberFeasible > 0 && numberFeasible < numberCompared, "the warm re-solves meet feasible and infeasible LPs");
+    }
+}
+
+
+int main(void) {
+    testTriangle();
+    testCutoff();
+    testIterationLimit();
+#ifndef NIBAC_GLPK
+    testForcedColumns();
+#endif
+    testWarmResolves(false);
+    testWarmResolves(true);
+
+    std::cout << (failures == 0 ? "PASSED" : "FAILED") << std::endl;
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,58 @@
+/**
+ * nodethroughput.cpp
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+// Measure the number of nodes and LPs per second of wall clock time that the LP solver
+// linked in gives the branch-and-cut, by generating the maximum packings of the triples
+// of a v-set. Build with and without NIBAC_GLPK to compare the LP solvers.
+//
+// Usage: nodethroughput [v] [NIBAC options]
+// v defaults to 9, and the NIBAC options are those of CommandLineProcessing.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include "nibac.h"
+#include "triplepacking.h"
+
+using namespace vorpal::nibac;
+
+int main(int argc, char **argv) {
+    int v = 9;
+    if (argc > 1 && argv[1][0] != '-') {
+        v = atoi(argv[1]);
+        --argc;
+        ++argv;
+    }
+
+    BACOptions options;
+    CommandLineProcessing commandLineProcessing(options);
+    LowestIndexBranchingSchemeCreator branchingSchemeCreator;
+    commandLineProcessing.registerCreator(branchingSchemeCreator, 0, true);
+    LexicographicVariableOrderCreator variableOrderCreator;
+    commandLineProcessing.registerCreator(variableOrderCreator, 0, true);
+    DefaultSolutionManagerCreator solutionManagerCreator;
+    solutionManagerCreator.setProblemType(Formulation::MAXIMIZATION);
+    solutionManagerCreator.setSolutionType(Formulation::GENERATION);
+    commandLineProcessing.registerCreator(solutionManagerCreator, 0, true);
+    if (commandLineProcessing.populateBACOptions(argc, argv) == CommandLineProcessing::HELP) {
+        commandLineProcessing.outputOptions(std::cerr);
+        return EXIT_FAILURE;
+    }
+    commandLineProcessing.finishBACOptionsConfiguration();
+
+    TriplePacking problem(options, v, Formulation::GENERATION);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    problem.solve();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Statistics &statistics = options.getStatistics();
+    std::cout << "v = " << v << ": "
+              << ((DefaultSolutionManager *) options.getSolutionManager())->getSolutions().size() << " solutions, "
+              << statistics.getNumberNodesExplored() << " nodes, "
+              << statistics.getNumberLPsSolved() << " LPs in " << seconds << " s" << std::endl;
+    std::cout << statistics.getNumberNodesExplored() / seconds << " nodes/s, "
+              << statistics.getNumberLPsSolved() / seconds << " LPs/s" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,51 @@
+/**
+ * triplepacking.h
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+// The problem of packing the triples of a v-set so that no pair is in two of them, as
+// a maximization problem over the triples, which the tests and benchmarks solve.
+
+#ifndef TRIPLEPACKING_H
+#define TRIPLEPACKING_H
+
+#include <algorithm>
+#include <vector>
+#include "nibac.h"
+
+namespace vorpal::nibac {
+    class TriplePacking final : public Problem {
+    private:
+        int v;
+        std::vector<std::vector<int> > triples;
+
+    public:
+        TriplePacking(BACOptions &poptions, int pv, Formulation::SolutionType psolutionType)
+                : Problem(poptions, Formulation::MAXIMIZATION, psolutionType, pv * (pv - 1) * (pv - 2) / 6),
+                  v(pv) {
+            for (int x = 0; x < v; ++x)
+                for (int y = x + 1; y < v; ++y)
+                    for (int z = y + 1; z < v; ++z)
+                        triples.push_back(std::vector<int>{x, y, z});
+        }
+
+    protected:
+        void constructFormulation(void) override {
+            std::vector<int> objective(numberVariables, 1);
+            formulation.setObjectiveFunction(objective, options.getLowerBound(), options.getUpperBound());
+
+            // Each pair is in at most one triple.
+            for (int x = 0; x < v; ++x)
+                for (int y = x + 1; y < v; ++y) {
+                    std::vector<int> positions;
+                    for (int i = 0; i < numberVariables; ++i)
+                        if (std::count(triples[i].begin(), triples[i].end(), x)
+                            && std::count(triples[i].begin(), triples[i].end(), y))
+                            positions.push_back(i);
+                    formulation.addConstraint(Constraint::createConstraint(formulation, positions, LT, 1));
+                }
+        }
+    };
+};
+
+#endif
@@ -0,0 +1,163 @@
+/**
+ * variablesetbenchmark.cpp
+ *
+ * By Sebastian Raaphorst, 2003 - 2018.
+ */
+// Measure the time spent maintaining the free variables of the nodes of a depth-first
+// search, with VariableSet, and with the std::set and std::maps that each node copied
+// from its parent before VariableSet. The same walk is made over both: at each node,
+// the free variables are iterated over, the lowest in the order is branched upon, and
+// each child fixes it and up to two other free variables.
+//
+// Usage: variablesetbenchmark [number of variables] [number of nodes]
+// These default to 84, the number of triples of a 9-set, and 1000000.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+#include "lexicographicvariableorder.h"
+#include "variableset.h"
+
+using namespace vorpal::nibac;
+
+namespace {
+    const int MAXIMUM_DEPTH = 40;
+
+    // The free variables as a node kept them before VariableSet.
+    struct FreeList {
+        std::set<int> freeVariables;
+        std::map<int, int> freeVariableToIndex;
+        std::map<int, int> indexToFreeVariable;
+
+        FreeList(int numberVariables, VariableOrder &variableOrder) {
+            for (int i = 0; i < numberVariables; ++i) {
+                freeVariables.insert(i);
+                freeVariableToIndex[i] = variableOrder.variableToIndex(i);
+                indexToFreeVariable[variableOrder.variableToIndex(i)] = i;
+            }
+        }
+
+        inline bool contains(int variable) const { return freeVariables.find(variable) != freeVariables.end(); }
+
+        inline void fix(int variable) {
+            freeVariables.erase(variable);
+            std::map<int, int>::iterator iter = freeVariableToIndex.find(variable);
+            indexToFreeVariable.erase((*iter).second);
+            freeVariableToIndex.erase(iter);
+        }
+
+        inline int getLowest() const {
+            return freeVariables.empty() ? -1 : (*(indexToFreeVariable.begin())).second;
+        }
+    };
+
+
+    struct Walk {
+        int numberVariables;
+        long maximumNodes;
+        long numberNodes;
+        long checksum;
+        std::mt19937 generator;
+
+        Walk(int pnumberVariables, long pmaximumNodes)
+                : numberVariables(pnumberVariables), maximumNodes(pmaximumNodes),
+                  numberNodes(0), checksum(0), generator(2018) {}
+    };
+
+
+    // Each child copies the free list of its parent.
+    void exploreFreeList(Walk &walk, const FreeList &parent, int depth) {
+        ++walk.numberNodes;
+        for (std::set<int>::const_iterator iter = parent.freeVariables.begin();
+             iter != parent.freeVariables.end();
+             ++iter)
+            walk.checksum += *iter;
+
+        int variable = parent.getLowest();
+        if (variable == -1 || depth >= MAXIMUM_DEPTH)
+            return;
+        walk.checksum += variable;
+
+        for (int value = 1; value >= 0 && walk.numberNodes < walk.maximumNodes; --value) {
+            FreeList child(parent);
+            child.fix(variable);
+            for (int extra = walk.generator() % 3; extra > 0; --extra) {
+                int other = walk.generator() % walk.numberVariables;
+                if (child.contains(other))
+                    child.fix(other);
+            }
+            exploreFreeList(walk, child, depth + 1);
+        }
+    }
+
+
+    // The children share the set, and the fixings are undone when we backtrack.
+    void exploreVariableSet(Walk &walk, VariableSet &freeVariables, std::vector<int> &trail, int depth) {
+        ++walk.numberNodes;
+        for (VariableSet::iterator iter = freeVariables.begin(); iter != freeVariables.end(); ++iter)
+            walk.checksum += *iter;
+
+        int variable = freeVariables.getLowest();
+        if (variable == -1 || depth >= MAXIMUM_DEPTH)
+            return;
+        walk.checksum += variable;
+
+        for (int value = 1; value >= 0 && walk.numberNodes < walk.maximumNodes; --value) {
+            std::vector<int>::size_type trailMark = trail.size();
+            freeVariables.erase(variable);
+            trail.push_back(variable);
+            for (int extra = walk.generator() % 3; extra > 0; --extra) {
+                int other = walk.generator() % walk.numberVariables;
+                if (freeVariables.contains(other)) {
+                    freeVariables.erase(other);
+                    trail.push_back(other);
+                }
+            }
+            exploreVariableSet(walk, freeVariables, trail, depth + 1);
+            while (trail.size() > trailMark) {
+                freeVariables.insert(trail.back());
+                trail.pop_back();
+            }
+        }
+    }
+}
+
+
+int main(int argc, char **argv) {
+    int numberVariables = (argc > 1 ? atoi(argv[1]) : 84);
+    long numberNodes = (argc > 2 ? atol(argv[2]) : 1000000);
+    LexicographicVariableOrder variableOrder;
+
+    Walk freeListWalk(numberVariables, numberNodes);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    {
+        FreeList root(numberVariables, variableOrder);
+        exploreFreeList(freeListWalk, root, 0);
+    }
+    double freeListSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Walk variableSetWalk(numberVariables, numberNodes);
+    start = std::chrono::steady_clock::now();
+    {
+        VariableSet root(numberVariables, variableOrder);
+        std::vector<int> trail;
+        trail.reserve(numberVariables);
+        exploreVariableSet(variableSetWalk, root, trail, 0);
+    }
+    double variableSetSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (freeListWalk.numberNodes != variableSetWalk.numberNodes || freeListWalk.checksum != variableSetWalk.checksum) {
+        std::cerr << "the walks differ" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << numberVariables << " variables, " << variableSetWalk.numberNodes << " nodes" << std::endl;
+    std::cout << "std::set and std::map copied per node: " << freeListSeconds << " s" << std::endl;
+    std::cout << "VariableSet with a trail: " << variableSetSeconds << " s" << std::endl;
+    std::cout << "speedup: " << freeListSeconds / variableSetSeconds << "x" << std::endl;
+    return EXIT_SUCCESS;
+}